@@ -21,32 +21,50 @@
 
 #include "ili9341.h"
 
+/*
+ * The frame is rendered in bands of DISPLAY_BAND_LINES lines into two band buffers.
+ * A band is sent (window + pixel data) while LVGL renders the next one into the other
+ * buffer, flush only waits when the previous band is still on the bus.
+ */
+#define DISPLAY_BAND_LINES  40
+
 static int g_width = 0;
 static int g_height = 0;
+static int g_band_lines = 0;
 static uint8_t *g_buffer_0 = NULL;
 static uint8_t *g_buffer_1 = NULL;
+
 static rtos_sema_t g_vsync_sem;
-static int g_id = 0;
-volatile int wait_for_vsync = 0;
+static volatile int g_busy = 0;
 
 void display_vsync_handle(void *data)
 {
     UNUSED(data);
-    if (wait_for_vsync == 1) {
+    if (g_busy == 1) {
+        g_busy = 0;
         rtos_sema_give(g_vsync_sem);
     }
 }
 
+static void display_wait_done(void)
+{
+    while (g_busy) {
+        rtos_sema_take(g_vsync_sem, RTOS_MAX_TIMEOUT);
+    }
+}
+
 void display_init(void)
 {
     ili9341_init();
 
     ili9341_get_info(&g_width, &g_height);
+    g_band_lines = DISPLAY_BAND_LINES < g_height ? DISPLAY_BAND_LINES : g_height;
 
-    g_buffer_0 = (uint8_t *)malloc(g_width * g_height * LV_COLOR_DEPTH / 8);
-    g_buffer_1 = (uint8_t *)malloc(g_width * g_height * LV_COLOR_DEPTH / 8);
+    g_buffer_0 = (uint8_t *)malloc(g_width * g_band_lines * LV_COLOR_DEPTH / 8);
+    g_buffer_1 = (uint8_t *)malloc(g_width * g_band_lines * LV_COLOR_DEPTH / 8);
 
     rtos_sema_create(&g_vsync_sem, 0, RTOS_SEMA_MAX_COUNT);
+
     ILI9341VBlankCallback *callback = (ILI9341VBlankCallback *)malloc(sizeof(ILI9341VBlankCallback));
     callback->VBlank = display_vsync_handle;
     ili9341_register_callback(callback, NULL);
@@ -58,6 +76,11 @@ void display_get_info(int *width, int *height)
     *height = g_height;
 }
 
+int display_get_buffer_lines(void)
+{
+    return g_band_lines;
+}
+
 uint8_t *display_get_buffer(int buffer_id)
 {
     if (buffer_id == 1) {
@@ -72,22 +95,13 @@ uint8_t *display_get_buffer(int buffer_id)
 void display_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p)
 {
     //printf("display_flush %d %d %d %d\n", area->x1, area->y1, area->x2, area->y2);
-    UNUSED(area);
-    UNUSED(color_p);
 
-    if (g_id == 1) {
-        ili9341_clean_invalidate_buffer(g_buffer_1);
-        wait_for_vsync = 1;
-        rtos_sema_take(g_vsync_sem, RTOS_MAX_TIMEOUT);
-        wait_for_vsync = 0;
-        g_id = 0;
-    } else {
-        ili9341_clean_invalidate_buffer(g_buffer_0);
-        wait_for_vsync = 1;
-        rtos_sema_take(g_vsync_sem, RTOS_MAX_TIMEOUT);
-        wait_for_vsync = 0;
-        g_id = 1;
-    }
+    // The previous band may still be read from the other buffer
+    display_wait_done();
+
+    g_busy = 1;
+    ili9341_flush_area((uint8_t *)color_p, area->x1, area->y1, area->x2, area->y2);
 
+    // LVGL renders the next band meanwhile, the last one is waited for by the next flush
     lv_disp_flush_ready(disp_drv);
 }
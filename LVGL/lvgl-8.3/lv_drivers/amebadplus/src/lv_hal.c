@@ -36,7 +36,7 @@ void lv_hal_init(void)
 
     // /*Initialize a descriptor for the buffer*/
     static lv_disp_draw_buf_t disp_buf;
-    lv_disp_draw_buf_init(&disp_buf, buffer_1, buffer_2, width * height);
+    lv_disp_draw_buf_init(&disp_buf, buffer_1, buffer_2, width * display_get_buffer_lines());
 
     // /*Initialize and register a display driver*/
     static lv_disp_drv_t disp_drv;
@@ -45,7 +45,7 @@ void lv_hal_init(void)
     disp_drv.flush_cb   = display_flush;
     disp_drv.hor_res    = width;
     disp_drv.ver_res    = height;
-    disp_drv.full_refresh = 1;
+    disp_drv.full_refresh = 0;    // buffers hold a band, the frame is sent band by band
     lv_disp_drv_register(&disp_drv);
 
 }
@@ -65,6 +65,11 @@ void display_get_info(int *width, int *height)
     *height = g_height;
 }
 
+int display_get_buffer_lines(void)
+{
+    return g_height;
+}
+
 uint8_t *display_get_buffer(int buffer_id)
 {
     if (buffer_id == 1) {
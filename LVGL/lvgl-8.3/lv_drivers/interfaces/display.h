@@ -6,6 +6,8 @@
 void display_init(void);
 void display_get_info(int *width, int *height);
 uint8_t *display_get_buffer(int buffer_id);
+/* Lines held by each display buffer, less than the height when rendering in bands */
+int display_get_buffer_lines(void);
 void display_render_start(void);
 void display_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p);
 
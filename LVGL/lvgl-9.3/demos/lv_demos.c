@@ -37,12 +37,9 @@ void lv_demos_task(void *param) {
          * It could be done in a timer interrupt or an OS task too.*/
         uint32_t time_till_next = lv_task_handler();
 
-        /* handle LV_NO_TIMER_READY. Another option is to `sleep` for longer */
-        if(time_till_next == LV_NO_TIMER_READY)
-            time_till_next = LV_DEF_REFR_PERIOD;
-
-        /* delay to avoid unnecessary polling */
-        rtos_time_delay_ms(time_till_next);
+        /* delay to avoid unnecessary polling, LV_NO_TIMER_READY sleeps until woken
+         * when the display is idle */
+        lv_ameba_hal_wait(time_till_next);
     }
 
     lv_deinit();
@@ -17,11 +17,16 @@
 #include <stdio.h>
 
 #include "lvgl.h"
-#include "display.h"
+#include "panel_display.h"
+#include "ili9341.h"
 
 #include "lv_ameba_hal.h"
 #include "os_wrapper.h"
 
+#define RTK_DISPLAY_BUS_BENCH 0 // frames per bus setup, 0 to skip the bus benchmark
+#define RTK_DISPLAY_TE_SYNC 0 // sync transfers to the panel TE output
+#define RTK_DISPLAY_TE_PIN _PA_23 // board specific, GPIO wired to TE
+
 uint32_t custom_tick_get(void)
 {
     return rtos_time_get_current_system_time_ms();
@@ -31,17 +36,25 @@ void lv_ameba_hal_init(void)
 {
     lv_tick_set_cb(custom_tick_get);
 
-    display_init();
-
-    int width;
-    int height;
-    display_get_info(&width, &height);
+    lv_display_t *display = panel_display_create(&ili9341_panel_ops, 2);
+    LV_ASSERT_NULL(display);
 
-    uint8_t *buffer_1 = display_get_buffer(0);
-    uint8_t *buffer_2 = display_get_buffer(1);
+#if RTK_DISPLAY_BUS_BENCH
+    static panel_display_bus_result_t results[12];
+    panel_display_bus_benchmark(RTK_DISPLAY_BUS_BENCH, results, 12);
+#endif
 
-    lv_display_t *display = lv_display_create(width, height); /*Create the display*/
-    lv_display_set_flush_cb(display, display_flush);        /*Set a flush callback to draw to the display*/
-    lv_display_set_buffers(display, buffer_1, buffer_2, width * height * 2, LV_DISPLAY_RENDER_MODE_FULL); /*Set an initialized buffer*/
+#if RTK_DISPLAY_TE_SYNC
+    ili9341_te_enable(RTK_DISPLAY_TE_PIN);
+#endif
     //lv_display_set_rotation(display, LV_DISPLAY_ROTATION_270);
 }
+
+void lv_ameba_hal_wait(uint32_t ms)
+{
+    rtos_time_delay_ms(ms == LV_NO_TIMER_READY ? LV_DEF_REFR_PERIOD : ms);
+}
+
+void lv_ameba_hal_wake(void)
+{
+}
@@ -16,36 +16,128 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "os_wrapper.h"
+
 #include "lcdc.h"
 #include "display.h"
+#include "lv_draw_ppe.h"
 
 #define LOG_TAG "Display"
 
 #define CHECK_FLIP_BUFFER 0
 
+#define DISPLAY_MAX_BUFFERS 3
+#define FPS_WINDOW_MS       1000
+#define DIRTY_AREA_MAX      16      // more areas in a frame sync the whole screen
+#define PPE_COPY_MIN_PX     1024    // smaller areas are copied by the CPU
+#define VSYNC_MARGIN_US     1000    // frame should be submitted this long before frame done
+#define BACKOFF_HOLD_MS     500     // throttling stays on this long after the last underflow
+
+typedef struct {
+    lv_area_t areas[DIRTY_AREA_MAX];
+    uint8_t count;
+    bool full;
+} dirty_list_t;
+
+/*
+ * Double buffering: the flush waits until the new buffer is on screen, as LVGL
+ * renders into the old one right after.
+ * Triple buffering: the flush only waits until the previous flip is on screen,
+ * which frees the buffer LVGL renders next, and returns while the new flip is
+ * still pending.
+ * A flip is on screen once the frame done after it has latched the new address,
+ * so flip_pending is cleared by the first flip line interrupt after that.
+ */
 typedef struct {
     uint32_t width;
     uint32_t height;
-    uint8_t *buffers[3];
+    uint8_t *buffers[DISPLAY_MAX_BUFFERS];
+    uint8_t buffer_count;
+    uint8_t px_size;
     lv_display_t *lv_disp;
     int active_buffer_id;
     int rendering_buffer_id;
     lv_thread_sync_t flip_sync;
-    volatile bool flip_done;
+    volatile bool flip_pending;
+    volatile bool flip_latched;
     lcdc_event_t lcdc_callback;
     bool initialized;
+
+    // direct sync mode, areas of the last buffer_count - 1 frames
+    lv_draw_buf_t draw_bufs[DISPLAY_MAX_BUFFERS];
+    dirty_list_t dirty[DISPLAY_MAX_BUFFERS - 1];
+    uint8_t dirty_head;
+    bool ppe_copy;
+
+    bool frame_submitted;       // in the current LVGL refresh
+
+    // vsync scheduler, sets the LVGL refresh period so rendering ends just before frame done
+    bool vsync_sched;
+    uint64_t refr_start_ns;
+    uint32_t render_est_us;
+    uint64_t deadline_ns;       // frame done the frame being rendered is aimed at, 0 for none
+
+    // underflow backoff
+    uint32_t underflow_policy;
+    display_underflow_cb_t underflow_cb;
+    void *underflow_user_data;
+    volatile bool raise_burst;  // set in irq, applied from the render thread
+    rtos_sema_t frame_sema;     // frame done, for throttled jobs
+    lv_mutex_t gate_lock;       // render cycle and gate state, PPE/JPEG jobs run on several threads
+    uint32_t render_cycle;      // LVGL refreshes started
+    bool rendering;
+    uint32_t gate_cycle;        // refresh the gate opened for last
+    uint32_t gate_frame;        // frame the gate opened in last
+    uint32_t throttled_frames;
+
+    // idle mode, refresh and input polling paused after idle_frames refreshes without drawing
+    uint32_t idle_frames;
+    uint32_t idle_count;
+    bool idle_pause_input;
+    bool idle;
+    volatile bool wake_pending;
+    rtos_sema_t wake_sema;
+    uint32_t idle_start;
+    uint32_t idle_time_ms;
+    uint32_t idle_entries;
+    uint32_t stats_start;
+
+    // statistics
+    volatile uint32_t flips;
+    uint32_t frames;
+    uint32_t fps;
+    uint32_t fps_frames;
+    uint32_t fps_start;
+    uint64_t stall_time_us;
+    uint32_t stall_max_us;
+    uint64_t sync_px;
+    uint32_t missed_vsyncs;
+    uint64_t last_flip_ns;
+    uint32_t frame_interval_us;
+    uint32_t frame_interval_max_us;
 } display_context_t;
 
 static display_context_t display_ctx = {0};
 
 static void display_vblank_handler(void *user_data);
+static void display_frame_done_handler(void *user_data);
+static void display_underflow_handler(void *user_data);
 
 bool display_init(uint16_t bpp, uint32_t width, uint32_t height) {
+    return display_init_with_buffers(bpp, width, height, 2);
+}
+
+bool display_init_with_buffers(uint16_t bpp, uint32_t width, uint32_t height, uint8_t buffer_count) {
     if (display_ctx.initialized) {
         RTK_LOGW(LOG_TAG, "Already initialized\n");
         return true;
     }
 
+    if (buffer_count < 2 || buffer_count > DISPLAY_MAX_BUFFERS) {
+        RTK_LOGE(LOG_TAG, "Unsupported buffer count: %d\n", buffer_count);
+        return false;
+    }
+
     // map lvgl format to lcdc format
     lcd_format_t format;
     switch (bpp) {
@@ -61,23 +153,23 @@ bool display_init(uint16_t bpp, uint32_t width, uint32_t height) {
     display_ctx.width = width;
     display_ctx.height = height;
 
-    // allocate double framebuffer
+    // allocate framebuffers
     size_t buffer_size = display_ctx.width * display_ctx.height * bpp / 8;
-    display_ctx.buffers[0] = malloc(buffer_size);
-    display_ctx.buffers[1] = malloc(buffer_size);
-    if (!display_ctx.buffers[0] || !display_ctx.buffers[1]) {
-        RTK_LOGE(LOG_TAG, "Alloc display buffer fail\n");
-        goto err_finish;
+    for (int i = 0; i < buffer_count; i++) {
+        display_ctx.buffers[i] = malloc(buffer_size);
+        if (!display_ctx.buffers[i]) {
+            RTK_LOGE(LOG_TAG, "Alloc display buffer %d fail\n", i);
+            goto err_finish;
+        }
+        memset(display_ctx.buffers[i], 0, buffer_size);
+        RTK_LOGI(LOG_TAG, "buf%d: 0x%x\n", i + 1, (int)display_ctx.buffers[i]);
     }
-
-    memset(display_ctx.buffers[0], 0, buffer_size);
-    memset(display_ctx.buffers[1], 0, buffer_size);
-
-    RTK_LOGI(LOG_TAG, "buf1: 0x%x, buf2: 0x%x\n",
-             (int)display_ctx.buffers[0], (int)display_ctx.buffers[1]);
+    display_ctx.buffer_count = buffer_count;
+    display_ctx.px_size = bpp / 8;
 
     // vsync semphore
     lv_thread_sync_init(&display_ctx.flip_sync);
+    lv_mutex_init(&display_ctx.gate_lock);
 
     // init lcdc with default resolution
     if (!lcdc_init_default(format, width, height)) {
@@ -87,12 +179,16 @@ bool display_init(uint16_t bpp, uint32_t width, uint32_t height) {
 
     // set vsync callback
     display_ctx.lcdc_callback.vblank_handler = display_vblank_handler;
+    display_ctx.lcdc_callback.frame_done_handler = display_frame_done_handler;
+    display_ctx.lcdc_callback.underflow_handler = display_underflow_handler;
     lcdc_register_event_callback(&display_ctx.lcdc_callback, &display_ctx);
 
     // drawing buffer is 0
     display_ctx.active_buffer_id = 1;
     display_ctx.rendering_buffer_id = 0;
-    display_ctx.flip_done = true;
+    display_ctx.flip_pending = false;
+    display_ctx.fps_start = rtos_time_get_current_system_time_ms();
+    display_ctx.stats_start = display_ctx.fps_start;
     display_ctx.initialized = true;
 
     RTK_LOGI(LOG_TAG, "Display manager initialized: %dx%d, buffer size: %zu\n", 
@@ -101,13 +197,13 @@ bool display_init(uint16_t bpp, uint32_t width, uint32_t height) {
     return true;
 
 err_finish:
-    if (display_ctx.buffers[0])
-        free(display_ctx.buffers[0]);
-
-    if (display_ctx.buffers[1])
-        free(display_ctx.buffers[1]);
+    for (int i = 0; i < DISPLAY_MAX_BUFFERS; i++) {
+        if (display_ctx.buffers[i])
+            free(display_ctx.buffers[i]);
+    }
 
     lv_thread_sync_delete(&display_ctx.flip_sync);
+    lv_mutex_delete(&display_ctx.gate_lock);
 
     memset(&display_ctx, 0, sizeof(display_context_t));
 
@@ -124,17 +220,181 @@ void display_get_info(uint32_t *width, uint32_t *height) {
 }
 
 uint8_t *display_get_buffer(int buffer_id) {
-    if (buffer_id >= 0 && buffer_id < 2) {
+    if (buffer_id >= 0 && buffer_id < display_ctx.buffer_count) {
         return display_ctx.buffers[buffer_id];
     }
     return NULL;
 }
 
+uint8_t display_get_buffer_count(void) {
+    return display_ctx.buffer_count;
+}
+
+void display_get_stats(display_stats_t *stats) {
+    stats->frames = display_ctx.frames;
+    stats->flips = display_ctx.flips;
+    stats->fps = display_ctx.fps;
+    stats->stall_time_ms = (uint32_t)(display_ctx.stall_time_us / 1000);
+    stats->stall_max_us = display_ctx.stall_max_us;
+    stats->sync_kpx = (uint32_t)(display_ctx.sync_px / 1000);
+    stats->missed_vsyncs = display_ctx.missed_vsyncs;
+    stats->frame_interval_us = display_ctx.frame_interval_us;
+    stats->frame_interval_max_us = display_ctx.frame_interval_max_us;
+    stats->render_time_us = display_ctx.render_est_us;
+
+    lcdc_vsync_info_t vsync;
+    lcdc_get_vsync_info(&vsync);
+    stats->vsync_period_us = vsync.frame_period_ns / 1000;
+
+    lcdc_underflow_info_t underflow;
+    lcdc_get_underflow_info(&underflow);
+    stats->underflows = underflow.count;
+    stats->underflow_last_ms = (uint32_t)(underflow.last_ns / 1000000);
+    stats->dma_burst_size = underflow.burst_size;
+    stats->throttled_frames = display_ctx.throttled_frames;
+
+    uint32_t now = rtos_time_get_current_system_time_ms();
+    uint32_t idle_time = display_ctx.idle_time_ms;
+    if (display_ctx.idle) {
+        idle_time += now - display_ctx.idle_start;
+    }
+    stats->idle_time_ms = idle_time;
+    stats->idle_entries = display_ctx.idle_entries;
+    stats->idle_residency = now != display_ctx.stats_start ?
+                            (uint8_t)((uint64_t)idle_time * 100 / (now - display_ctx.stats_start)) : 0;
+    stats->buffer_count = display_ctx.buffer_count;
+}
+
+void display_reset_stats(void) {
+    display_ctx.frames = 0;
+    display_ctx.flips = 0;
+    display_ctx.fps_frames = 0;
+    display_ctx.fps_start = rtos_time_get_current_system_time_ms();
+    display_ctx.stall_time_us = 0;
+    display_ctx.stall_max_us = 0;
+    display_ctx.sync_px = 0;
+    display_ctx.missed_vsyncs = 0;
+    display_ctx.frame_interval_max_us = 0;
+    lv_mutex_lock(&display_ctx.gate_lock);
+    display_ctx.throttled_frames = 0;
+    lv_mutex_unlock(&display_ctx.gate_lock);
+    display_ctx.idle_time_ms = 0;
+    display_ctx.idle_entries = 0;
+    display_ctx.stats_start = display_ctx.fps_start;
+    if (display_ctx.idle) {
+        display_ctx.idle_start = display_ctx.fps_start;
+    }
+}
+
+static void display_frame_done_handler(void *user_data) {
+    display_context_t *disp = (display_context_t *)user_data;
+    if (disp->flip_pending) {
+        disp->flip_latched = true;
+    }
+    if (disp->frame_sema) {
+        rtos_sema_give(disp->frame_sema);
+    }
+}
+
 static void display_vblank_handler(void *user_data) {
     display_context_t *disp = (display_context_t *)user_data;
-    if (!disp->flip_done) {
+    if (disp->flip_pending && disp->flip_latched) {
+        uint64_t now = rtos_time_get_current_system_time_ns();
+        if (disp->last_flip_ns) {
+            disp->frame_interval_us = (uint32_t)((now - disp->last_flip_ns) / 1000);
+            if (disp->frame_interval_us > disp->frame_interval_max_us) {
+                disp->frame_interval_max_us = disp->frame_interval_us;
+            }
+        }
+        disp->last_flip_ns = now;
+
+        disp->flip_pending = false;
+        disp->flips++;
         lv_thread_sync_signal(&display_ctx.flip_sync);
-        disp->flip_done = true;
+    }
+}
+
+/* Block the render thread until no flip is pending, stale signals only cost a loop */
+static void display_wait_flip(void) {
+    if (!display_ctx.flip_pending) {
+        return;
+    }
+
+    uint64_t start = rtos_time_get_current_system_time_ns();
+    while (display_ctx.flip_pending) {
+        lv_thread_sync_wait(&display_ctx.flip_sync);
+    }
+
+    uint32_t stall_us = (uint32_t)((rtos_time_get_current_system_time_ns() - start) / 1000);
+    display_ctx.stall_time_us += stall_us;
+    if (stall_us > display_ctx.stall_max_us) {
+        display_ctx.stall_max_us = stall_us;
+    }
+}
+
+/* Write the address before flagging, a frame done in between then only delays completion by a frame */
+static void display_flip(uint8_t *buffer) {
+    lcdc_page_flip(buffer);
+    display_ctx.flip_latched = false;
+    display_ctx.flip_pending = true;
+}
+
+static void display_underflow_handler(void *user_data) {
+    display_context_t *disp = (display_context_t *)user_data;
+
+    if (disp->underflow_policy & DISPLAY_UNDERFLOW_RAISE_BURST) {
+        disp->raise_burst = true;
+    }
+
+    if (disp->underflow_cb) {
+        lcdc_underflow_info_t info;
+        lcdc_get_underflow_info(&info);
+        disp->underflow_cb(info.count, disp->underflow_user_data);
+    }
+}
+
+static void display_submit_frame(uint8_t *buffer) {
+    if (display_ctx.raise_burst) {
+        lcdc_underflow_info_t info;
+        lcdc_get_underflow_info(&info);
+        if (info.burst_size < LCDC_DMA_BURST_MAX) {
+            lcdc_set_dma_burst_size(info.burst_size + 1);
+        }
+        display_ctx.raise_burst = false;
+    }
+
+    if (display_ctx.vsync_sched) {
+        uint64_t now = rtos_time_get_current_system_time_ns();
+        if (display_ctx.deadline_ns && now > display_ctx.deadline_ns) {
+            display_ctx.missed_vsyncs++;
+        }
+
+        // Rise at once, decay slowly: an underestimate misses the vsync
+        uint32_t render_us = (uint32_t)((now - display_ctx.refr_start_ns) / 1000);
+        if (render_us > display_ctx.render_est_us) {
+            display_ctx.render_est_us = render_us;
+        } else {
+            display_ctx.render_est_us = (display_ctx.render_est_us * 7 + render_us) / 8;
+        }
+    }
+    display_ctx.frame_submitted = true;
+
+    if (display_ctx.buffer_count > 2) {
+        // Previous flip must be latched before the register is written again
+        display_wait_flip();
+        display_flip(buffer);
+    } else {
+        display_flip(buffer);
+        display_wait_flip();
+    }
+
+    display_ctx.frames++;
+    display_ctx.fps_frames++;
+    uint32_t now = rtos_time_get_current_system_time_ms();
+    if (now - display_ctx.fps_start >= FPS_WINDOW_MS) {
+        display_ctx.fps = display_ctx.fps_frames * 1000 / (now - display_ctx.fps_start);
+        display_ctx.fps_frames = 0;
+        display_ctx.fps_start = now;
     }
 }
 
@@ -148,12 +408,7 @@ void display_flush_direct(lv_display_t *display, const lv_area_t *area, void *px
 
     if (last_flush) {
         // send new rendering buffer to lcdc
-        lcdc_page_flip(px_map);
-
-        // wait flip done
-        display_ctx.flip_done = false;
-        lv_thread_sync_wait(&display_ctx.flip_sync);
-        display_ctx.flip_done = true;
+        display_submit_frame(px_map);
     }
 
     lv_display_flush_ready(display);
@@ -176,12 +431,7 @@ void display_flush_full(lv_display_t *display, const lv_area_t *area, void *px_m
              px_map, area->x1, area->y1, area->x2, area->y2);
 
     // send new rendering buffer to lcdc
-    lcdc_page_flip(px_map);
-
-    // wait flip done
-    display_ctx.flip_done = false;
-    lv_thread_sync_wait(&display_ctx.flip_sync);
-    display_ctx.flip_done = true;
+    display_submit_frame(px_map);
 
 #if CHECK_FLIP_BUFFER
     // swap framebuffer index
@@ -192,3 +442,400 @@ void display_flush_full(lv_display_t *display, const lv_area_t *area, void *px_m
 
     lv_display_flush_ready(display);
 }
+
+static void dirty_list_add(dirty_list_t *list, const lv_area_t *area) {
+    if (list->full) {
+        return;
+    }
+
+    for (int i = 0; i < list->count; i++) {
+        if (lv_area_is_in(area, &list->areas[i], 0)) {
+            return;
+        }
+    }
+
+    if (list->count == DIRTY_AREA_MAX) {
+        list->full = true;
+        return;
+    }
+    list->areas[list->count++] = *area;
+}
+
+static void display_copy_area(const uint8_t *src, uint8_t *dest, const lv_area_t *area) {
+    uint32_t stride = display_ctx.width * display_ctx.px_size;
+    uint32_t offset = area->y1 * stride + area->x1 * display_ctx.px_size;
+    uint32_t w = lv_area_get_width(area);
+    uint32_t h = lv_area_get_height(area);
+
+    display_ctx.sync_px += w * h;
+
+#if LV_USE_DRAW_PPE
+    if (display_ctx.ppe_copy && w * h >= PPE_COPY_MIN_PX) {
+        lv_draw_ppe_header_t src_header = {0};
+        lv_draw_ppe_header_t dest_header = {0};
+        lv_draw_ppe_configuration_t ppe_conf = {0};
+        lv_color_format_t cf = lv_display_get_color_format(display_ctx.lv_disp);
+
+        src_header.cf = cf;
+        src_header.w = w;
+        src_header.h = h;
+        src_header.stride = stride;
+        src_header.color = 0xFFFFFFFF;
+        dest_header = src_header;
+        ppe_conf.src_buf = (void *)(src + offset);
+        ppe_conf.dest_buf = dest + offset;
+        ppe_conf.src_header = &src_header;
+        ppe_conf.dest_header = &dest_header;
+        ppe_conf.scale_x = 1.0f;
+        ppe_conf.scale_y = 1.0f;
+        ppe_conf.angle = 0;
+        ppe_conf.opa = LV_OPA_COVER;
+        lv_draw_ppe_configure_and_start_transfer(&ppe_conf);
+        return;
+    }
+#endif
+
+    for (uint32_t y = 0; y < h; y++) {
+        memcpy(dest + offset, src + offset, w * display_ctx.px_size);
+        offset += stride;
+    }
+}
+
+/* Bring dest up to date with src: copy what the frames since dest was rendered changed */
+static void display_sync_buffer(const uint8_t *src, uint8_t *dest) {
+    int lists = display_ctx.buffer_count - 1;
+    lv_area_t full = {0, 0, display_ctx.width - 1, display_ctx.height - 1};
+
+    for (int i = 0; i < lists; i++) {
+        if (display_ctx.dirty[i].full) {
+            display_copy_area(src, dest, &full);
+            return;
+        }
+    }
+
+    for (int i = 0; i < lists; i++) {
+        dirty_list_t *list = &display_ctx.dirty[i];
+        for (int j = 0; j < list->count; j++) {
+            // Already covered by an area of another frame
+            bool covered = false;
+            for (int k = 0; k < i && !covered; k++) {
+                for (int m = 0; m < display_ctx.dirty[k].count && !covered; m++) {
+                    covered = lv_area_is_in(&list->areas[j], &display_ctx.dirty[k].areas[m], 0);
+                }
+            }
+            if (!covered) {
+                display_copy_area(src, dest, &list->areas[j]);
+            }
+        }
+    }
+}
+
+void display_setup_direct_sync(lv_display_t *display, bool use_ppe) {
+    lv_color_format_t cf = lv_display_get_color_format(display);
+    uint32_t stride = lv_draw_buf_width_to_stride(display_ctx.width, cf);
+
+    for (int i = 0; i < display_ctx.buffer_count; i++) {
+        lv_draw_buf_init(&display_ctx.draw_bufs[i], display_ctx.width, display_ctx.height, cf, stride,
+                         display_ctx.buffers[i], stride * display_ctx.height);
+    }
+
+    // Buffers start out different, the first frame syncs everything
+    memset(display_ctx.dirty, 0, sizeof(display_ctx.dirty));
+    for (int i = 0; i < display_ctx.buffer_count - 1; i++) {
+        display_ctx.dirty[i].full = true;
+    }
+    display_ctx.dirty_head = 0;
+    display_ctx.rendering_buffer_id = 0;
+    display_ctx.ppe_copy = use_ppe;
+    display_ctx.lv_disp = display;
+
+    // LVGL sees a single buffer, so it does no CPU sync of its own
+    lv_display_set_draw_buffers(display, &display_ctx.draw_bufs[0], NULL);
+    lv_display_set_render_mode(display, LV_DISPLAY_RENDER_MODE_DIRECT);
+    lv_display_set_flush_cb(display, display_flush_direct_sync);
+}
+
+void display_flush_direct_sync(lv_display_t *display, const lv_area_t *area, void *px_map) {
+    dirty_list_add(&display_ctx.dirty[display_ctx.dirty_head], area);
+
+    if (!lv_display_flush_is_last(display)) {
+        lv_display_flush_ready(display);
+        return;
+    }
+
+    // On return the next buffer is neither scanned out nor pending
+    display_submit_frame(px_map);
+
+    int next = (display_ctx.rendering_buffer_id + 1) % display_ctx.buffer_count;
+    display_sync_buffer(px_map, display_ctx.buffers[next]);
+
+    // Oldest frame's areas are in every buffer now, reuse its list for the next frame
+    display_ctx.dirty_head = (display_ctx.dirty_head + 1) % (display_ctx.buffer_count - 1);
+    memset(&display_ctx.dirty[display_ctx.dirty_head], 0, sizeof(dirty_list_t));
+
+    display_ctx.active_buffer_id = display_ctx.rendering_buffer_id;
+    display_ctx.rendering_buffer_id = next;
+    lv_display_set_draw_buffers(display, &display_ctx.draw_bufs[next], NULL);
+
+    lv_display_flush_ready(display);
+}
+
+bool display_set_flip_line(uint32_t line) {
+    return lcdc_set_flip_line(line);
+}
+
+/* Next frame done far enough ahead to render a frame for it */
+static void display_schedule_next(lv_timer_t *refr_timer) {
+    lcdc_vsync_info_t vsync;
+    lcdc_get_vsync_info(&vsync);
+    if (!vsync.frame_period_ns) {
+        display_ctx.deadline_ns = 0;
+        return;
+    }
+
+    uint64_t now = rtos_time_get_current_system_time_ns();
+    uint64_t lead_ns = (uint64_t)(display_ctx.render_est_us + VSYNC_MARGIN_US) * 1000;
+    uint64_t deadline = vsync.frame_done_ns + vsync.frame_period_ns;
+    while (deadline < now + lead_ns) {
+        deadline += vsync.frame_period_ns;
+    }
+    display_ctx.deadline_ns = deadline - VSYNC_MARGIN_US * 1000;
+
+    // The refresh timer period counts from the start of this refresh
+    uint64_t start_ns = deadline - lead_ns;
+    uint32_t period = (uint32_t)((start_ns - display_ctx.refr_start_ns) / 1000000);
+    lv_timer_set_period(refr_timer, period ? period : 1);
+}
+
+static void display_refr_event_cb(lv_event_t *e) {
+    lv_display_t *display = lv_event_get_target(e);
+    lv_timer_t *refr_timer = lv_display_get_refr_timer(display);
+
+    if (!display_ctx.vsync_sched || !refr_timer) {
+        return;
+    }
+
+    if (lv_event_get_code(e) == LV_EVENT_REFR_START) {
+        display_ctx.refr_start_ns = rtos_time_get_current_system_time_ns();
+        display_ctx.frame_submitted = false;
+        return;
+    }
+
+    // Nothing was drawn, poll at the default rate until the next change
+    if (!display_ctx.frame_submitted) {
+        display_ctx.deadline_ns = 0;
+        lv_timer_set_period(refr_timer, LV_DEF_REFR_PERIOD);
+        return;
+    }
+
+    display_schedule_next(refr_timer);
+}
+
+void display_enable_vsync_scheduler(bool enable) {
+    lv_display_t *display = display_ctx.lv_disp;
+    if (!display) {
+        RTK_LOGE(LOG_TAG, "No LVGL display set\n");
+        return;
+    }
+
+    if (enable == display_ctx.vsync_sched) {
+        return;
+    }
+
+    if (enable) {
+        display_ctx.render_est_us = 0;
+        display_ctx.deadline_ns = 0;
+        display_ctx.frame_submitted = false;
+        lv_display_add_event_cb(display, display_refr_event_cb, LV_EVENT_REFR_START, NULL);
+        lv_display_add_event_cb(display, display_refr_event_cb, LV_EVENT_REFR_READY, NULL);
+    } else {
+        lv_display_remove_event_cb_with_user_data(display, display_refr_event_cb, NULL);
+        lv_timer_set_period(lv_display_get_refr_timer(display), LV_DEF_REFR_PERIOD);
+    }
+    display_ctx.vsync_sched = enable;
+}
+
+static void display_throttle_event_cb(lv_event_t *e) {
+    lv_mutex_lock(&display_ctx.gate_lock);
+    if (lv_event_get_code(e) == LV_EVENT_REFR_START) {
+        display_ctx.render_cycle++;
+        display_ctx.rendering = true;
+    } else {
+        display_ctx.rendering = false;
+    }
+    lv_mutex_unlock(&display_ctx.gate_lock);
+}
+
+void display_set_underflow_policy(uint32_t policy, display_underflow_cb_t cb, void *user_data) {
+    lv_display_t *display = display_ctx.lv_disp;
+
+    if ((policy & DISPLAY_UNDERFLOW_THROTTLE) && !display_ctx.frame_sema) {
+        rtos_sema_create(&display_ctx.frame_sema, 0, 1);
+    }
+
+    // Render cycles are gated as a whole, without a display every job is on its own
+    if (display) {
+        lv_display_remove_event_cb_with_user_data(display, display_throttle_event_cb, NULL);
+        if (policy & DISPLAY_UNDERFLOW_THROTTLE) {
+            lv_display_add_event_cb(display, display_throttle_event_cb, LV_EVENT_REFR_START, NULL);
+            lv_display_add_event_cb(display, display_throttle_event_cb, LV_EVENT_REFR_READY, NULL);
+        }
+    }
+
+    display_ctx.underflow_cb = cb;
+    display_ctx.underflow_user_data = user_data;
+    display_ctx.underflow_policy = policy;
+}
+
+/*
+ * While throttling, the first PPE/JPEG job of an LVGL refresh waits for the next frame
+ * done and the rest of the refresh follows it, so a refresh competes with at most one
+ * frame of scan-out. Jobs outside refreshes (async decodes) get a frame each.
+ */
+void display_bandwidth_wait(void) {
+    if (!(display_ctx.underflow_policy & DISPLAY_UNDERFLOW_THROTTLE) || !display_ctx.frame_sema) {
+        return;
+    }
+
+    lcdc_underflow_info_t underflow;
+    lcdc_get_underflow_info(&underflow);
+    uint64_t now = rtos_time_get_current_system_time_ns();
+    if (!underflow.last_ns || now - underflow.last_ns > (uint64_t)BACKOFF_HOLD_MS * 1000000) {
+        return;
+    }
+
+    lcdc_vsync_info_t vsync;
+    lcdc_get_vsync_info(&vsync);
+    if (!vsync.frame_period_ns) {
+        return;
+    }
+
+    // Held while waiting, other jobs then find the gate open
+    lv_mutex_lock(&display_ctx.gate_lock);
+    bool open = display_ctx.rendering ? display_ctx.gate_cycle == display_ctx.render_cycle :
+                display_ctx.gate_frame == vsync.frame_count;
+    if (!open) {
+        // Drop a frame done from before, then give up after two frames in case the LCDC stopped
+        rtos_sema_take(display_ctx.frame_sema, 0);
+        rtos_sema_take(display_ctx.frame_sema, 2 * vsync.frame_period_ns / 1000000 + 1);
+        lcdc_get_vsync_info(&vsync);
+        display_ctx.gate_cycle = display_ctx.render_cycle;
+        display_ctx.gate_frame = vsync.frame_count;
+        display_ctx.throttled_frames++;
+    }
+    lv_mutex_unlock(&display_ctx.gate_lock);
+}
+
+static void display_set_input_paused(bool pause) {
+    for (lv_indev_t *indev = lv_indev_get_next(NULL); indev; indev = lv_indev_get_next(indev)) {
+        lv_timer_t *read_timer = lv_indev_get_read_timer(indev);
+        if (!read_timer) {
+            continue;
+        }
+        if (pause) {
+            lv_timer_pause(read_timer);
+        } else {
+            lv_timer_resume(read_timer);
+        }
+    }
+}
+
+static void display_idle_enter(void) {
+    lv_timer_pause(lv_display_get_refr_timer(display_ctx.lv_disp));
+    if (display_ctx.idle_pause_input) {
+        display_set_input_paused(true);
+    }
+
+    display_ctx.idle = true;
+    display_ctx.idle_start = rtos_time_get_current_system_time_ms();
+    display_ctx.idle_entries++;
+}
+
+static void display_idle_exit(void) {
+    display_ctx.idle_count = 0;
+    if (!display_ctx.idle) {
+        return;
+    }
+
+    display_ctx.idle = false;
+    display_ctx.idle_time_ms += rtos_time_get_current_system_time_ms() - display_ctx.idle_start;
+
+    lv_timer_resume(lv_display_get_refr_timer(display_ctx.lv_disp));
+    if (display_ctx.idle_pause_input) {
+        display_set_input_paused(false);
+    }
+
+    // An invalidation from another thread finds the LVGL task asleep in display_idle_wait
+    rtos_sema_give(display_ctx.wake_sema);
+}
+
+static void display_idle_event_cb(lv_event_t *e) {
+    switch (lv_event_get_code(e)) {
+        case LV_EVENT_REFR_START:
+            display_ctx.frame_submitted = false;
+            break;
+        case LV_EVENT_REFR_READY:
+            if (display_ctx.frame_submitted) {
+                display_ctx.idle_count = 0;
+            } else if (++display_ctx.idle_count >= display_ctx.idle_frames && !display_ctx.idle) {
+                display_idle_enter();
+            }
+            break;
+        case LV_EVENT_INVALIDATE_AREA:
+            // Animations, timers and input end up here, refresh again
+            display_idle_exit();
+            break;
+        default:
+            break;
+    }
+}
+
+void display_set_idle_mode(uint32_t idle_frames, bool pause_input) {
+    lv_display_t *display = display_ctx.lv_disp;
+    if (!display) {
+        RTK_LOGE(LOG_TAG, "No LVGL display set\n");
+        return;
+    }
+
+    if (!display_ctx.wake_sema) {
+        rtos_sema_create(&display_ctx.wake_sema, 0, RTOS_SEMA_MAX_COUNT);
+    }
+
+    display_idle_exit();
+    lv_display_remove_event_cb_with_user_data(display, display_idle_event_cb, NULL);
+
+    display_ctx.idle_frames = idle_frames;
+    display_ctx.idle_pause_input = pause_input;
+    if (idle_frames) {
+        lv_display_add_event_cb(display, display_idle_event_cb, LV_EVENT_REFR_START, NULL);
+        lv_display_add_event_cb(display, display_idle_event_cb, LV_EVENT_REFR_READY, NULL);
+        lv_display_add_event_cb(display, display_idle_event_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+    }
+}
+
+void display_idle_wait(uint32_t ms) {
+    if (!display_ctx.wake_sema) {
+        rtos_time_delay_ms(ms == LV_NO_TIMER_READY ? LV_DEF_REFR_PERIOD : ms);
+        return;
+    }
+
+    // Nothing scheduled while idle: sleep until woken
+    if (ms == LV_NO_TIMER_READY) {
+        ms = display_ctx.idle ? RTOS_MAX_TIMEOUT : LV_DEF_REFR_PERIOD;
+    }
+    rtos_sema_take(display_ctx.wake_sema, ms);
+
+    if (display_ctx.wake_pending) {
+        display_ctx.wake_pending = false;
+        display_idle_exit();
+    }
+}
+
+void display_idle_wake(void) {
+    if (!display_ctx.wake_sema) {
+        return;
+    }
+
+    display_ctx.wake_pending = true;
+    rtos_sema_give(display_ctx.wake_sema);
+}
@@ -0,0 +1,434 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ameba_soc.h"
+#include "os_wrapper.h"
+
+#include "jpeg_decoder.h"
+#include "jpeg_decoder_private.h"
+#include "jpeg_cache.h"
+
+#include "src/stdlib/lv_mem.h"
+#include "src/stdlib/lv_string.h"
+#include "src/misc/cache/lv_image_cache.h"
+
+#define LOG_TAG "JPEG-Async"
+
+#define JPEG_ASYNC_POLL_PERIOD      10  // ms, completion check in LVGL thread
+#define JPEG_ASYNC_STACK_SIZE       (8 * 1024)
+#define JPEG_ASYNC_HOLD_TICKS       10  // timer runs an applied image keeps its cache entry undrawn
+
+/*
+ * Jobs go pending -> running -> done -> applied. The worker only touches the source and
+ * the decoded buffer, everything related to lv_obj happens in the LVGL thread (API calls
+ * and the completion timer). A cancelled job keeps its slot with img = NULL.
+ * Applied jobs hold the cache entry until img was drawn once, so it can't be evicted
+ * before the draw opens it. An image that isn't drawn (hidden, off screen) gives it up
+ * after JPEG_ASYNC_HOLD_TICKS, the entry is then an ordinary LRU one.
+ */
+typedef struct jpeg_async_job {
+    struct jpeg_async_job *next;
+    lv_obj_t *img;
+    lv_image_src_t src_type;
+    const void *src;            // path copy or lv_image_dsc_t
+    lv_draw_buf_t *decoded;     // referenced in jpeg cache until img is drawn
+    lv_image_src_t shown_type;
+    const void *shown;          // source of img while decoding, copied for strings
+    uint8_t ticks;              // timer runs since applied
+    bool drawn;
+} jpeg_async_job_t;
+
+typedef struct {
+    lv_thread_t thread;
+    lv_thread_sync_t sync;
+    lv_mutex_t lock;
+    lv_timer_t *timer;
+    jpeg_async_job_t *pending;
+    jpeg_async_job_t *running;
+    jpeg_async_job_t *done;
+    jpeg_async_job_t *applied;
+    const void *placeholder;
+    uint32_t outstanding;
+    volatile bool exit_status;
+    volatile bool thread_exited;
+    bool inited;
+} jpeg_async_t;
+
+static jpeg_async_t async_ctx = {0};
+
+static void job_free(jpeg_async_job_t *job)
+{
+    if (job->src_type == LV_IMAGE_SRC_FILE) {
+        lv_free((void *)job->src);
+    }
+    if (job->shown_type == LV_IMAGE_SRC_FILE || job->shown_type == LV_IMAGE_SRC_SYMBOL) {
+        lv_free((void *)job->shown);
+    }
+    lv_free(job);
+}
+
+/* Remember what img shows, lv_image keeps its own copy of string sources */
+static bool job_set_shown(jpeg_async_job_t *job, const void *src)
+{
+    job->shown_type = src ? lv_image_src_get_type(src) : LV_IMAGE_SRC_UNKNOWN;
+    if (job->shown_type == LV_IMAGE_SRC_FILE || job->shown_type == LV_IMAGE_SRC_SYMBOL) {
+        job->shown = lv_strdup(src);
+        return job->shown != NULL;
+    }
+    job->shown = src;
+    return true;
+}
+
+/* False if the app set another source on img while the job was running */
+static bool job_img_unchanged(const jpeg_async_job_t *job)
+{
+    const void *src = lv_image_get_src(job->img);
+    lv_image_src_t src_type = src ? lv_image_src_get_type(src) : LV_IMAGE_SRC_UNKNOWN;
+
+    if (src_type != job->shown_type) {
+        return false;
+    }
+    if (src_type == LV_IMAGE_SRC_FILE || src_type == LV_IMAGE_SRC_SYMBOL) {
+        return lv_strcmp(src, job->shown) == 0;
+    }
+    return src == job->shown;
+}
+
+static void list_append(jpeg_async_job_t **list, jpeg_async_job_t *job)
+{
+    job->next = NULL;
+    while (*list) {
+        list = &(*list)->next;
+    }
+    *list = job;
+}
+
+static void img_delete_cb(lv_event_t *e);
+static void img_draw_cb(lv_event_t *e);
+
+/* Must be called with async_ctx.lock held, from the LVGL thread */
+static void cancel_locked(lv_obj_t *img, bool remove_event)
+{
+    jpeg_async_job_t **pp = &async_ctx.pending;
+    while (*pp) {
+        jpeg_async_job_t *job = *pp;
+        if (job->img == img) {
+            *pp = job->next;
+            if (remove_event) {
+                lv_obj_remove_event_cb_with_user_data(img, img_delete_cb, job);
+            }
+            job_free(job);
+            async_ctx.outstanding--;
+        } else {
+            pp = &job->next;
+        }
+    }
+
+    jpeg_async_job_t *job = async_ctx.running;
+    if (job && job->img == img) {
+        if (remove_event) {
+            lv_obj_remove_event_cb_with_user_data(img, img_delete_cb, job);
+        }
+        job->img = NULL;
+    }
+
+    for (job = async_ctx.done; job; job = job->next) {
+        if (job->img == img) {
+            if (remove_event) {
+                lv_obj_remove_event_cb_with_user_data(img, img_delete_cb, job);
+            }
+            job->img = NULL;
+        }
+    }
+
+    pp = &async_ctx.applied;
+    while (*pp) {
+        job = *pp;
+        if (job->img == img) {
+            *pp = job->next;
+            if (remove_event) {
+                lv_obj_remove_event_cb_with_user_data(img, img_delete_cb, job);
+                lv_obj_remove_event_cb_with_user_data(img, img_draw_cb, job);
+            }
+            jpeg_cache_release(job->decoded);
+            job_free(job);
+        } else {
+            pp = &job->next;
+        }
+    }
+}
+
+static void img_draw_cb(lv_event_t *e)
+{
+    jpeg_async_job_t *job = lv_event_get_user_data(e);
+
+    // released by the completion timer, after this refresh has finished drawing
+    job->drawn = true;
+}
+
+static void img_delete_cb(lv_event_t *e)
+{
+    lv_obj_t *img = lv_event_get_target(e);
+
+    lv_mutex_lock(&async_ctx.lock);
+    cancel_locked(img, false);
+    lv_mutex_unlock(&async_ctx.lock);
+}
+
+static void async_thread_cb(void *param)
+{
+    LV_UNUSED(param);
+
+    while (1) {
+        lv_mutex_lock(&async_ctx.lock);
+        bool exit_status = async_ctx.exit_status;
+        jpeg_async_job_t *job = async_ctx.pending;
+        if (job && !exit_status) {
+            async_ctx.pending = job->next;
+            job->next = NULL;
+            async_ctx.running = job;
+        }
+        lv_mutex_unlock(&async_ctx.lock);
+
+        if (exit_status) {
+            break;
+        }
+
+        if (!job) {
+            lv_thread_sync_wait(&async_ctx.sync);
+            continue;
+        }
+
+        lv_draw_buf_t *decoded = NULL;
+        if (jpeg_decoder_decode_src(job->src_type, job->src, true, &decoded) == LV_RESULT_OK) {
+            // Hand over through the cache, lv_image picks it up in decoder_open_cb
+            if (!jpeg_cache_insert(job->src_type, job->src, decoded)) {
+                RTK_LOGW(LOG_TAG, "Decoded image not cacheable, decode again on draw\n");
+                lv_draw_buf_destroy(decoded);
+                decoded = NULL;
+            }
+        }
+
+        lv_mutex_lock(&async_ctx.lock);
+        job->decoded = decoded;
+        async_ctx.running = NULL;
+        list_append(&async_ctx.done, job);
+        lv_mutex_unlock(&async_ctx.lock);
+    }
+
+    // Returning ends the task, lv_thread_delete must not be called afterwards
+    async_ctx.thread_exited = true;
+}
+
+static void async_timer_cb(lv_timer_t *timer)
+{
+    lv_mutex_lock(&async_ctx.lock);
+    jpeg_async_job_t *job = async_ctx.done;
+    async_ctx.done = NULL;
+
+    // Drawn since the last run, the draw holds its own reference now
+    jpeg_async_job_t **pp = &async_ctx.applied;
+    while (*pp) {
+        jpeg_async_job_t *applied = *pp;
+        if (applied->drawn || ++applied->ticks >= JPEG_ASYNC_HOLD_TICKS) {
+            *pp = applied->next;
+            lv_obj_remove_event_cb_with_user_data(applied->img, img_delete_cb, applied);
+            lv_obj_remove_event_cb_with_user_data(applied->img, img_draw_cb, applied);
+            jpeg_cache_release(applied->decoded);
+            job_free(applied);
+        } else {
+            pp = &applied->next;
+        }
+    }
+    lv_mutex_unlock(&async_ctx.lock);
+
+    while (job) {
+        jpeg_async_job_t *next = job->next;
+        bool apply = job->img && job_img_unchanged(job);
+
+        if (job->img && !apply) {
+            // a plain lv_image_set_src() replaced the placeholder, that one wins
+            lv_obj_remove_event_cb_with_user_data(job->img, img_delete_cb, job);
+        }
+
+        if (apply) {
+            // Invalidates img, a failed JPEG decode falls back to the other LVGL decoders
+            lv_image_set_src(job->img, job->src);
+        }
+
+        lv_mutex_lock(&async_ctx.lock);
+        async_ctx.outstanding--;
+        if (apply && job->decoded) {
+            lv_obj_add_event_cb(job->img, img_draw_cb, LV_EVENT_DRAW_MAIN_END, job);
+            job->next = async_ctx.applied;
+            async_ctx.applied = job;
+            job = NULL;
+        }
+        lv_mutex_unlock(&async_ctx.lock);
+
+        if (job) {
+            if (job->img && apply) {
+                lv_obj_remove_event_cb_with_user_data(job->img, img_delete_cb, job);
+            }
+            if (job->decoded) {
+                jpeg_cache_release(job->decoded);
+            }
+            job_free(job);
+        }
+
+        job = next;
+    }
+
+    if (async_ctx.outstanding == 0 && !async_ctx.applied) {
+        lv_timer_pause(timer);
+    }
+}
+
+void jpeg_async_init(void)
+{
+    if (async_ctx.inited) {
+        return;
+    }
+
+    lv_mutex_init(&async_ctx.lock);
+    lv_thread_sync_init(&async_ctx.sync);
+
+    async_ctx.timer = lv_timer_create(async_timer_cb, JPEG_ASYNC_POLL_PERIOD, NULL);
+    lv_timer_pause(async_ctx.timer);
+
+    async_ctx.exit_status = false;
+    async_ctx.thread_exited = false;
+    if (lv_thread_init(&async_ctx.thread, "jpegdec", LV_THREAD_PRIO_MID,
+                       async_thread_cb, JPEG_ASYNC_STACK_SIZE, NULL) != LV_RESULT_OK) {
+        RTK_LOGE(LOG_TAG, "Create worker thread failed\n");
+        lv_timer_delete(async_ctx.timer);
+        lv_thread_sync_delete(&async_ctx.sync);
+        lv_mutex_delete(&async_ctx.lock);
+        return;
+    }
+
+    async_ctx.inited = true;
+}
+
+void jpeg_async_deinit(void)
+{
+    if (!async_ctx.inited) {
+        return;
+    }
+
+    lv_mutex_lock(&async_ctx.lock);
+    async_ctx.exit_status = true;
+    lv_mutex_unlock(&async_ctx.lock);
+    lv_thread_sync_signal(&async_ctx.sync);
+
+    // Let a running decode finish, the HW must not be stopped halfway
+    while (!async_ctx.thread_exited) {
+        rtos_time_delay_ms(1);
+    }
+
+    // Worker has stopped, flush every remaining job without updating the images
+    lv_timer_delete(async_ctx.timer);
+
+    jpeg_async_job_t *lists[] = {async_ctx.pending, async_ctx.running, async_ctx.done, async_ctx.applied};
+    for (size_t i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+        jpeg_async_job_t *job = lists[i];
+        while (job) {
+            jpeg_async_job_t *next = job->next;
+            if (job->img) {
+                lv_obj_remove_event_cb_with_user_data(job->img, img_delete_cb, job);
+                lv_obj_remove_event_cb_with_user_data(job->img, img_draw_cb, job);
+            }
+            if (job->decoded) {
+                jpeg_cache_release(job->decoded);
+            }
+            job_free(job);
+            job = next;
+        }
+    }
+
+    lv_thread_sync_delete(&async_ctx.sync);
+    lv_mutex_delete(&async_ctx.lock);
+    memset(&async_ctx, 0, sizeof(async_ctx));
+}
+
+void lv_ameba_jpeg_async_set_placeholder(const void *src)
+{
+    async_ctx.placeholder = src;
+}
+
+void lv_ameba_jpeg_async_cancel(lv_obj_t *img)
+{
+    if (!async_ctx.inited) {
+        return;
+    }
+
+    lv_mutex_lock(&async_ctx.lock);
+    cancel_locked(img, true);
+    lv_mutex_unlock(&async_ctx.lock);
+}
+
+void lv_ameba_jpeg_image_set_src_async(lv_obj_t *img, const void *src)
+{
+    lv_image_src_t src_type = lv_image_src_get_type(src);
+
+    // Completed decodes are handed over through the jpeg cache, so it has to be in use
+    if (!async_ctx.inited || lv_image_cache_is_enabled() ||
+        (src_type != LV_IMAGE_SRC_FILE && src_type != LV_IMAGE_SRC_VARIABLE)) {
+        lv_image_set_src(img, src);
+        return;
+    }
+
+    lv_ameba_jpeg_async_cancel(img);
+
+    lv_draw_buf_t *cached = jpeg_cache_acquire(src_type, src);
+    if (cached) {
+        lv_image_set_src(img, src);
+        jpeg_cache_release(cached);
+        return;
+    }
+
+    jpeg_async_job_t *job = lv_malloc_zeroed(sizeof(jpeg_async_job_t));
+    if (!job) {
+        lv_image_set_src(img, src);
+        return;
+    }
+
+    job->img = img;
+    job->src_type = src_type;
+    job->src = (src_type == LV_IMAGE_SRC_FILE) ? lv_strdup(src) : src;
+    if (!job->src) {
+        lv_free(job);
+        lv_image_set_src(img, src);
+        return;
+    }
+
+    if (async_ctx.placeholder) {
+        lv_image_set_src(img, async_ctx.placeholder);
+    }
+    if (!job_set_shown(job, lv_image_get_src(img))) {
+        job_free(job);
+        lv_image_set_src(img, src);
+        return;
+    }
+    lv_obj_add_event_cb(img, img_delete_cb, LV_EVENT_DELETE, job);
+
+    lv_mutex_lock(&async_ctx.lock);
+    list_append(&async_ctx.pending, job);
+    async_ctx.outstanding++;
+    lv_mutex_unlock(&async_ctx.lock);
+
+    lv_timer_resume(async_ctx.timer);
+    lv_thread_sync_signal(&async_ctx.sync);
+}
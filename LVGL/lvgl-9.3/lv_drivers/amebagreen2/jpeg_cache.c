@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ameba_soc.h"
+#include "os_wrapper.h"
+
+#include "jpeg_cache.h"
+
+#include "src/stdlib/lv_mem.h"
+#include "src/stdlib/lv_string.h"
+
+#define LOG_TAG "JPEG-Cache"
+
+typedef struct jpeg_cache_entry {
+    struct jpeg_cache_entry *prev;
+    struct jpeg_cache_entry *next;
+    lv_image_src_t src_type;
+    char *path;                 // LV_IMAGE_SRC_FILE
+    const uint8_t *data;        // LV_IMAGE_SRC_VARIABLE
+    uint32_t data_size;
+    lv_draw_buf_t *buf;
+    uint32_t size;
+    uint32_t ref_cnt;
+    bool dropped;               // out of the LRU, freed by the last release
+} jpeg_cache_entry_t;
+
+typedef struct {
+    jpeg_cache_entry_t *head;   // most recently used
+    jpeg_cache_entry_t *tail;   // least recently used
+    jpeg_cache_entry_t *dropped; // dropped while in use, never returned by lookups
+    lv_mutex_t lock;
+    uint32_t max_size;
+    uint32_t used_size;
+    uint32_t entries;
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    bool initialized;
+} jpeg_cache_t;
+
+static jpeg_cache_t jpeg_cache = {0};
+
+static bool entry_match(const jpeg_cache_entry_t *entry, lv_image_src_t src_type, const void *src)
+{
+    if (entry->src_type != src_type) {
+        return false;
+    }
+
+    if (src_type == LV_IMAGE_SRC_FILE) {
+        return lv_strcmp(entry->path, (const char *)src) == 0;
+    }
+
+    const lv_image_dsc_t *img_dsc = src;
+    return entry->data == img_dsc->data && entry->data_size == img_dsc->data_size;
+}
+
+static void list_unlink(jpeg_cache_entry_t *entry)
+{
+    if (entry->prev) {
+        entry->prev->next = entry->next;
+    } else if (entry->dropped) {
+        jpeg_cache.dropped = entry->next;
+    } else {
+        jpeg_cache.head = entry->next;
+    }
+
+    if (entry->next) {
+        entry->next->prev = entry->prev;
+    } else if (!entry->dropped) {
+        jpeg_cache.tail = entry->prev;
+    }
+
+    entry->prev = NULL;
+    entry->next = NULL;
+}
+
+static void list_push_front(jpeg_cache_entry_t *entry)
+{
+    entry->prev = NULL;
+    entry->next = jpeg_cache.head;
+    if (jpeg_cache.head) {
+        jpeg_cache.head->prev = entry;
+    }
+    jpeg_cache.head = entry;
+    if (!jpeg_cache.tail) {
+        jpeg_cache.tail = entry;
+    }
+}
+
+static void entry_free(jpeg_cache_entry_t *entry)
+{
+    list_unlink(entry);
+    jpeg_cache.used_size -= entry->size;
+    jpeg_cache.entries--;
+
+    lv_draw_buf_destroy(entry->buf);
+    if (entry->path) {
+        lv_free(entry->path);
+    }
+    lv_free(entry);
+}
+
+static bool heap_low(uint32_t request)
+{
+    uint32_t free_size = rtos_mem_get_free_heap_size();
+    return free_size < request + JPEG_CACHE_HEAP_RESERVE;
+}
+
+/* Evict unused entries from the LRU end until the budget and heap reserve are met */
+static void cache_trim(uint32_t request)
+{
+    jpeg_cache_entry_t *entry = jpeg_cache.tail;
+
+    while (entry && (jpeg_cache.used_size > jpeg_cache.max_size || heap_low(request))) {
+        jpeg_cache_entry_t *prev = entry->prev;
+        if (entry->ref_cnt == 0) {
+            entry_free(entry);
+            jpeg_cache.evictions++;
+        }
+        entry = prev;
+    }
+}
+
+void jpeg_cache_init(uint32_t max_size)
+{
+    if (jpeg_cache.initialized) {
+        return;
+    }
+
+    memset(&jpeg_cache, 0, sizeof(jpeg_cache));
+    lv_mutex_init(&jpeg_cache.lock);
+    jpeg_cache.max_size = max_size;
+    jpeg_cache.initialized = true;
+}
+
+void jpeg_cache_deinit(void)
+{
+    if (!jpeg_cache.initialized) {
+        return;
+    }
+
+    lv_mutex_lock(&jpeg_cache.lock);
+    jpeg_cache_entry_t *entry = jpeg_cache.head;
+    while (entry) {
+        jpeg_cache_entry_t *next = entry->next;
+        if (entry->ref_cnt == 0) {
+            entry_free(entry);
+        } else {
+            RTK_LOGW(LOG_TAG, "Entry %p still in use\n", entry->buf);
+        }
+        entry = next;
+    }
+    for (entry = jpeg_cache.dropped; entry; entry = entry->next) {
+        RTK_LOGW(LOG_TAG, "Entry %p still in use\n", entry->buf);
+    }
+    jpeg_cache.initialized = false;
+    lv_mutex_unlock(&jpeg_cache.lock);
+
+    lv_mutex_delete(&jpeg_cache.lock);
+}
+
+lv_draw_buf_t *jpeg_cache_acquire(lv_image_src_t src_type, const void *src)
+{
+    lv_draw_buf_t *buf = NULL;
+
+    if (!jpeg_cache.initialized || jpeg_cache.max_size == 0) {
+        return NULL;
+    }
+
+    lv_mutex_lock(&jpeg_cache.lock);
+    for (jpeg_cache_entry_t *entry = jpeg_cache.head; entry; entry = entry->next) {
+        if (entry_match(entry, src_type, src)) {
+            entry->ref_cnt++;
+            list_unlink(entry);
+            list_push_front(entry);
+            buf = entry->buf;
+            break;
+        }
+    }
+
+    if (buf) {
+        jpeg_cache.hits++;
+    } else {
+        jpeg_cache.misses++;
+    }
+    lv_mutex_unlock(&jpeg_cache.lock);
+
+    return buf;
+}
+
+bool jpeg_cache_insert(lv_image_src_t src_type, const void *src, lv_draw_buf_t *buf)
+{
+    if (!jpeg_cache.initialized || buf->data_size > jpeg_cache.max_size) {
+        return false;
+    }
+
+    jpeg_cache_entry_t *entry = lv_malloc_zeroed(sizeof(jpeg_cache_entry_t));
+    if (!entry) {
+        return false;
+    }
+
+    entry->src_type = src_type;
+    if (src_type == LV_IMAGE_SRC_FILE) {
+        entry->path = lv_strdup((const char *)src);
+        if (!entry->path) {
+            lv_free(entry);
+            return false;
+        }
+    } else {
+        const lv_image_dsc_t *img_dsc = src;
+        entry->data = img_dsc->data;
+        entry->data_size = img_dsc->data_size;
+    }
+    entry->buf = buf;
+    entry->size = buf->data_size;
+    entry->ref_cnt = 1;
+
+    lv_mutex_lock(&jpeg_cache.lock);
+    list_push_front(entry);
+    jpeg_cache.used_size += entry->size;
+    jpeg_cache.entries++;
+    cache_trim(0);
+    lv_mutex_unlock(&jpeg_cache.lock);
+
+    return true;
+}
+
+void jpeg_cache_release(lv_draw_buf_t *buf)
+{
+    jpeg_cache_entry_t *entry = NULL;
+
+    if (jpeg_cache.initialized) {
+        lv_mutex_lock(&jpeg_cache.lock);
+        for (entry = jpeg_cache.head; entry; entry = entry->next) {
+            if (entry->buf == buf) {
+                if (entry->ref_cnt > 0) {
+                    entry->ref_cnt--;
+                }
+                break;
+            }
+        }
+        if (entry) {
+            cache_trim(0);
+        } else {
+            for (entry = jpeg_cache.dropped; entry; entry = entry->next) {
+                if (entry->buf == buf) {
+                    if (--entry->ref_cnt == 0) {
+                        entry_free(entry);
+                    }
+                    break;
+                }
+            }
+        }
+        lv_mutex_unlock(&jpeg_cache.lock);
+    }
+
+    if (!entry) {
+        lv_draw_buf_destroy(buf);
+    }
+}
+
+void jpeg_cache_reclaim(uint32_t size)
+{
+    if (!jpeg_cache.initialized) {
+        return;
+    }
+
+    lv_mutex_lock(&jpeg_cache.lock);
+    cache_trim(size);
+    lv_mutex_unlock(&jpeg_cache.lock);
+}
+
+void jpeg_cache_drop(const void *src)
+{
+    if (!jpeg_cache.initialized) {
+        return;
+    }
+
+    lv_image_src_t src_type = src ? lv_image_src_get_type(src) : LV_IMAGE_SRC_UNKNOWN;
+
+    lv_mutex_lock(&jpeg_cache.lock);
+    jpeg_cache_entry_t *entry = jpeg_cache.head;
+    while (entry) {
+        jpeg_cache_entry_t *next = entry->next;
+        bool match = (src == NULL) || entry_match(entry, src_type, src);
+        if (match && entry->ref_cnt == 0) {
+            entry_free(entry);
+        } else if (match) {
+            // decoded with the old hint or format, keep it for its users only
+            list_unlink(entry);
+            entry->dropped = true;
+            entry->next = jpeg_cache.dropped;
+            if (jpeg_cache.dropped) {
+                jpeg_cache.dropped->prev = entry;
+            }
+            jpeg_cache.dropped = entry;
+        }
+        entry = next;
+    }
+    lv_mutex_unlock(&jpeg_cache.lock);
+}
+
+void jpeg_cache_set_size(uint32_t max_size)
+{
+    if (!jpeg_cache.initialized) {
+        return;
+    }
+
+    lv_mutex_lock(&jpeg_cache.lock);
+    jpeg_cache.max_size = max_size;
+    cache_trim(0);
+    lv_mutex_unlock(&jpeg_cache.lock);
+}
+
+void jpeg_cache_get_stats(lv_ameba_jpeg_cache_stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+
+    if (!jpeg_cache.initialized) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+
+    lv_mutex_lock(&jpeg_cache.lock);
+    stats->hits = jpeg_cache.hits;
+    stats->misses = jpeg_cache.misses;
+    stats->evictions = jpeg_cache.evictions;
+    stats->entries = jpeg_cache.entries;
+    stats->used_size = jpeg_cache.used_size;
+    stats->max_size = jpeg_cache.max_size;
+    lv_mutex_unlock(&jpeg_cache.lock);
+}
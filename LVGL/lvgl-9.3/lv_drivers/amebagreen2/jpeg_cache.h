@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_UI_LVGL_LV_DRIVERS_JPEG_CACHE
+#define AMEBA_UI_LVGL_LV_DRIVERS_JPEG_CACHE
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lvgl.h"
+#include "jpeg_decoder.h"
+
+/* Byte budget for decoded JPEG draw buffers kept after close */
+#ifndef JPEG_CACHE_DEF_SIZE
+    #define JPEG_CACHE_DEF_SIZE         (4 * 1024 * 1024)
+#endif
+
+/* Keep at least this much heap (PSRAM) free, evicting cached images if needed */
+#ifndef JPEG_CACHE_HEAP_RESERVE
+    #define JPEG_CACHE_HEAP_RESERVE     (1024 * 1024)
+#endif
+
+void jpeg_cache_init(uint32_t max_size);
+void jpeg_cache_deinit(void);
+
+/* Return a referenced buffer for src, or NULL on miss */
+lv_draw_buf_t *jpeg_cache_acquire(lv_image_src_t src_type, const void *src);
+
+/* Insert a freshly decoded buffer, the caller holds the first reference */
+bool jpeg_cache_insert(lv_image_src_t src_type, const void *src, lv_draw_buf_t *buf);
+
+/* Drop one reference, buffers not tracked by the cache are destroyed */
+void jpeg_cache_release(lv_draw_buf_t *buf);
+
+/* Evict unused entries until at least size bytes could be allocated */
+void jpeg_cache_reclaim(uint32_t size);
+
+/* Forget src (all with NULL), buffers still in use are freed by their last release */
+void jpeg_cache_drop(const void *src);
+void jpeg_cache_set_size(uint32_t max_size);
+void jpeg_cache_get_stats(lv_ameba_jpeg_cache_stats_t *stats);
+
+#endif // AMEBA_UI_LVGL_LV_DRIVERS_JPEG_CACHE
@@ -14,6 +14,12 @@
  */
 
 #include "jpeg_decoder.h"
+#include "jpeg_cache.h"
+#include "jpeg_header.h"
+#include "jpeg_sw_decoder.h"
+#include "jpeg_decoder_private.h"
+#include "display.h"
+#include "lv_draw_ppe.h"
 
 #include "ameba_soc.h"
 #include "os_wrapper.h"
@@ -23,15 +29,86 @@
 #include "src/draw/lv_image_decoder_private.h"
 #include "src/core/lv_global.h"
 #include "src/stdlib/lv_mem.h"
+#include "src/stdlib/lv_string.h"
 #include "src/misc/lv_fs.h"
 #include "src/misc/lv_log.h"
 #include "src/misc/lv_assert.h"
+#include "src/misc/cache/lv_cache.h"
+#include "src/misc/cache/lv_image_cache.h"
+#include "src/misc/cache/lv_image_header_cache.h"
+#include "src/widgets/image/lv_image.h"
 
 #define DECODER_NAME "JPEG_RTK"
 
 #define TIME_DEBUG 0
 #define FILE_TIME_DEBUG 0
 
+#define JPEG_DECODE_HINT_MAX        16
+#define JPEG_SCALE_DENOM            8   // decode scale steps, shared by PP and DCT scaling
+#define PP_OUT_ALIGN_W              8
+#define PP_OUT_ALIGN_H              2
+
+#ifndef JPEG_ROI_DEF_THRESHOLD
+#define JPEG_ROI_DEF_THRESHOLD      (1024 * 1024)   // larger decodes only decode the drawn area
+#endif
+#define JPEG_ROI_ALIGN              16  // MCU size and PP crop origin alignment
+
+#ifndef JPEG_OUTPUT_YUV
+#define JPEG_OUTPUT_YUV             0   // keep decodes in NV12, converted to RGB by the PPE draw unit
+#endif
+
+typedef struct {
+    lv_fs_file_t *file;
+    const uint8_t *data;
+    uint32_t size;
+} jpeg_stream_t;
+
+typedef struct {
+    lv_image_src_t src_type;
+    char *path;                 // LV_IMAGE_SRC_FILE
+    const void *dsc;            // LV_IMAGE_SRC_VARIABLE
+    uint32_t scale;             // LVGL scale units, 0 if max_w/max_h is used
+    uint32_t max_w;
+    uint32_t max_h;
+} decode_hint_t;
+
+static decode_hint_t decode_hints[JPEG_DECODE_HINT_MAX];
+static lv_mutex_t decode_hint_lock;
+
+/*
+ * Decoder and PP instances are created on first use and kept until
+ * lv_ameba_jpeg_deinit(), PP input/output geometry is only rewritten when
+ * it differs from the previous decode. lock serializes all use of the core.
+ */
+typedef struct {
+    lv_mutex_t lock;
+    JpegDecInst jpeg_inst;
+    PPInst pp_inst;
+    PPConfig pp_conf;
+    lv_image_header_t in_header;
+    uint32_t out_w;
+    uint32_t out_h;
+    bool combined;
+    bool inited;
+} hw_context_t;
+
+/*
+ * Images above roi_threshold are not decoded in decoder_open_cb, only the area
+ * LVGL draws is decoded in decoder_get_area_cb. Compressed data stays loaded.
+ */
+typedef struct {
+    uint8_t *file_data;         // loaded file, NULL for LV_IMAGE_SRC_VARIABLE
+    const uint8_t *data;
+    uint32_t size;
+    lv_image_header_t src_header;
+    lv_draw_buf_t *decoded;     // area buffer, reused while the size fits
+} roi_context_t;
+
+static hw_context_t hw_ctx;
+static lv_image_decoder_t *jpeg_decoder;
+static volatile bool output_yuv = JPEG_OUTPUT_YUV;
+static uint32_t roi_threshold = JPEG_ROI_DEF_THRESHOLD;
+
 static uint8_t *read_file(const char *filename, uint32_t *size)
 {
 #if FILE_TIME_DEBUG
@@ -184,30 +261,215 @@ static int purpose_lv_format(void)
     return LV_RESULT_INVALID;
 }
 
+/* Format of the decoded draw buffers, NV12 needs 1.5 bytes per pixel */
+static lv_color_format_t output_lv_format(void)
+{
+#if LV_USE_DRAW_PPE
+    // Only the PPE draw unit draws NV12, stay in RGB without it
+    if (output_yuv && lv_draw_ppe_is_inited()) {
+        return LV_COLOR_FORMAT_NV12;
+    }
+#endif
+    return purpose_lv_format();
+}
+
+static uint32_t output_buf_size(uint32_t w, uint32_t h, lv_color_format_t cf)
+{
+    if (cf == LV_COLOR_FORMAT_NV12) {
+        return w * h * 3 / 2;
+    }
+    return lv_draw_buf_width_to_stride(w, cf) * h;
+}
+
+static lv_draw_buf_t *output_buf_create(uint32_t w, uint32_t h, lv_color_format_t cf)
+{
+    if (cf != LV_COLOR_FORMAT_NV12) {
+        return lv_draw_buf_create(w, h, cf, lv_draw_buf_width_to_stride(w, cf));
+    }
+
+    // lv_draw_buf has no size calculation for YUV, allocate Y and CbCr planes as L8
+    lv_draw_buf_t *buf = lv_draw_buf_create(w, h * 3 / 2, LV_COLOR_FORMAT_L8, w);
+    if (buf) {
+        buf->header.cf = LV_COLOR_FORMAT_NV12;
+        buf->header.h = h;
+    }
+    return buf;
+}
+
+static bool stream_read(void *user_data, uint32_t offset, uint8_t *buf, uint32_t len)
+{
+    jpeg_stream_t *stream = user_data;
+
+    if (stream->file) {
+        uint32_t rn;
+        if (lv_fs_seek(stream->file, offset, LV_FS_SEEK_SET) != LV_FS_RES_OK) {
+            return false;
+        }
+        return lv_fs_read(stream->file, buf, len, &rn) == LV_FS_RES_OK && rn == len;
+    }
+
+    if (offset + len > stream->size) {
+        return false;
+    }
+    memcpy(buf, stream->data + offset, len);
+    return true;
+}
+
+static int sampling_to_hw_format(uint8_t sampling)
+{
+    switch (sampling) {
+    case JPEG_SAMPLING_400:
+        return JPEGDEC_YCbCr400;
+    case JPEG_SAMPLING_420:
+        return JPEGDEC_YCbCr420_SEMIPLANAR;
+    case JPEG_SAMPLING_422:
+        return JPEGDEC_YCbCr422_SEMIPLANAR;
+    case JPEG_SAMPLING_440:
+        return JPEGDEC_YCbCr440;
+    case JPEG_SAMPLING_411:
+        return JPEGDEC_YCbCr411_SEMIPLANAR;
+    default:
+        return JPEGDEC_YCbCr444_SEMIPLANAR;
+    }
+}
+
+/* Only the marker headers and SOF are read, through lv_fs for files */
+static lv_result_t parse_jpeg_header(jpeg_stream_t *stream, lv_image_header_t *header)
+{
+    jpeg_header_t jpeg;
+
+    if (jpeg_header_parse(stream_read, stream, &jpeg) != 0) {
+        return LV_RESULT_INVALID;
+    }
+
+    // Same as JpegDecGetImageInfo outputWidth/outputHeight: MCU aligned
+    header->w = (jpeg.width + 15) & ~15;
+    header->h = (jpeg.height + 15) & ~15;
+    header->cf = trans_format_hw2sw(sampling_to_hw_format(jpeg.sampling));
+    return LV_RESULT_OK;
+}
+
+static decode_hint_t *decode_hint_find(lv_image_src_t src_type, const void *src)
+{
+    for (int i = 0; i < JPEG_DECODE_HINT_MAX; i++) {
+        decode_hint_t *hint = &decode_hints[i];
+        if (hint->src_type != src_type) {
+            continue;
+        }
+        if (src_type == LV_IMAGE_SRC_FILE && hint->path && lv_strcmp(hint->path, src) == 0) {
+            return hint;
+        }
+        if (src_type == LV_IMAGE_SRC_VARIABLE && hint->dsc == src) {
+            return hint;
+        }
+    }
+    return NULL;
+}
+
+/* Decode scale in 1/JPEG_SCALE_DENOM steps, rounded up so the result is never smaller than requested */
+static uint32_t decode_hint_get_scale(lv_image_src_t src_type, const void *src, const lv_image_header_t *src_header)
+{
+    uint32_t scale = LV_SCALE_NONE;
+
+    lv_mutex_lock(&decode_hint_lock);
+    decode_hint_t *hint = decode_hint_find(src_type, src);
+    if (hint && hint->scale) {
+        scale = hint->scale;
+    } else if (hint) {
+        scale = LV_MIN(hint->max_w * LV_SCALE_NONE / src_header->w, hint->max_h * LV_SCALE_NONE / src_header->h);
+    }
+    lv_mutex_unlock(&decode_hint_lock);
+
+    uint32_t num = (scale * JPEG_SCALE_DENOM + LV_SCALE_NONE - 1) / LV_SCALE_NONE;
+    return LV_CLAMP(1, num, JPEG_SCALE_DENOM);
+}
+
+static void scale_header(lv_image_header_t *header, uint32_t scale_num)
+{
+    if (scale_num >= JPEG_SCALE_DENOM) {
+        return;
+    }
+
+    uint32_t w = header->w * scale_num / JPEG_SCALE_DENOM;
+    uint32_t h = header->h * scale_num / JPEG_SCALE_DENOM;
+    header->w = LV_MAX(w & ~(PP_OUT_ALIGN_W - 1), PP_OUT_ALIGN_W);
+    header->h = LV_MAX(h & ~(PP_OUT_ALIGN_H - 1), PP_OUT_ALIGN_H);
+}
+
+static void decode_hint_set(const void *src, uint32_t scale, uint32_t max_w, uint32_t max_h)
+{
+    lv_image_src_t src_type = lv_image_src_get_type(src);
+    if (src_type != LV_IMAGE_SRC_FILE && src_type != LV_IMAGE_SRC_VARIABLE) {
+        return;
+    }
+
+    lv_mutex_lock(&decode_hint_lock);
+    decode_hint_t *hint = decode_hint_find(src_type, src);
+    if (!hint && (scale || max_w || max_h)) {
+        for (int i = 0; i < JPEG_DECODE_HINT_MAX; i++) {
+            if (decode_hints[i].src_type == LV_IMAGE_SRC_UNKNOWN) {
+                hint = &decode_hints[i];
+                break;
+            }
+        }
+        if (hint) {
+            hint->src_type = src_type;
+            if (src_type == LV_IMAGE_SRC_FILE) {
+                hint->path = lv_strdup(src);
+            } else {
+                hint->dsc = src;
+            }
+        } else {
+            LV_LOG_WARN("no free decode hint slot");
+        }
+    }
+
+    if (hint && !scale && !max_w && !max_h) {
+        if (hint->path) {
+            lv_free(hint->path);
+        }
+        memset(hint, 0, sizeof(*hint));
+        hint->src_type = LV_IMAGE_SRC_UNKNOWN;
+    } else if (hint) {
+        hint->scale = scale;
+        hint->max_w = max_w;
+        hint->max_h = max_h;
+    }
+    lv_mutex_unlock(&decode_hint_lock);
+
+    // Decoded size changes, previous header and decode must not be reused
+    lv_image_header_cache_drop(src);
+    lv_image_cache_drop(src);
+    jpeg_cache_drop(src);
+}
+
 static lv_result_t decoder_info_cb(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc, lv_image_header_t *header)
 {
     LV_UNUSED(decoder);
     const void *src = dsc->src;
     lv_image_src_t src_type = dsc->src_type;
 
-    JpegDecImageInfo image_info;
-    JpegDecInput jpeg_in;
-    uint8_t *data = NULL;
+    jpeg_stream_t stream;
+    lv_fs_file_t f;
     lv_result_t res = LV_RESULT_INVALID;
 
+    memset(&stream, 0, sizeof(stream));
+
+#if TIME_DEBUG
+    uint64_t start, end;
+    uint64_t time_used;
+    start = rtos_time_get_current_system_time_ns();
+#endif
+
     if (src_type == LV_IMAGE_SRC_FILE) {
-        uint32_t data_size;
-        data = read_file((const char *)dsc->src, &data_size);
-        if (data == NULL) {
-            LV_LOG_WARN("can't load file %s", dsc->src);
+        if (lv_fs_open(&f, (const char *)src, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+            LV_LOG_WARN("can't open %s", (const char *)src);
             return LV_RESULT_INVALID;
         }
 
-        memset(&jpeg_in, 0, sizeof(jpeg_in));
-        jpeg_in.streamBuffer.pVirtualAddress = (u32 *)data;
-        jpeg_in.streamBuffer.busAddress = (u32)data;
-        jpeg_in.streamLength = data_size;
-        DCache_Clean((u32)data, data_size);
+        stream.file = &f;
+        res = parse_jpeg_header(&stream, header);
+        lv_fs_close(&f);
     } else if (src_type == LV_IMAGE_SRC_VARIABLE) {
         const lv_image_dsc_t *img_dsc = src;
         if (img_dsc->data_size < 4) {
@@ -216,77 +478,232 @@ static lv_result_t decoder_info_cb(lv_image_decoder_t *decoder, lv_image_decoder
         if (img_dsc->data[0] != 0xFF || img_dsc->data[1] != 0xD8 || img_dsc->data[2] != 0xFF) {
             return LV_RESULT_INVALID;
         }
-        memset(&jpeg_in, 0, sizeof(jpeg_in));
-        jpeg_in.streamBuffer.pVirtualAddress = (u32 *)img_dsc->data;
-        jpeg_in.streamBuffer.busAddress = (u32)img_dsc->data;
-        jpeg_in.streamLength = img_dsc->data_size;
-    } else {
-        return LV_RESULT_INVALID;
+
+        stream.data = img_dsc->data;
+        stream.size = img_dsc->data_size;
+        res = parse_jpeg_header(&stream, header);
+    }
+
+    if (res == LV_RESULT_OK) {
+        scale_header(header, decode_hint_get_scale(src_type, src, header));
+        header->cf = output_lv_format(); // Format changed after PP process
     }
+
+#if TIME_DEBUG
+    end = rtos_time_get_current_system_time_ns();
+    time_used = end - start;
+    printf("Get Info used: %lld ns\n", time_used);
+#endif
+    return res;
+}
+
+static void hw_context_release(void)
+{
+    if (hw_ctx.combined) {
+        PPDecCombinedModeDisable(hw_ctx.pp_inst, hw_ctx.jpeg_inst);
+    }
+    if (hw_ctx.pp_inst) {
+        PPRelease(hw_ctx.pp_inst);
+    }
+    if (hw_ctx.jpeg_inst) {
+        JpegDecRelease(hw_ctx.jpeg_inst);
+    }
+
+    hw_ctx.jpeg_inst = NULL;
+    hw_ctx.pp_inst = NULL;
+    hw_ctx.combined = false;
+    hw_ctx.inited = false;
+}
+
+static lv_result_t hw_context_setup(void)
+{
 #if TIME_DEBUG
     uint64_t start, end;
-    uint64_t time_used;
     start = rtos_time_get_current_system_time_ns();
 #endif
 
-    JpegDecInst jpeg_inst;
-
-    if (JpegDecInit(&jpeg_inst) != JPEGDEC_OK) {
+    if (JpegDecInit(&hw_ctx.jpeg_inst) != JPEGDEC_OK) {
         printf("Error: JpegDecInit Failed.\n");
-        res = LV_RESULT_INVALID;
-        goto end;
+        goto failed;
+    }
+
+    if (PPInit(&hw_ctx.pp_inst) != PP_OK) {
+        printf("Error: PPInit Failed.\n");
+        goto failed;
     }
 
-    if (JpegDecGetImageInfo(jpeg_inst, &jpeg_in, &image_info) == JPEGDEC_OK) {
-        header->w = image_info.outputWidth;
-        header->h = image_info.outputHeight;
-        header->cf = trans_format_hw2sw(image_info.outputFormat);
-        res = LV_RESULT_OK;
+    if (PPDecCombinedModeEnable(hw_ctx.pp_inst, hw_ctx.jpeg_inst, PP_PIPELINED_DEC_TYPE_JPEG) != PP_OK) {
+        printf("Error: PPDecCombinedModeEnable Failed.\n");
+        goto failed;
     }
+    hw_ctx.combined = true;
+
+    memset(&hw_ctx.pp_conf, 0, sizeof(hw_ctx.pp_conf));
+    if (PPGetConfig(hw_ctx.pp_inst, &hw_ctx.pp_conf) != PP_OK) {
+        printf("Error: PPGetConfig Failed.\n");
+        goto failed;
+    }
+
+    /* Jessica */
+    hw_ctx.pp_conf.ppInImg.videoRange = 1;
+    hw_ctx.pp_conf.ppOutRgb.rgbTransform = PP_YCBCR2RGB_TRANSFORM_BT_709;
+
+    memset(&hw_ctx.in_header, 0, sizeof(hw_ctx.in_header));
+    hw_ctx.out_w = 0;
+    hw_ctx.out_h = 0;
+    hw_ctx.inited = true;
 
 #if TIME_DEBUG
     end = rtos_time_get_current_system_time_ns();
-    time_used = end - start;
-    printf("Decode info Time used: %lld ns\n", time_used);
+    printf("HW setup used: %lld ns\n", end - start);
 #endif
+    return LV_RESULT_OK;
 
-    if (jpeg_inst) {
-        JpegDecRelease(jpeg_inst);
+failed:
+    hw_context_release();
+    return LV_RESULT_INVALID;
+}
+
+/* Called with hw_ctx.lock held. crop selects a source area (no scaling), origin aligned to 16 */
+static lv_result_t hw_decode(const uint8_t *data, uint32_t size, const lv_image_header_t *src_header,
+                             const lv_area_t *crop, lv_draw_buf_t *decoded)
+{
+    JpegDecInput jpeg_in;
+    JpegDecOutput jpeg_out;
+    PPConfig *pp_conf = &hw_ctx.pp_conf;
+
+    if (!hw_ctx.inited && hw_context_setup() != LV_RESULT_OK) {
+        return LV_RESULT_INVALID;
     }
-end:
-    if (data) {
-        lv_free(data);
+
+    memset(&jpeg_in, 0, sizeof(jpeg_in));
+    memset(&jpeg_out, 0, sizeof(jpeg_out));
+
+    jpeg_in.streamBuffer.pVirtualAddress = (u32 *)data;
+    jpeg_in.streamBuffer.busAddress = (u32)data;
+    jpeg_in.streamLength = size;
+
+    if (hw_ctx.in_header.w != src_header->w || hw_ctx.in_header.h != src_header->h ||
+        hw_ctx.in_header.cf != src_header->cf) {
+        pp_conf->ppInImg.width = src_header->w;
+        pp_conf->ppInImg.height = src_header->h;
+        pp_conf->ppInImg.pixFormat = trans_format_sw2hw(src_header->cf);
+        hw_ctx.in_header = *src_header;
+    }
+
+    // PP scales to the output size when it differs from the input
+    if (hw_ctx.out_w != decoded->header.w || hw_ctx.out_h != decoded->header.h) {
+        pp_conf->ppOutImg.width = decoded->header.w;
+        pp_conf->ppOutImg.height = decoded->header.h;
+        hw_ctx.out_w = decoded->header.w;
+        hw_ctx.out_h = decoded->header.h;
+    }
+
+    if (crop) {
+        pp_conf->ppInCrop.enable = 1;
+        pp_conf->ppInCrop.originX = crop->x1;
+        pp_conf->ppInCrop.originY = crop->y1;
+        pp_conf->ppInCrop.width = lv_area_get_width(crop);
+        pp_conf->ppInCrop.height = lv_area_get_height(crop);
+    } else {
+        pp_conf->ppInCrop.enable = 0;
+    }
+
+    pp_conf->ppOutImg.bufferBusAddr = (u32)decoded->data;
+    if (decoded->header.cf == LV_COLOR_FORMAT_NV12) {
+        // CbCr plane follows the Y plane
+        pp_conf->ppOutImg.pixFormat = PP_PIX_FMT_YCBCR_4_2_0_SEMIPLANAR;
+        pp_conf->ppOutImg.bufferChromaBusAddr = (u32)(decoded->data + decoded->header.stride * decoded->header.h);
+    } else {
+        pp_conf->ppOutImg.pixFormat = purpose_pp_format();
+        pp_conf->ppOutImg.bufferChromaBusAddr = 0;
+    }
+
+    //DCache_CleanInvalidate(pp_conf.ppOutImg.bufferBusAddr, dsc->header.w * dsc->header.h * LV_COLOR_DEPTH / 8);
+    DCache_CleanInvalidate(0xFFFFFFFF, 0xFFFFFFFF); // Clean !!!!
+    if (PPSetConfig(hw_ctx.pp_inst, pp_conf) != PP_OK) {
+        printf("Error: PPSetConfig Failed.\n");
+        hw_context_release();
+        return LV_RESULT_INVALID;
+    }
+
+    display_bandwidth_wait();
+    if (JpegDecDecode(hw_ctx.jpeg_inst, &jpeg_in, &jpeg_out) != JPEGDEC_FRAME_READY) {
+        // Start from a clean instance next time
+        hw_context_release();
+        return LV_RESULT_INVALID;
+    }
+
+    return LV_RESULT_OK;
+}
+
+/* HW first, libjpeg-turbo DCT scaling by scale_num/8 as fallback. crop is only used unscaled */
+static lv_result_t decode_to_buf(const uint8_t *data, uint32_t size, const lv_image_header_t *src_header,
+                                 uint32_t scale_num, const lv_area_t *crop, lv_draw_buf_t *decoded)
+{
+    lv_mutex_lock(&hw_ctx.lock);
+    lv_result_t res = hw_decode(data, size, src_header, crop, decoded);
+    lv_mutex_unlock(&hw_ctx.lock);
+    if (res != LV_RESULT_OK) {
+        // HW decoder unavailable or stream unsupported, use libjpeg-turbo instead
+        res = jpeg_sw_decode(data, size, scale_num, crop, decoded);
     }
 
-#if TIME_DEBUG
-    end = rtos_time_get_current_system_time_ns();
-    time_used = end - start;
-    printf("Get Info used: %lld ns\n", time_used);
-#endif
     return res;
 }
 
-static lv_result_t decoder_open_cb(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc)
+lv_result_t jpeg_decoder_get_header(const uint8_t *data, uint32_t size, lv_image_header_t *header)
 {
-    LV_UNUSED(decoder);
+    jpeg_stream_t stream = {
+        .data = data,
+        .size = size,
+    };
+
+    return parse_jpeg_header(&stream, header);
+}
+
+lv_color_format_t jpeg_decoder_render_format(void)
+{
+    return purpose_lv_format();
+}
+
+lv_result_t jpeg_decoder_decode_into(const uint8_t *data, uint32_t size, lv_draw_buf_t *decoded)
+{
+    lv_image_header_t src_header;
 
+    if (jpeg_decoder_get_header(data, size, &src_header) != LV_RESULT_OK) {
+        return LV_RESULT_INVALID;
+    }
+
+    // Smallest DCT scale covering the buffer, PP scales to the exact size
+    uint32_t num_w = (decoded->header.w * JPEG_SCALE_DENOM + src_header.w - 1) / src_header.w;
+    uint32_t num_h = (decoded->header.h * JPEG_SCALE_DENOM + src_header.h - 1) / src_header.h;
+    uint32_t scale_num = LV_CLAMP(1, LV_MAX(num_w, num_h), JPEG_SCALE_DENOM);
+
+    return decode_to_buf(data, size, &src_header, scale_num, NULL, decoded);
+}
+
+lv_result_t jpeg_decoder_decode_src(lv_image_src_t src_type, const void *src, bool reclaim, lv_draw_buf_t **decoded)
+{
     const uint8_t *jpeg_data_ptr = NULL;
     uint8_t *data = NULL;
     uint32_t jpeg_data_len = 0;
 
-    if (dsc->src_type == LV_IMAGE_SRC_FILE) {
+    *decoded = NULL;
 
-        data = read_file(dsc->src, &jpeg_data_len);
+    if (src_type == LV_IMAGE_SRC_FILE) {
+
+        data = read_file(src, &jpeg_data_len);
         if (data == NULL) {
-            LV_LOG_WARN("can't load file %s", dsc->src);
+            LV_LOG_WARN("can't load file %s", (const char *)src);
             return LV_RESULT_INVALID;
         }
 
         jpeg_data_ptr = data;
         //DCache_Clean((uint32_t)jpeg_data_ptr, jpeg_data_len); // Clean before JpegDecDecode
 
-    } else if (dsc->src_type == LV_IMAGE_SRC_VARIABLE) {
-        const lv_image_dsc_t *img_dsc = dsc->src;
+    } else if (src_type == LV_IMAGE_SRC_VARIABLE) {
+        const lv_image_dsc_t *img_dsc = src;
         jpeg_data_ptr = img_dsc->data;
         jpeg_data_len = img_dsc->data_size;
     } else {
@@ -299,114 +716,228 @@ static lv_result_t decoder_open_cb(lv_image_decoder_t *decoder, lv_image_decoder
 #endif
 
     lv_result_t res = LV_RESULT_INVALID;
+    lv_draw_buf_t *decoded_buf = NULL;
+    lv_image_header_t src_header;
+    lv_image_header_t out_header;
+    jpeg_stream_t stream = {
+        .data = jpeg_data_ptr,
+        .size = jpeg_data_len,
+    };
+
+    if (parse_jpeg_header(&stream, &src_header) != LV_RESULT_OK) {
+        goto end;
+    }
+    uint32_t scale_num = decode_hint_get_scale(src_type, src, &src_header);
+    out_header = src_header;
+    scale_header(&out_header, scale_num);
 
-    JpegDecInst jpeg_inst;
-    PPInst pp_inst;
+    lv_color_format_t out_cf = output_lv_format();
+    if (reclaim) {
+        jpeg_cache_reclaim(output_buf_size(out_header.w, out_header.h, out_cf));
+    }
+    decoded_buf = output_buf_create(out_header.w, out_header.h, out_cf);
 
-    JpegDecInput jpeg_in;
-    JpegDecOutput jpeg_out;
-    PPConfig pp_conf;
+    if (!decoded_buf) {
+        printf("decoded_buf create failed.\n");
+        goto end;
+    }
 
-    memset(&jpeg_in, 0, sizeof(jpeg_in));
-    memset(&jpeg_out, 0, sizeof(jpeg_out));
-    memset(&pp_conf, 0, sizeof(pp_conf));
+    res = decode_to_buf(jpeg_data_ptr, jpeg_data_len, &src_header, scale_num, NULL, decoded_buf);
 
-    jpeg_in.streamBuffer.pVirtualAddress = (u32 *)jpeg_data_ptr;
-    jpeg_in.streamBuffer.busAddress = (u32)jpeg_data_ptr;
-    jpeg_in.streamLength = jpeg_data_len;
+    if (res == LV_RESULT_OK) {
+        *decoded = decoded_buf;
+    }
+end:
+    if (data) {
+        lv_free(data);
+    }
+    if (decoded_buf && (res != LV_RESULT_OK)) {
+        printf("Decode open flow failed and release decoded_buf.\n");
+        lv_draw_buf_destroy(decoded_buf);
+    }
+#if TIME_DEBUG
+    end = rtos_time_get_current_system_time_ns();
+    time_used = end - start;
+    printf("Decode Time used: %lld ns\n", time_used);
+#endif
 
-    if (JpegDecInit(&jpeg_inst) != JPEGDEC_OK) {
-        printf("Error: JpegDecInit Failed.\n");
-        res = LV_RESULT_INVALID;
-        goto end;
+    return res;
+}
+
+static void roi_context_free(roi_context_t *roi)
+{
+    if (roi->decoded) {
+        lv_draw_buf_destroy(roi->decoded);
+    }
+    if (roi->file_data) {
+        lv_free(roi->file_data);
     }
+    lv_free(roi);
+}
 
-    if (PPInit(&pp_inst) != PP_OK) {
-        printf("Error: PPInit Failed.\n");
-        res = LV_RESULT_INVALID;
-        goto end1;
+/* Set up area decoding for large unscaled images, dsc->decoded stays NULL on success */
+static lv_result_t roi_open(lv_image_decoder_dsc_t *dsc)
+{
+    // dsc->header comes from decoder_info_cb, so most images are rejected without any read
+    uint32_t full_size = output_buf_size(dsc->header.w, dsc->header.h, output_lv_format());
+    if (roi_threshold == 0 || full_size <= roi_threshold) {
+        return LV_RESULT_INVALID;
     }
 
-    if (PPDecCombinedModeEnable(pp_inst, jpeg_inst, PP_PIPELINED_DEC_TYPE_JPEG) != PP_OK) {
-        printf("Error: PPDecCombinedModeEnable Failed.\n");
-        res = LV_RESULT_INVALID;
-        goto end2;
+    roi_context_t *roi = lv_malloc_zeroed(sizeof(roi_context_t));
+    if (!roi) {
+        return LV_RESULT_INVALID;
     }
 
-    if (PPGetConfig(pp_inst, &pp_conf) != PP_OK) {
-        printf("Error: PPGetConfig Failed.\n");
-        goto end3;
+    if (dsc->src_type == LV_IMAGE_SRC_FILE) {
+        roi->file_data = read_file(dsc->src, &roi->size);
+        roi->data = roi->file_data;
+    } else {
+        const lv_image_dsc_t *img_dsc = dsc->src;
+        roi->data = img_dsc->data;
+        roi->size = img_dsc->data_size;
     }
 
-    pp_conf.ppInImg.width = dsc->header.w;
-    pp_conf.ppInImg.height = dsc->header.h;
-    /* Jessica */
-    pp_conf.ppInImg.videoRange = 1;
-    pp_conf.ppOutRgb.rgbTransform = PP_YCBCR2RGB_TRANSFORM_BT_709;
+    jpeg_stream_t stream = {
+        .data = roi->data,
+        .size = roi->size,
+    };
+    // Scaled decodes are small enough, and PP crop is done on source pixels
+    if (!roi->data || parse_jpeg_header(&stream, &roi->src_header) != LV_RESULT_OK ||
+        roi->src_header.w != dsc->header.w || roi->src_header.h != dsc->header.h) {
+        roi_context_free(roi);
+        return LV_RESULT_INVALID;
+    }
 
-    pp_conf.ppInImg.pixFormat = trans_format_sw2hw(dsc->header.cf);
-    pp_conf.ppOutImg.width = dsc->header.w;
-    pp_conf.ppOutImg.height = dsc->header.h;
+    dsc->header.cf = purpose_lv_format();
+    dsc->user_data = roi;
+    return LV_RESULT_OK;
+}
 
-    pp_conf.ppOutImg.pixFormat = purpose_pp_format();
+/*
+ * The requested area is decoded at once, widened to MCU boundaries. LVGL calls
+ * again with the returned area and gets LV_RESULT_INVALID to end the loop.
+ */
+static lv_result_t decoder_get_area_cb(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc,
+                                       const lv_area_t *full_area, lv_area_t *decoded_area)
+{
+    LV_UNUSED(decoder);
 
-    lv_draw_buf_t *decoded_buf = NULL;
-    uint32_t stride = lv_draw_buf_width_to_stride(dsc->header.w, purpose_lv_format());
-    decoded_buf = lv_draw_buf_create(dsc->header.w, dsc->header.h, purpose_lv_format(), stride);
+    roi_context_t *roi = dsc->user_data;
+    if (!roi || decoded_area->y1 != LV_COORD_MIN) {
+        return LV_RESULT_INVALID;
+    }
 
-    if (!decoded_buf) {
-        printf("decoded_buf create failed.\n");
-        goto end3;
+    lv_area_t area;
+    area.x1 = LV_MAX(full_area->x1, 0) & ~(JPEG_ROI_ALIGN - 1);
+    area.y1 = LV_MAX(full_area->y1, 0) & ~(JPEG_ROI_ALIGN - 1);
+    area.x2 = LV_MIN((full_area->x2 + JPEG_ROI_ALIGN) & ~(JPEG_ROI_ALIGN - 1), (int32_t)dsc->header.w) - 1;
+    area.y2 = LV_MIN((full_area->y2 + JPEG_ROI_ALIGN) & ~(JPEG_ROI_ALIGN - 1), (int32_t)dsc->header.h) - 1;
+    if (area.x2 < area.x1 || area.y2 < area.y1) {
+        return LV_RESULT_INVALID;
     }
-    pp_conf.ppOutImg.bufferBusAddr = (u32)decoded_buf->data;
 
-    //DCache_CleanInvalidate(pp_conf.ppOutImg.bufferBusAddr, dsc->header.w * dsc->header.h * LV_COLOR_DEPTH / 8);
-    DCache_CleanInvalidate(0xFFFFFFFF, 0xFFFFFFFF); // Clean !!!!
-    if (PPSetConfig(pp_inst, &pp_conf) != PP_OK) {
-        printf("Error: PPSetConfig Failed.\n");
-        goto end3;
+    uint32_t w = lv_area_get_width(&area);
+    uint32_t h = lv_area_get_height(&area);
+    if (roi->decoded && (roi->decoded->header.w != w || roi->decoded->header.h != h)) {
+        lv_draw_buf_destroy(roi->decoded);
+        roi->decoded = NULL;
+    }
+    if (!roi->decoded) {
+        roi->decoded = lv_draw_buf_create(w, h, purpose_lv_format(), lv_draw_buf_width_to_stride(w, purpose_lv_format()));
+        if (!roi->decoded) {
+            return LV_RESULT_INVALID;
+        }
     }
 
-    if (JpegDecDecode(jpeg_inst, &jpeg_in, &jpeg_out) == JPEGDEC_FRAME_READY) {
-        dsc->header.cf = purpose_lv_format(); // Format changed after PP process
-        dsc->decoded = decoded_buf;
-        res = LV_RESULT_OK;
+#if TIME_DEBUG
+    uint64_t start = rtos_time_get_current_system_time_ns();
+#endif
+    if (decode_to_buf(roi->data, roi->size, &roi->src_header, JPEG_SCALE_DENOM, &area, roi->decoded) != LV_RESULT_OK) {
+        return LV_RESULT_INVALID;
     }
-end3:
-    if (pp_inst) {
-        PPDecCombinedModeDisable(pp_inst, jpeg_inst);
+#if TIME_DEBUG
+    printf("Decode area (%ld,%ld %lux%lu) used: %lld ns\n", area.x1, area.y1, w, h,
+           rtos_time_get_current_system_time_ns() - start);
+#endif
+
+    dsc->decoded = roi->decoded;
+    *decoded_area = area;
+    return LV_RESULT_OK;
+}
+
+static lv_result_t decoder_open_cb(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc)
+{
+    if (dsc->src_type != LV_IMAGE_SRC_FILE && dsc->src_type != LV_IMAGE_SRC_VARIABLE) {
+        return LV_RESULT_INVALID;
     }
-end2:
-    if (pp_inst) {
-        PPRelease(pp_inst);
+
+    // LVGL image cache takes precedence when enabled, otherwise keep decodes in jpeg cache
+    bool use_lv_cache = !dsc->args.no_cache && lv_image_cache_is_enabled();
+    bool use_jpeg_cache = !dsc->args.no_cache && !use_lv_cache;
+
+    if (use_jpeg_cache) {
+        lv_draw_buf_t *cached = jpeg_cache_acquire(dsc->src_type, dsc->src);
+        if (cached) {
+            dsc->header.cf = cached->header.cf;
+            dsc->decoded = cached;
+            return LV_RESULT_OK;
+        }
     }
-end1:
-    if (jpeg_inst) {
-        JpegDecRelease(jpeg_inst);
+
+    if (roi_open(dsc) == LV_RESULT_OK) {
+        return LV_RESULT_OK;
     }
-end:
-    if (data) {
-        lv_free(data);
+
+    lv_draw_buf_t *decoded_buf = NULL;
+    lv_result_t res = jpeg_decoder_decode_src(dsc->src_type, dsc->src, use_jpeg_cache, &decoded_buf);
+    if (res != LV_RESULT_OK) {
+        return res;
     }
-    if (decoded_buf && (res != LV_RESULT_OK)) {
-        printf("Decode open flow failed and release decoded_buf.\n");
-        lv_draw_buf_destroy(decoded_buf);
+
+    dsc->header.cf = decoded_buf->header.cf; // Format changed after PP process
+    dsc->decoded = decoded_buf;
+
+    if (use_lv_cache) {
+        lv_image_cache_data_t search_key;
+        search_key.src_type = dsc->src_type;
+        search_key.src = dsc->src;
+        search_key.slot.size = decoded_buf->data_size;
+
+        lv_cache_entry_t *entry = lv_image_decoder_add_to_cache(decoder, &search_key, decoded_buf, NULL);
+        if (entry == NULL) {
+            dsc->decoded = NULL;
+            lv_draw_buf_destroy(decoded_buf);
+            return LV_RESULT_INVALID;
+        }
+        dsc->cache_entry = entry;
+    } else if (use_jpeg_cache) {
+        // Not cached (e.g. larger than the budget) is fine, close_cb will destroy it
+        jpeg_cache_insert(dsc->src_type, dsc->src, decoded_buf);
     }
-#if TIME_DEBUG
-    end = rtos_time_get_current_system_time_ns();
-    time_used = end - start;
-    printf("Decode Time used: %lld ns\n", time_used);
-#endif
 
-    return res;
+    return LV_RESULT_OK;
 }
 
 static void decoder_close_cb(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc)
 {
     LV_UNUSED(decoder);
 
-    if (dsc->decoded) {
-        lv_draw_buf_destroy((lv_draw_buf_t *)dsc->decoded);
+    if (dsc->user_data) {
+        // Area decoding, the buffer belongs to the context
+        roi_context_free(dsc->user_data);
+        dsc->user_data = NULL;
+        dsc->decoded = NULL;
+        return;
+    }
+
+    if (!dsc->decoded) {
+        return;
+    }
+
+    // Buffers in LVGL image cache are released by the cache itself
+    if (dsc->args.no_cache || !lv_image_cache_is_enabled()) {
+        jpeg_cache_release((lv_draw_buf_t *)dsc->decoded);
     }
 }
 
@@ -414,13 +945,111 @@ void lv_ameba_jpeg_init(void) {
     lv_image_decoder_t *dec = lv_image_decoder_create();
     lv_image_decoder_set_info_cb(dec, decoder_info_cb);
     lv_image_decoder_set_open_cb(dec, decoder_open_cb);
+    lv_image_decoder_set_get_area_cb(dec, decoder_get_area_cb);
     lv_image_decoder_set_close_cb(dec, decoder_close_cb);
     dec->name = DECODER_NAME;
+    jpeg_decoder = dec;
 
     RCC_PeriphClockCmd(APBPeriph_MJPEG, APBPeriph_MJPEG_CLOCK, ENABLE);
     hx170dec_init();
+
+    for (int i = 0; i < JPEG_DECODE_HINT_MAX; i++) {
+        decode_hints[i].src_type = LV_IMAGE_SRC_UNKNOWN;
+    }
+    lv_mutex_init(&decode_hint_lock);
+    memset(&hw_ctx, 0, sizeof(hw_ctx));
+    lv_mutex_init(&hw_ctx.lock);
+    jpeg_cache_init(JPEG_CACHE_DEF_SIZE);
+    jpeg_async_init();
 }
 
 void lv_ameba_jpeg_deinit(void) {
-    // TODO
+    if (jpeg_decoder) {
+        lv_image_decoder_delete(jpeg_decoder);
+        jpeg_decoder = NULL;
+    }
+
+    jpeg_async_deinit();
+    jpeg_cache_deinit();
+
+    lv_mutex_lock(&hw_ctx.lock);
+    hw_context_release();
+    lv_mutex_unlock(&hw_ctx.lock);
+    lv_mutex_delete(&hw_ctx.lock);
+
+    lv_mutex_delete(&decode_hint_lock);
+    for (int i = 0; i < JPEG_DECODE_HINT_MAX; i++) {
+        if (decode_hints[i].path) {
+            lv_free(decode_hints[i].path);
+        }
+    }
+    memset(decode_hints, 0, sizeof(decode_hints));
+
+    RCC_PeriphClockCmd(APBPeriph_MJPEG, APBPeriph_MJPEG_CLOCK, DISABLE);
+}
+
+void lv_ameba_jpeg_set_output_yuv(bool enable) {
+    if (output_yuv == enable) {
+        return;
+    }
+    output_yuv = enable;
+
+    // Cached headers and decodes carry the previous format
+    lv_image_header_cache_drop(NULL);
+    lv_image_cache_drop(NULL);
+    jpeg_cache_drop(NULL);
+}
+
+void lv_ameba_jpeg_set_roi_threshold(uint32_t size) {
+    roi_threshold = size;
+}
+
+void lv_ameba_jpeg_cache_set_size(uint32_t max_size) {
+    jpeg_cache_set_size(max_size);
+}
+
+void lv_ameba_jpeg_cache_drop(const void *src) {
+    jpeg_cache_drop(src);
+}
+
+void lv_ameba_jpeg_cache_get_stats(lv_ameba_jpeg_cache_stats_t *stats) {
+    jpeg_cache_get_stats(stats);
+}
+
+void lv_ameba_jpeg_set_decode_scale(const void *src, uint32_t scale) {
+    decode_hint_set(src, scale >= LV_SCALE_NONE ? 0 : scale, 0, 0);
+}
+
+void lv_ameba_jpeg_set_decode_size(const void *src, uint32_t max_w, uint32_t max_h) {
+    decode_hint_set(src, 0, max_w, max_h);
+}
+
+void lv_ameba_jpeg_image_apply_scale(lv_obj_t *img) {
+    const void *src = lv_image_get_src(img);
+    int32_t scale = lv_image_get_scale(img);
+    int32_t old_w = lv_image_get_src_width(img);
+
+    if (!src || scale >= LV_SCALE_NONE || old_w <= 0) {
+        return;
+    }
+
+    // lv_image owns a file path copy which set_src frees, keep our own
+    char *path = NULL;
+    if (lv_image_src_get_type(src) == LV_IMAGE_SRC_FILE) {
+        path = lv_strdup(src);
+        src = path;
+    }
+
+    lv_ameba_jpeg_set_decode_scale(src, scale);
+    lv_image_set_src(img, src);
+
+    // Decode scale is rounded up to 1/8 steps, let LVGL apply the remainder
+    int32_t new_w = lv_image_get_src_width(img);
+    if (new_w > 0) {
+        lv_image_set_scale(img, LV_MIN(scale * old_w / new_w, LV_SCALE_NONE));
+    }
+
+    if (path) {
+        lv_free(path);
+    }
 }
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_UI_LVGL_LV_DRIVERS_JPEG_DECODER_PRIVATE
+#define AMEBA_UI_LVGL_LV_DRIVERS_JPEG_DECODER_PRIVATE
+
+#include <stdbool.h>
+
+#include "lvgl.h"
+
+/*
+ * Load and decode src (path or lv_image_dsc_t) into a new draw buffer, HW first
+ * and libjpeg-turbo as fallback. Thread safe, may be called outside the LVGL thread.
+ * reclaim: evict unused jpeg cache entries before allocating the output.
+ */
+lv_result_t jpeg_decoder_decode_src(lv_image_src_t src_type, const void *src, bool reclaim, lv_draw_buf_t **decoded);
+
+/*
+ * Decode one JPEG stream into an existing buffer (RGB565, XRGB8888 or NV12), scaled
+ * to the buffer size. Thread safe, used for streams that reuse their output buffers.
+ */
+lv_result_t jpeg_decoder_decode_into(const uint8_t *data, uint32_t size, lv_draw_buf_t *decoded);
+
+/* Source size (MCU aligned) and sampling format from the SOF marker */
+lv_result_t jpeg_decoder_get_header(const uint8_t *data, uint32_t size, lv_image_header_t *header);
+
+/* RGB format matching LV_COLOR_DEPTH that HW decodes can be drawn from */
+lv_color_format_t jpeg_decoder_render_format(void);
+
+void jpeg_async_init(void);
+void jpeg_async_deinit(void);
+
+#endif // AMEBA_UI_LVGL_LV_DRIVERS_JPEG_DECODER_PRIVATE
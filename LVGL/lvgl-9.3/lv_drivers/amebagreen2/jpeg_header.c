@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "jpeg_header.h"
+
+#define JPEG_HEADER_MAX_SEGMENTS    64
+#define JPEG_SOF_READ_LEN           (6 + 3 * 4)
+
+typedef struct {
+    const uint8_t *data;
+    uint32_t size;
+} mem_stream_t;
+
+static bool mem_read(void *user_data, uint32_t offset, uint8_t *buf, uint32_t len)
+{
+    mem_stream_t *stream = user_data;
+
+    if (offset > stream->size || len > stream->size - offset) {
+        return false;
+    }
+    memcpy(buf, stream->data + offset, len);
+    return true;
+}
+
+/* Luma against chroma factors, -1 for layouts the decoders don't take */
+static int sampling_from_factors(uint8_t y_sampling, uint8_t c_sampling)
+{
+    uint8_t ch = c_sampling >> 4;
+    uint8_t cv = c_sampling & 0x0F;
+    uint8_t h = (y_sampling >> 4) / (ch ? ch : 1);
+    uint8_t v = (y_sampling & 0x0F) / (cv ? cv : 1);
+
+    if (h == 2 && v == 2) return JPEG_SAMPLING_420;
+    if (h == 2 && v == 1) return JPEG_SAMPLING_422;
+    if (h == 1 && v == 2) return JPEG_SAMPLING_440;
+    if (h == 4 && v == 1) return JPEG_SAMPLING_411;
+    if (h == 1 && v == 1) return JPEG_SAMPLING_444;
+
+    return -1;
+}
+
+int jpeg_header_parse(jpeg_header_read_cb_t read, void *user_data, jpeg_header_t *header)
+{
+    uint8_t buf[JPEG_SOF_READ_LEN];
+    uint32_t offset = 2;
+
+    if (!read(user_data, 0, buf, 2) || buf[0] != 0xFF || buf[1] != 0xD8) {
+        return -1;
+    }
+
+    for (int i = 0; i < JPEG_HEADER_MAX_SEGMENTS; i++) {
+        if (!read(user_data, offset, buf, 4) || buf[0] != 0xFF) {
+            return -1;
+        }
+
+        uint8_t marker = buf[1];
+        if (marker == 0xFF) {
+            offset++;  // fill byte
+            continue;
+        }
+        if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)) {
+            offset += 2;  // standalone marker
+            continue;
+        }
+        if (marker == 0xD9 || marker == 0xDA) {
+            return -1;  // EOI or SOS before SOF
+        }
+
+        uint32_t seg_len = (buf[2] << 8) | buf[3];
+        if (seg_len < 2) {
+            return -1;
+        }
+
+        // Baseline, extended and progressive huffman SOF are handled by the decoders
+        if (marker >= 0xC0 && marker <= 0xC2) {
+            uint32_t read_len = seg_len - 2 < sizeof(buf) ? seg_len - 2 : sizeof(buf);
+            if (read_len < 6 || !read(user_data, offset + 4, buf, read_len)) {
+                return -1;
+            }
+
+            uint32_t height = (buf[1] << 8) | buf[2];
+            uint32_t width = (buf[3] << 8) | buf[4];
+            uint8_t components = buf[5];
+            int sampling = -1;
+
+            if (components == 1) {
+                sampling = JPEG_SAMPLING_400;
+            } else if (components == 3 && read_len >= 6 + 3 * 3) {
+                sampling = sampling_from_factors(buf[7], buf[10]);
+            }
+
+            if (buf[0] != 8 || width == 0 || height == 0 || sampling < 0) {
+                return -1;
+            }
+
+            header->width = width;
+            header->height = height;
+            header->sampling = sampling;
+            header->progressive = marker == 0xC2;
+            return 0;
+        }
+
+        if (marker >= 0xC3 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) {
+            return -1;  // lossless/arithmetic coding is not supported
+        }
+
+        offset += 2 + seg_len;
+    }
+
+    return -1;
+}
+
+int jpeg_header_parse_mem(const uint8_t *data, uint32_t size, jpeg_header_t *header)
+{
+    mem_stream_t stream = {
+        .data = data,
+        .size = size,
+    };
+
+    return jpeg_header_parse(mem_read, &stream, header);
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_UI_LVGL_LV_DRIVERS_JPEG_HEADER
+#define AMEBA_UI_LVGL_LV_DRIVERS_JPEG_HEADER
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * JPEG size and sampling from the SOF marker, without reading the entropy-coded data.
+ * Free of SDK and LVGL headers so it builds on a host.
+ */
+
+typedef enum {
+    JPEG_SAMPLING_400,          // grayscale
+    JPEG_SAMPLING_420,
+    JPEG_SAMPLING_422,
+    JPEG_SAMPLING_440,
+    JPEG_SAMPLING_411,
+    JPEG_SAMPLING_444,
+} jpeg_sampling_t;
+
+typedef struct {
+    uint16_t width;             // as coded, not MCU aligned
+    uint16_t height;
+    uint8_t sampling;           // jpeg_sampling_t
+    bool progressive;
+} jpeg_header_t;
+
+/* Read len bytes at offset of the stream, false if it is shorter */
+typedef bool (*jpeg_header_read_cb_t)(void *user_data, uint32_t offset, uint8_t *buf, uint32_t len);
+
+/*
+ * Walk the marker segments up to the first SOF, segment payloads (EXIF, ICC, ...) are
+ * skipped by their length. 0 on success, -1 if the stream is not a JPEG the decoders
+ * handle (8-bit huffman baseline, extended or progressive) or ends before the SOF.
+ */
+int jpeg_header_parse(jpeg_header_read_cb_t read, void *user_data, jpeg_header_t *header);
+int jpeg_header_parse_mem(const uint8_t *data, uint32_t size, jpeg_header_t *header);
+
+#endif // AMEBA_UI_LVGL_LV_DRIVERS_JPEG_HEADER
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <setjmp.h>
+
+#include "jpeg_sw_decoder.h"
+
+#if LV_USE_LIBJPEG_TURBO
+
+#include "jpeglib.h"
+
+#define LOG_TAG "JPEG-SW"
+
+typedef struct {
+    struct jpeg_error_mgr pub;
+    jmp_buf jb;
+} sw_error_mgr_t;
+
+static void sw_error_exit(j_common_ptr cinfo)
+{
+    sw_error_mgr_t *err = (sw_error_mgr_t *)cinfo->err;
+    char msg[JMSG_LENGTH_MAX];
+
+    (*cinfo->err->format_message)(cinfo, msg);
+    printf("%s: %s\n", LOG_TAG, msg);
+    longjmp(err->jb, 1);
+}
+
+static bool sw_out_color_space(lv_color_format_t cf, J_COLOR_SPACE *space)
+{
+    switch (cf) {
+    case LV_COLOR_FORMAT_RGB565:
+        *space = JCS_RGB565;
+        return true;
+    case LV_COLOR_FORMAT_XRGB8888:
+    case LV_COLOR_FORMAT_ARGB8888:
+        // LVGL 32-bit formats are B,G,R,X in memory
+        *space = JCS_EXT_BGRX;
+        return true;
+    case LV_COLOR_FORMAT_NV12:
+        *space = JCS_YCbCr;
+        return true;
+    default:
+        return false;
+    }
+}
+
+/* Y of every pixel, CbCr of the top-left pixel of each 2x2 block */
+static void sw_store_nv12_row(lv_draw_buf_t *decoded, uint32_t row, const uint8_t *ycc, uint32_t w)
+{
+    uint32_t stride = decoded->header.stride;
+    uint8_t *y = decoded->data + row * stride;
+
+    for (uint32_t x = 0; x < w; x++) {
+        y[x] = ycc[x * 3];
+    }
+
+    if (row & 1) {
+        return;
+    }
+
+    uint8_t *uv = decoded->data + stride * decoded->header.h + (row / 2) * stride;
+    for (uint32_t x = 0; x + 1 < w; x += 2) {
+        uv[x] = ycc[x * 3 + 1];
+        uv[x + 1] = ycc[x * 3 + 2];
+    }
+}
+
+lv_result_t jpeg_sw_decode(const uint8_t *data, uint32_t size, uint32_t scale_num, const lv_area_t *crop,
+                           lv_draw_buf_t *decoded)
+{
+    struct jpeg_decompress_struct cinfo;
+    sw_error_mgr_t jerr;
+    J_COLOR_SPACE out_space;
+
+    if (!sw_out_color_space(decoded->header.cf, &out_space)) {
+        return LV_RESULT_INVALID;
+    }
+
+    cinfo.err = jpeg_std_error(&jerr.pub);
+    jerr.pub.error_exit = sw_error_exit;
+    if (setjmp(jerr.jb)) {
+        jpeg_destroy_decompress(&cinfo);
+        return LV_RESULT_INVALID;
+    }
+
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, (unsigned char *)data, size);
+
+    if (jpeg_read_header(&cinfo, TRUE) != JPEG_HEADER_OK) {
+        jpeg_destroy_decompress(&cinfo);
+        return LV_RESULT_INVALID;
+    }
+
+    cinfo.out_color_space = out_space;
+    cinfo.scale_num = LV_CLAMP(1, scale_num, 8);
+    cinfo.scale_denom = 8;
+    jpeg_start_decompress(&cinfo);
+
+    uint32_t first_row = 0;
+    uint32_t x_skip = 0;
+    if (crop) {
+        JDIMENSION x_off = crop->x1;
+        JDIMENSION crop_w = lv_area_get_width(crop);
+        if ((uint32_t)crop->x1 >= cinfo.output_width || (uint32_t)crop->y1 >= cinfo.output_height) {
+            // Only the MCU padding of the header size is requested
+            jpeg_abort_decompress(&cinfo);
+            jpeg_destroy_decompress(&cinfo);
+            return LV_RESULT_OK;
+        }
+
+        // Widened to iMCU boundaries by libjpeg-turbo, output_width becomes crop_w
+        crop_w = LV_MIN(crop_w, cinfo.output_width - x_off);
+        jpeg_crop_scanline(&cinfo, &x_off, &crop_w);
+        x_skip = crop->x1 - x_off;
+        first_row = crop->y1;
+        jpeg_skip_scanlines(&cinfo, first_row);
+    }
+
+    bool nv12 = decoded->header.cf == LV_COLOR_FORMAT_NV12;
+    uint32_t px_size = nv12 ? 3 : lv_color_format_get_size(decoded->header.cf);
+    uint32_t out_w = LV_MIN(cinfo.output_width - x_skip, decoded->header.w);
+    uint32_t rows = LV_MIN(cinfo.output_height, first_row + decoded->header.h);
+    JSAMPARRAY line = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE,
+                                                 cinfo.output_width * px_size, 1);
+
+    while (cinfo.output_scanline < rows) {
+        uint32_t row = cinfo.output_scanline - first_row;
+        jpeg_read_scanlines(&cinfo, line, 1);
+        if (nv12) {
+            sw_store_nv12_row(decoded, row, line[0] + x_skip * 3, out_w);
+        } else {
+            memcpy(decoded->data + row * decoded->header.stride, line[0] + x_skip * px_size, out_w * px_size);
+        }
+    }
+
+    if (cinfo.output_scanline < cinfo.output_height) {
+        jpeg_abort_decompress(&cinfo);
+    } else {
+        jpeg_finish_decompress(&cinfo);
+    }
+    jpeg_destroy_decompress(&cinfo);
+
+    lv_draw_buf_flush_cache(decoded, NULL);
+
+    return LV_RESULT_OK;
+}
+
+#else
+
+lv_result_t jpeg_sw_decode(const uint8_t *data, uint32_t size, uint32_t scale_num, const lv_area_t *crop,
+                           lv_draw_buf_t *decoded)
+{
+    LV_UNUSED(data);
+    LV_UNUSED(size);
+    LV_UNUSED(scale_num);
+    LV_UNUSED(crop);
+    LV_UNUSED(decoded);
+    return LV_RESULT_INVALID;
+}
+
+#endif /* LV_USE_LIBJPEG_TURBO */
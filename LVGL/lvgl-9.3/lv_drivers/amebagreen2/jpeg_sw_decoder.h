@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_UI_LVGL_LV_DRIVERS_JPEG_SW_DECODER
+#define AMEBA_UI_LVGL_LV_DRIVERS_JPEG_SW_DECODER
+
+#include <stdint.h>
+
+#include "lvgl.h"
+
+/*
+ * Decode a JPEG stream with libjpeg-turbo into decoded (RGB565, XRGB8888 or NV12).
+ * scale_num selects DCT scaling of scale_num/8 (1..8). If crop is set, only that
+ * area of the scaled image is decoded into decoded, rows above it are skipped
+ * without full decoding. Output that does not fit into decoded is clipped, the
+ * remaining area is left untouched.
+ */
+lv_result_t jpeg_sw_decode(const uint8_t *data, uint32_t size, uint32_t scale_num, const lv_area_t *crop,
+                           lv_draw_buf_t *decoded);
+
+#endif // AMEBA_UI_LVGL_LV_DRIVERS_JPEG_SW_DECODER
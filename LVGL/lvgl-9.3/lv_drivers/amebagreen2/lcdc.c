@@ -20,6 +20,8 @@
 
 #define LOG_TAG "lcdc"
 
+#define LCDC_DEF_FLIP_LINE(height)  ((height) * 5 / 6)
+
 typedef struct {
     lcdc_event_t callback;
     void *user_data;
@@ -29,6 +31,17 @@ typedef struct {
     bool refresh_pending;
     bool initialized;
     bool lcdc_enabled;
+    uint32_t flip_line;
+
+    // vsync timing, written by the irq handler
+    volatile uint64_t frame_done_ns;
+    volatile uint64_t line_ns;
+    volatile uint32_t frame_period_ns;
+    volatile uint32_t frame_count;
+
+    volatile uint32_t underflow_count;
+    volatile uint64_t underflow_ns;
+    uint8_t burst_size;
 } lcdc_context_t;
 
 static lcdc_context_t lcdc_context = {0};
@@ -124,10 +137,28 @@ static void lcdc_irq_handler(void) {
 
     if (int_status & LCDC_BIT_LCD_FRD_INTS) {
         RTK_LOGS(LOG_TAG, RTK_LOG_DEBUG, "irq: frame done\n");
+
+        uint64_t now = rtos_time_get_current_system_time_ns();
+        if (lcdc_context.frame_done_ns) {
+            uint32_t interval = (uint32_t)(now - lcdc_context.frame_done_ns);
+            // average over ~8 frames, the first interval seeds it
+            if (lcdc_context.frame_period_ns) {
+                lcdc_context.frame_period_ns = (lcdc_context.frame_period_ns * 7 + interval) / 8;
+            } else {
+                lcdc_context.frame_period_ns = interval;
+            }
+        }
+        lcdc_context.frame_done_ns = now;
+        lcdc_context.frame_count++;
+
+        if (lcdc_context.callback.frame_done_handler) {
+            lcdc_context.callback.frame_done_handler(lcdc_context.user_data);
+        }
     }
 
     if (int_status & LCDC_BIT_LCD_LIN_INTS) {
         RTK_LOGS(LOG_TAG, RTK_LOG_DEBUG, "irq: line hit\n");
+        lcdc_context.line_ns = rtos_time_get_current_system_time_ns();
 
         if (lcdc_context.callback.vblank_handler) {
             lcdc_context.callback.vblank_handler(lcdc_context.user_data);
@@ -136,6 +167,12 @@ static void lcdc_irq_handler(void) {
 
     if (int_status & LCDC_BIT_DMA_UN_INTS) {
         RTK_LOGS(LOG_TAG, RTK_LOG_ERROR, "irq: dma underflow\n");
+
+        lcdc_context.underflow_count++;
+        lcdc_context.underflow_ns = rtos_time_get_current_system_time_ns();
+        if (lcdc_context.callback.underflow_handler) {
+            lcdc_context.callback.underflow_handler(lcdc_context.user_data);
+        }
     }
 }
 
@@ -183,7 +220,10 @@ static bool lcdc_controller_init(const lcd_timing_t *timing) {
     rgb_init.Panel_Init.RGBRefreshFreq = timing->clock_frequency;
 
     LCDC_RGBInit(LCDC, &rgb_init);
-    LCDC_DMABurstSizeConfig(LCDC, 2);
+    if (!lcdc_context.burst_size) {
+        lcdc_context.burst_size = LCDC_DMA_BURST_DEF;
+    }
+    LCDC_DMABurstSizeConfig(LCDC, lcdc_context.burst_size);
 
     return true;
 }
@@ -222,8 +262,8 @@ bool lcdc_init(lcd_format_t format, const lcd_timing_t *timing) {
     InterruptEn(lcdc_irq_info.irq_num, lcdc_irq_info.irq_priority);
 
     // enable interrupt
-    int line_intr_position = timing->height * 5 / 6;  // line interrupt position
-    LCDC_LineINTPosConfig(LCDC, line_intr_position);
+    lcdc_context.flip_line = LCDC_DEF_FLIP_LINE(timing->height);
+    LCDC_LineINTPosConfig(LCDC, lcdc_context.flip_line);
     LCDC_INTConfig(LCDC, LCDC_BIT_LCD_FRD_INTEN | LCDC_BIT_DMA_UN_INTEN | 
                    LCDC_BIT_LCD_LIN_INTEN, ENABLE);
 
@@ -295,9 +335,15 @@ bool lcdc_set_timing(const lcd_timing_t *timing) {
     LCDC_Cmd(LCDC, DISABLE);
     bool success = lcdc_controller_init(timing);
     
-    // reset line interrupt position
-    int line_intr_position = timing->height * 5 / 6;
-    LCDC_LineINTPosConfig(LCDC, line_intr_position);
+    // keep a configured flip line if it still fits
+    if (lcdc_context.flip_line >= timing->height) {
+        lcdc_context.flip_line = LCDC_DEF_FLIP_LINE(timing->height);
+    }
+    LCDC_LineINTPosConfig(LCDC, lcdc_context.flip_line);
+
+    // period changes with the timing, measure again
+    lcdc_context.frame_done_ns = 0;
+    lcdc_context.frame_period_ns = 0;
     
     LCDC_Cmd(LCDC, ENABLE);
     
@@ -324,6 +370,73 @@ void lcdc_page_flip(uint8_t *buffer) {
     }
 }
 
+bool lcdc_set_flip_line(uint32_t line) {
+    if (!lcdc_context.initialized || line >= lcdc_context.timing.height) {
+        RTK_LOGS(LOG_TAG, RTK_LOG_ERROR, "Invalid flip line %d\n", line);
+        return false;
+    }
+
+    lcdc_context.flip_line = line;
+    LCDC_LineINTPosConfig(LCDC, line);
+
+    return true;
+}
+
+uint32_t lcdc_get_flip_line(void) {
+    return lcdc_context.flip_line;
+}
+
+/* The 64-bit fields written by the irq handler are two loads on this core, read again
+ * if a frame done or underflow irq came in between */
+static uint64_t lcdc_read_u64(volatile uint64_t *v) {
+    uint64_t a, b;
+
+    do {
+        a = *v;
+        b = *v;
+    } while (a != b);
+
+    return a;
+}
+
+void lcdc_get_vsync_info(lcdc_vsync_info_t *info) {
+    uint32_t count;
+
+    do {
+        count = lcdc_context.frame_count;
+        info->frame_period_ns = lcdc_context.frame_period_ns;
+        info->frame_done_ns = lcdc_context.frame_done_ns;
+    } while (count != lcdc_context.frame_count);
+
+    info->frame_count = count;
+    info->line_ns = lcdc_read_u64(&lcdc_context.line_ns);
+}
+
+void lcdc_get_underflow_info(lcdc_underflow_info_t *info) {
+    uint32_t count;
+
+    do {
+        count = lcdc_context.underflow_count;
+        info->last_ns = lcdc_context.underflow_ns;
+    } while (count != lcdc_context.underflow_count);
+
+    info->count = count;
+    info->burst_size = lcdc_context.burst_size;
+}
+
+bool lcdc_set_dma_burst_size(uint8_t burst_size) {
+    if (!lcdc_context.initialized || burst_size < 1 || burst_size > LCDC_DMA_BURST_MAX) {
+        return false;
+    }
+
+    lcdc_context.burst_size = burst_size;
+    LCDC_DMABurstSizeConfig(LCDC, burst_size);
+
+    RTK_LOGS(LOG_TAG, RTK_LOG_INFO, "DMA burst size %d\n", burst_size);
+
+    return true;
+}
+
 void lcdc_register_event_callback(lcdc_event_t *callback, void *user_data) {
     lcdc_context.callback = *callback;
     lcdc_context.user_data = user_data;
@@ -38,10 +38,29 @@ typedef struct {
 } lcd_timing_t;
 
 typedef struct {
-    void (*vblank_handler)(void *user_data);
+    void (*vblank_handler)(void *user_data);       // flip line interrupt
     void (*page_flip_handler)(void *user_data);
+    void (*frame_done_handler)(void *user_data);   // end of scan-out, shadow registers latch after it
+    void (*underflow_handler)(void *user_data);    // scan-out DMA could not fetch in time
 } lcdc_event_t;
 
+#define LCDC_DMA_BURST_DEF  2
+#define LCDC_DMA_BURST_MAX  4
+
+typedef struct {
+    uint32_t count;             // since lcdc_init
+    uint64_t last_ns;           // last underflow interrupt, 0 for none
+    uint8_t burst_size;         // current DMA burst size
+} lcdc_underflow_info_t;
+
+// Interrupt timestamps from rtos_time_get_current_system_time_ns, 0 until the LCDC runs
+typedef struct {
+    uint64_t frame_done_ns;     // last frame done interrupt
+    uint64_t line_ns;           // last flip line interrupt
+    uint32_t frame_period_ns;   // measured between frame done interrupts, averaged
+    uint32_t frame_count;
+} lcdc_vsync_info_t;
+
 bool lcdc_init(lcd_format_t format, const lcd_timing_t *timing);
 bool lcdc_init_default(lcd_format_t format, uint32_t width, uint32_t height);
 void lcdc_deinit(void);
@@ -50,6 +69,16 @@ void lcdc_get_resolution(uint32_t *width, uint32_t *height);
 bool lcdc_set_timing(const lcd_timing_t *timing);
 
 void lcdc_page_flip(uint8_t *buffer);
+
+// Line the vblank_handler interrupt fires on, default height * 5 / 6
+bool lcdc_set_flip_line(uint32_t line);
+uint32_t lcdc_get_flip_line(void);
+void lcdc_get_vsync_info(lcdc_vsync_info_t *info);
+
+void lcdc_get_underflow_info(lcdc_underflow_info_t *info);
+// Longer bursts need fewer PSRAM arbitrations per line, 1 ~ LCDC_DMA_BURST_MAX
+bool lcdc_set_dma_burst_size(uint8_t burst_size);
+
 void lcdc_register_event_callback(lcdc_event_t *callback, void *user_data);
 
 #endif // AMEBA_UI_LVGL_LV_DRIVERS_LCDC
@@ -13,18 +13,31 @@
  * limitations under the License.
  */
 
+#include "ameba_soc.h"
 #include "os_wrapper.h"
 
 #include "lvgl.h"
 #include "display.h"
 #include "jpeg_decoder.h"
 #include "lv_draw_ppe.h"
+#if RTK_TOUCH_GT911
+#include "gt911.h"
+#endif
 
 #include "lv_ameba_hal.h"
 
 #define RTK_HW_JPEG_DECODE 1
 #define RTK_HW_PPE_ENABLE 1
 #define RTK_ROMFS_ENABLE 1
+#define RTK_DISPLAY_BUFFERS 2   // 3 for triple buffering, one more framebuffer in PSRAM, uses driver sync
+#define RTK_DISPLAY_PPE_SYNC 0  // driver copies redrawn areas between framebuffers instead of LVGL
+#define RTK_DISPLAY_FLIP_LINE 0 // 0: LCDC default, height * 5 / 6
+#define RTK_DISPLAY_VSYNC_SCHED 0
+#define RTK_DISPLAY_UNDERFLOW_POLICY 0 // DISPLAY_UNDERFLOW_RAISE_BURST | DISPLAY_UNDERFLOW_THROTTLE
+#define RTK_DISPLAY_IDLE_FRAMES 0 // pause LVGL refresh after this many refreshes without drawing
+#define RTK_TOUCH_GT911 0       // start the GT911, its interrupt and read times are logged with the display stats
+
+#define LOG_TAG "LV-HAL"
 
 #define SCREEN_WIDTH  800
 #define SCREEN_HEIGHT 480
@@ -35,6 +48,34 @@ uint32_t ameba_tick_get(void) {
     return rtos_time_get_current_system_time_ms();
 }
 
+#if defined(CONFIG_LV_DEMO_BENCHMARK)
+static void display_stats_timer_cb(lv_timer_t *timer) {
+    LV_UNUSED(timer);
+    display_stats_t stats;
+
+    display_get_stats(&stats);
+    RTK_LOGI(LOG_TAG, "%d buffers: %lu fps, frames %lu, flips %lu, stall %lu ms (max %lu us), sync %lu kpx\n",
+             stats.buffer_count, stats.fps, stats.frames, stats.flips, stats.stall_time_ms, stats.stall_max_us,
+             stats.sync_kpx);
+    RTK_LOGI(LOG_TAG, "vsync %lu us, frame interval %lu us (max %lu us), missed %lu, render %lu us\n",
+             stats.vsync_period_us, stats.frame_interval_us, stats.frame_interval_max_us,
+             stats.missed_vsyncs, stats.render_time_us);
+    RTK_LOGI(LOG_TAG, "underflows %lu (last at %lu ms), burst %d, throttled frames %lu\n",
+             stats.underflows, stats.underflow_last_ms, stats.dma_burst_size, stats.throttled_frames);
+    RTK_LOGI(LOG_TAG, "idle %lu ms (%d%%), entered %lu times\n",
+             stats.idle_time_ms, stats.idle_residency, stats.idle_entries);
+
+#if RTK_TOUCH_GT911
+    // Same window as frame_interval_max_us and missed_vsyncs, to see what touch costs them
+    gt911_stats_t touch;
+    gt911_get_stats(&touch);
+    RTK_LOGI(LOG_TAG, "touch irqs %lu (coalesced %lu), irq max %lu ns, defer max %lu us, read %lu us (max %lu us), i2c errors %lu\n",
+             touch.irq_count, touch.coalesced, touch.irq_max_ns, touch.defer_max_us, touch.read_avg_us,
+             touch.read_max_us, touch.i2c_errors);
+#endif
+}
+#endif
+
 void lv_ameba_hal_init(void) {
 #if RTK_ROMFS_ENABLE
     lv_fs_romfs_init();
@@ -50,7 +91,7 @@ void lv_ameba_hal_init(void) {
 
     lv_tick_set_cb(ameba_tick_get);
 
-    display_init(LV_COLOR_DEPTH, SCREEN_WIDTH, SCREEN_HEIGHT);
+    display_init_with_buffers(LV_COLOR_DEPTH, SCREEN_WIDTH, SCREEN_HEIGHT, RTK_DISPLAY_BUFFERS);
 
     uint8_t *buf1 = display_get_buffer(0);
     uint8_t *buf2 = display_get_buffer(1);
@@ -58,8 +99,47 @@ void lv_ameba_hal_init(void) {
     lv_display_t *display = lv_display_create(SCREEN_WIDTH, SCREEN_HEIGHT);
     display_set_lv_display(display);
 
-    lv_display_set_buffers(display, buf1, buf2, SCREEN_WIDTH * SCREEN_HEIGHT * LV_COLOR_DEPTH, LV_DISPLAY_RENDER_MODE_DIRECT);
-    lv_display_set_flush_cb(display, display_flush_direct);
-    //lv_display_set_buffers(display, buf1, buf2, SCREEN_WIDTH * SCREEN_HEIGHT * LV_COLOR_DEPTH, LV_DISPLAY_RENDER_MODE_FULL);
-    //lv_display_set_flush_cb(display, display_flush_full);
+    if (RTK_DISPLAY_PPE_SYNC || display_get_buffer_count() > 2) {
+        // LVGL's direct mode syncs only the last frame from one fixed partner buffer,
+        // with three buffers the driver has to carry the areas of the last two frames
+        display_setup_direct_sync(display, RTK_HW_PPE_ENABLE);
+    } else {
+        lv_display_set_buffers(display, buf1, buf2, SCREEN_WIDTH * SCREEN_HEIGHT * LV_COLOR_DEPTH, LV_DISPLAY_RENDER_MODE_DIRECT);
+        lv_display_set_flush_cb(display, display_flush_direct);
+        //lv_display_set_buffers(display, buf1, buf2, SCREEN_WIDTH * SCREEN_HEIGHT * LV_COLOR_DEPTH, LV_DISPLAY_RENDER_MODE_FULL);
+        //lv_display_set_flush_cb(display, display_flush_full);
+    }
+
+#if RTK_DISPLAY_FLIP_LINE
+    display_set_flip_line(RTK_DISPLAY_FLIP_LINE);
+#endif
+
+#if RTK_DISPLAY_VSYNC_SCHED
+    display_enable_vsync_scheduler(true);
+#endif
+
+#if RTK_DISPLAY_UNDERFLOW_POLICY
+    display_set_underflow_policy(RTK_DISPLAY_UNDERFLOW_POLICY, NULL, NULL);
+#endif
+
+#if RTK_DISPLAY_IDLE_FRAMES
+    // No input device yet, an interrupt driven one would pass true and call lv_ameba_hal_wake()
+    display_set_idle_mode(RTK_DISPLAY_IDLE_FRAMES, false);
+#endif
+
+#if RTK_TOUCH_GT911
+    gt911_init();
+#endif
+
+#if defined(CONFIG_LV_DEMO_BENCHMARK)
+    lv_timer_create(display_stats_timer_cb, 5000, NULL);
+#endif
+}
+
+void lv_ameba_hal_wait(uint32_t ms) {
+    display_idle_wait(ms);
+}
+
+void lv_ameba_hal_wake(void) {
+    display_idle_wake();
 }
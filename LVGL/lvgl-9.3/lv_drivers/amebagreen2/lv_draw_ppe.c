@@ -19,6 +19,8 @@
 
 #include "lvgl.h"
 #include "lv_draw_ppe.h"
+#include "display.h"
+#include "nv12_draw.h"
 
 #include "src/misc/lv_types.h"
 #include "src/draw/lv_draw.h"
@@ -30,6 +32,7 @@
 #include "src/draw/sw/blend/lv_draw_sw_blend_private.h"
 #include "src/draw/sw/lv_draw_sw.h"
 #include "src/draw/lv_draw_image.h"
+#include "src/misc/cache/lv_image_cache.h"
 
 #if LV_USE_DRAW_PPE
 #if LV_USE_PARALLEL_DRAW_DEBUG
@@ -99,6 +102,11 @@ void lv_draw_ppe_init(void)
 #endif
 }
 
+bool lv_draw_ppe_is_inited(void)
+{
+    return g_ppe_ctx != NULL;
+}
+
 void lv_draw_ppe_deinit(void)
 {
     rtos_sema_delete(g_ppe_ctx->ppe_sema);
@@ -143,6 +151,22 @@ static bool _ppe_image_transform_supported(const lv_draw_image_dsc_t *draw_dsc)
     return true;
 }
 
+/* NV12 images (JPEG YUV output) are converted straight into the layer when drawn without
+ * blending or transform, otherwise through a temporary RGB copy. The SW unit can't draw them. */
+static bool _ppe_yuv_blit_supported(const lv_draw_image_dsc_t *draw_dsc)
+{
+    return draw_dsc->rotation == 0 &&
+           draw_dsc->scale_x == LV_SCALE_NONE &&
+           draw_dsc->scale_y == LV_SCALE_NONE &&
+           draw_dsc->skew_x == 0 &&
+           draw_dsc->skew_y == 0 &&
+           draw_dsc->recolor_opa <= LV_OPA_MIN &&
+           draw_dsc->opa >= LV_OPA_MAX &&
+           draw_dsc->blend_mode == LV_BLEND_MODE_NORMAL &&
+           draw_dsc->clip_radius == 0 &&
+           draw_dsc->bitmap_mask_src == NULL;
+}
+
 static int32_t _ppe_evaluate(lv_draw_unit_t *u, lv_draw_task_t *t)
 {
     LV_UNUSED(u);
@@ -166,6 +190,12 @@ static int32_t _ppe_evaluate(lv_draw_unit_t *u, lv_draw_task_t *t)
 
         case LV_DRAW_TASK_TYPE_IMAGE: {
             lv_draw_image_dsc_t *dsc = (lv_draw_image_dsc_t *)t->draw_dsc;
+            if (dsc->header.cf == LV_COLOR_FORMAT_NV12) {
+                // only this unit draws NV12, the JPEG decoder keeps RGB output without it
+                t->preference_score = 0;
+                t->preferred_draw_unit_id = DRAW_UNIT_ID_PPE;
+                return 1;
+            }
             if (!_ppe_image_transform_supported(dsc)) {
                 //printf("pp image transform not supported.\n");
                 return 0;
@@ -365,6 +395,132 @@ static void _ppe_draw_fill(lv_draw_task_t *t)
 #endif
 }
 
+static nv12_out_format_t _ppe_nv12_out_format(lv_color_format_t cf)
+{
+    switch(cf) {
+        case LV_COLOR_FORMAT_RGB565:   return NV12_OUT_RGB565;
+        case LV_COLOR_FORMAT_RGB888:   return NV12_OUT_RGB888;
+        default:                       return NV12_OUT_XRGB8888;
+    }
+}
+
+/* Convert only the clipped part of an NV12 image straight into the layer */
+static void _ppe_img_draw_yuv(lv_draw_task_t *t, const lv_draw_buf_t *decoded, const lv_area_t *img_coords)
+{
+    lv_layer_t *layer = t->target_layer;
+    lv_area_t blend_area;
+    if (!lv_area_intersect(&blend_area, img_coords, &t->clip_area)) return;
+
+#if TIME_DEBUG
+    uint64_t start, end, time_used;
+    start = rtos_time_get_current_system_time_ns();
+#endif
+    uint32_t y_stride = decoded->header.stride;
+    const uint8_t *y_plane = decoded->data;
+    const uint8_t *uv_plane = y_plane + y_stride * decoded->header.h;
+    uint32_t src_x = blend_area.x1 - img_coords->x1;
+    uint32_t width = lv_area_get_width(&blend_area);
+
+    for (int32_t y = blend_area.y1; y <= blend_area.y2; y++) {
+        uint32_t src_y = y - img_coords->y1;
+        uint8_t *dest = lv_draw_layer_go_to_xy(layer, blend_area.x1 - layer->buf_area.x1, y - layer->buf_area.y1);
+        nv12_to_rgb_line(y_plane + src_y * y_stride + src_x, uv_plane + (src_y / 2) * y_stride,
+                         src_x, width, dest, _ppe_nv12_out_format(layer->color_format));
+    }
+
+#if TIME_DEBUG
+    end = rtos_time_get_current_system_time_ns();
+    time_used = end - start;
+    RTK_LOGI(LOG_TAG, "YUV Imag (%-3ld %-3ld %-3lu %-3ld) Time:%8lld\n",
+        blend_area.x1, blend_area.y1, width, lv_area_get_height(&blend_area), time_used);
+#endif
+}
+
+/*
+ * Blended or transformed NV12 (fades, zoom): convert the part of the image the clip area
+ * shows to RGB on the CPU and let the SW renderer draw that. Effects bound to the whole
+ * image area (clip radius, masks, tiling, skew) convert all of it.
+ */
+static void _ppe_img_draw_yuv_sw(lv_draw_task_t *t, const lv_draw_image_dsc_t *draw_dsc,
+    const lv_area_t *coords)
+{
+    lv_layer_t *layer = t->target_layer;
+    lv_image_decoder_dsc_t decoder_dsc;
+
+    if (lv_image_decoder_open(&decoder_dsc, draw_dsc->src, NULL) != LV_RESULT_OK) {
+        return;
+    }
+
+    const lv_draw_buf_t *decoded = decoder_dsc.decoded;
+    if (!decoded || decoded->header.cf != LV_COLOR_FORMAT_NV12) {
+        lv_image_decoder_close(&decoder_dsc);
+        return;
+    }
+
+    lv_color_format_t cf = layer->color_format;
+    if (cf != LV_COLOR_FORMAT_RGB565 && cf != LV_COLOR_FORMAT_RGB888) {
+        cf = LV_COLOR_FORMAT_XRGB8888;
+    }
+
+    uint32_t w = decoded->header.w;
+    uint32_t h = decoded->header.h;
+    nv12_rect_t src = { 0, 0, w - 1, h - 1 };
+    if (!draw_dsc->tile && draw_dsc->skew_x == 0 && draw_dsc->skew_y == 0 &&
+        draw_dsc->clip_radius == 0 && draw_dsc->bitmap_mask_src == NULL) {
+        nv12_rect_t clip = {
+            t->clip_area.x1 - coords->x1, t->clip_area.y1 - coords->y1,
+            t->clip_area.x2 - coords->x1, t->clip_area.y2 - coords->y1,
+        };
+        if (!nv12_source_rect(w, h, &clip, draw_dsc->pivot.x, draw_dsc->pivot.y, draw_dsc->rotation,
+                              draw_dsc->scale_x, draw_dsc->scale_y, &src)) {
+            lv_image_decoder_close(&decoder_dsc);
+            return;
+        }
+    }
+
+    uint32_t src_w = src.x2 - src.x1 + 1;
+    uint32_t src_h = src.y2 - src.y1 + 1;
+    lv_draw_buf_t *rgb = lv_draw_buf_create(src_w, src_h, cf, LV_STRIDE_AUTO);
+    if (!rgb) {
+        RTK_LOGE(LOG_TAG, "No memory to convert NV12 image %lux%lu\n", src_w, src_h);
+        lv_image_decoder_close(&decoder_dsc);
+        return;
+    }
+
+    uint32_t y_stride = decoded->header.stride;
+    const uint8_t *y_plane = decoded->data;
+    const uint8_t *uv_plane = y_plane + y_stride * h;
+    for (int32_t y = src.y1; y <= src.y2; y++) {
+        nv12_to_rgb_line(y_plane + y * y_stride + src.x1, uv_plane + (y / 2) * y_stride, src.x1, src_w,
+                         rgb->data + (y - src.y1) * rgb->header.stride, _ppe_nv12_out_format(cf));
+    }
+    lv_image_decoder_close(&decoder_dsc);
+
+    lv_image_dsc_t rgb_img = {0};
+    rgb_img.header = rgb->header;
+    rgb_img.data = rgb->data;
+    rgb_img.data_size = rgb->data_size;
+
+    // The part keeps its screen position, the pivot follows it
+    lv_area_t src_coords = {
+        coords->x1 + src.x1, coords->y1 + src.y1,
+        coords->x1 + src.x2, coords->y1 + src.y2,
+    };
+    lv_draw_image_dsc_t sw_dsc = *draw_dsc;
+    sw_dsc.src = &rgb_img;
+    sw_dsc.header = rgb_img.header;
+    sw_dsc.pivot.x -= src.x1;
+    sw_dsc.pivot.y -= src.y1;
+    if (src_w != w || src_h != h) {
+        sw_dsc.image_area = src_coords;
+    }
+    lv_draw_sw_image(t, &sw_dsc, &src_coords);
+
+    // the descriptor is on the stack, don't let the image cache keep it
+    lv_image_cache_drop(&rgb_img);
+    lv_draw_buf_destroy(rgb);
+}
+
 static void _ppe_img_draw_core(lv_draw_task_t *t,
     const lv_draw_image_dsc_t *draw_dsc,
     const lv_image_decoder_dsc_t *decoder_dsc,
@@ -384,6 +540,11 @@ static void _ppe_img_draw_core(lv_draw_task_t *t,
         return;
     }
 
+    if (header->cf == LV_COLOR_FORMAT_NV12) {
+        _ppe_img_draw_yuv(t, decoded, img_coords);
+        return;
+    }
+
     lv_layer_t *layer = t->target_layer;
     uint32_t img_cf = header->cf;
     lv_draw_buf_t *draw_buf = layer->draw_buf;
@@ -461,6 +622,11 @@ static void _ppe_img_draw_core(lv_draw_task_t *t,
 static void lv_draw_ppe_image(lv_draw_task_t *t, const lv_draw_image_dsc_t *draw_dsc,
     const lv_area_t *coords)
 {
+    if (draw_dsc->header.cf == LV_COLOR_FORMAT_NV12 && !_ppe_yuv_blit_supported(draw_dsc)) {
+        _ppe_img_draw_yuv_sw(t, draw_dsc, coords);
+        return;
+    }
+
     if(!draw_dsc->tile) {
         lv_draw_image_normal_helper(t, draw_dsc, coords, _ppe_img_draw_core);
     } else {
@@ -693,6 +859,9 @@ static void _ppe_execute_drawing(lv_draw_ppe_unit_t *u)
 
     lv_draw_buf_invalidate_cache(layer->draw_buf, &t->area);
 
+    // Only the first task of a refresh waits while the display throttles
+    display_bandwidth_wait();
+
     switch(t->type) {
         case LV_DRAW_TASK_TYPE_FILL:
             _ppe_draw_fill(t);
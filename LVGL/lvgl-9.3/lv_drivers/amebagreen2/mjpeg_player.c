@@ -0,0 +1,553 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ameba_soc.h"
+#include "os_wrapper.h"
+
+#include "mjpeg_player.h"
+#include "jpeg_decoder_private.h"
+
+#include "src/stdlib/lv_mem.h"
+#include "src/stdlib/lv_string.h"
+#include "src/misc/lv_fs.h"
+#include "src/misc/cache/lv_image_cache.h"
+
+#define LOG_TAG "MJPEG"
+
+#define MJPEG_DEF_FPS               25
+#define MJPEG_STACK_SIZE            (8 * 1024)
+#define MJPEG_READ_CHUNK            (16 * 1024)
+#define MJPEG_FRAME_MAX             (1024 * 1024)   // larger frames in a file are skipped
+
+typedef enum {
+    FRAME_FOUND,
+    FRAME_NEED_DATA,
+} frame_scan_t;
+
+/*
+ * LVGL thread: API, timer (shows the back buffer, requests the next frame).
+ * Worker: stream reading and decoding into the back buffer. Stream state and
+ * frame_no are only touched by the worker while it is busy, the LVGL thread
+ * changes them after player_wait_idle().
+ */
+struct lv_ameba_mjpeg_player {
+    lv_obj_t *img;
+    lv_timer_t *timer;
+    lv_thread_t thread;
+    lv_thread_sync_t sync;
+    lv_mutex_t lock;
+
+    // Memory source
+    const uint8_t *data;
+    uint32_t data_size;
+    uint32_t data_pos;
+
+    // File source, frames are collected in fbuf
+    lv_fs_file_t file;
+    bool file_opened;
+    uint8_t *fbuf;
+    uint32_t fbuf_cap;
+    uint32_t fbuf_len;
+    uint32_t fbuf_pos;
+
+    lv_draw_buf_t *bufs[2];
+    uint32_t front;             // buffer currently shown
+    uint32_t frame_no;          // next frame the worker reads
+    uint32_t want_frame;        // worker skips frames before this one
+    uint32_t frame_base;        // frame due at start_ms
+    uint32_t start_ms;          // first timer run after play or a rate change
+    uint32_t period_ms;
+
+    bool has_src;
+    bool loop;
+    bool playing;
+    bool back_ready;
+    bool eos;
+    volatile bool busy;
+    volatile bool exit_status;
+    volatile bool thread_exited;
+
+    lv_ameba_mjpeg_player_stats_t stats;
+};
+
+/*
+ * Find the first complete JPEG in buf. Marker segments are skipped by their length,
+ * so EOI bytes in EXIF thumbnails don't end the frame, entropy-coded data is scanned
+ * for EOI (stuffed 0xFF00 and RSTn are skipped). *start is the SOI offset, or the
+ * number of bytes that can be discarded when no SOI was found.
+ */
+static frame_scan_t frame_scan(const uint8_t *buf, uint32_t len, uint32_t *start, uint32_t *end)
+{
+    uint32_t i = 0;
+
+    while (i + 1 < len && !(buf[i] == 0xFF && buf[i + 1] == 0xD8)) {
+        i++;
+    }
+    *start = i;
+    if (i + 1 >= len) {
+        return FRAME_NEED_DATA;
+    }
+
+    i += 2;
+    while (i + 1 < len) {
+        if (buf[i] != 0xFF) {
+            i++;
+            continue;
+        }
+
+        uint8_t marker = buf[i + 1];
+        if (marker == 0xFF) {
+            i++;  // fill byte
+        } else if (marker == 0x00 || marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7)) {
+            i += 2;  // stuffed byte, TEM or RSTn
+        } else if (marker == 0xD9) {
+            *end = i + 2;
+            return FRAME_FOUND;
+        } else if (marker == 0xD8) {
+            // Truncated frame, restart from the new SOI
+            *start = i;
+            i += 2;
+        } else {
+            if (i + 3 >= len) {
+                break;
+            }
+            i += 2 + ((buf[i + 2] << 8) | buf[i + 3]);
+        }
+    }
+
+    return FRAME_NEED_DATA;
+}
+
+static void stream_rewind(lv_ameba_mjpeg_player_t *p)
+{
+    p->data_pos = 0;
+    p->fbuf_len = 0;
+    p->fbuf_pos = 0;
+    if (p->file_opened) {
+        lv_fs_seek(&p->file, 0, LV_FS_SEEK_SET);
+    }
+}
+
+static bool stream_next_file(lv_ameba_mjpeg_player_t *p, const uint8_t **frame, uint32_t *size)
+{
+    while (1) {
+        uint32_t start, end;
+        if (frame_scan(p->fbuf + p->fbuf_pos, p->fbuf_len - p->fbuf_pos, &start, &end) == FRAME_FOUND) {
+            *frame = p->fbuf + p->fbuf_pos + start;
+            *size = end - start;
+            p->fbuf_pos += end;
+            return true;
+        }
+
+        // Keep the partial frame at the front and read more behind it
+        p->fbuf_pos += start;
+        if (p->fbuf_pos) {
+            memmove(p->fbuf, p->fbuf + p->fbuf_pos, p->fbuf_len - p->fbuf_pos);
+            p->fbuf_len -= p->fbuf_pos;
+            p->fbuf_pos = 0;
+        }
+
+        if (p->fbuf_cap - p->fbuf_len < MJPEG_READ_CHUNK) {
+            uint32_t cap = LV_MAX(p->fbuf_cap * 2, MJPEG_READ_CHUNK);
+            if (cap > MJPEG_FRAME_MAX) {
+                RTK_LOGW(LOG_TAG, "Frame larger than %d bytes, skipped\n", MJPEG_FRAME_MAX);
+                p->fbuf_len = 0;
+                cap = p->fbuf_cap;
+            }
+            if (cap != p->fbuf_cap) {
+                uint8_t *fbuf = lv_realloc(p->fbuf, cap);
+                if (!fbuf) {
+                    return false;
+                }
+                p->fbuf = fbuf;
+                p->fbuf_cap = cap;
+            }
+        }
+
+        uint32_t rn = 0;
+        lv_fs_res_t res = lv_fs_read(&p->file, p->fbuf + p->fbuf_len, p->fbuf_cap - p->fbuf_len, &rn);
+        if (res != LV_FS_RES_OK || rn == 0) {
+            return false;
+        }
+        p->fbuf_len += rn;
+    }
+}
+
+static bool stream_next(lv_ameba_mjpeg_player_t *p, const uint8_t **frame, uint32_t *size)
+{
+    for (int pass = 0; pass < 2; pass++) {
+        if (p->file_opened) {
+            if (stream_next_file(p, frame, size)) {
+                return true;
+            }
+        } else {
+            uint32_t start, end;
+            if (frame_scan(p->data + p->data_pos, p->data_size - p->data_pos, &start, &end) == FRAME_FOUND) {
+                *frame = p->data + p->data_pos + start;
+                *size = end - start;
+                p->data_pos += end;
+                return true;
+            }
+        }
+
+        if (!p->loop) {
+            break;
+        }
+        stream_rewind(p);
+    }
+
+    return false;
+}
+
+static bool buffers_alloc(lv_ameba_mjpeg_player_t *p, const uint8_t *frame, uint32_t size)
+{
+    lv_image_header_t header;
+
+    if (jpeg_decoder_get_header(frame, size, &header) != LV_RESULT_OK) {
+        return false;
+    }
+
+    lv_color_format_t cf = jpeg_decoder_render_format();
+    uint32_t stride = lv_draw_buf_width_to_stride(header.w, cf);
+    for (int i = 0; i < 2; i++) {
+        p->bufs[i] = lv_draw_buf_create(header.w, header.h, cf, stride);
+        if (!p->bufs[i]) {
+            RTK_LOGE(LOG_TAG, "Frame buffer %dx%d alloc failed\n", (int)header.w, (int)header.h);
+            if (i) {
+                lv_draw_buf_destroy(p->bufs[0]);
+                p->bufs[0] = NULL;
+            }
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void buffers_free(lv_ameba_mjpeg_player_t *p)
+{
+    for (int i = 0; i < 2; i++) {
+        if (p->bufs[i]) {
+            lv_image_cache_drop(p->bufs[i]);
+            lv_draw_buf_destroy(p->bufs[i]);
+            p->bufs[i] = NULL;
+        }
+    }
+}
+
+static void player_thread_cb(void *param)
+{
+    lv_ameba_mjpeg_player_t *p = param;
+
+    while (1) {
+        lv_mutex_lock(&p->lock);
+        bool exit_status = p->exit_status;
+        bool work = p->playing && !p->back_ready && !p->eos;
+        uint32_t want = p->want_frame;
+        p->busy = work && !exit_status;
+        lv_mutex_unlock(&p->lock);
+
+        if (exit_status) {
+            break;
+        }
+        if (!work) {
+            lv_thread_sync_wait(&p->sync);
+            continue;
+        }
+
+        const uint8_t *frame = NULL;
+        uint32_t size = 0;
+        uint32_t frame_no = p->frame_no;
+        uint32_t dropped = 0;
+        bool ok = stream_next(p, &frame, &size);
+
+        // The display is already past these frames, skip them without decoding
+        while (ok && frame_no < want) {
+            frame_no++;
+            dropped++;
+            ok = stream_next(p, &frame, &size);
+        }
+
+        if (ok && !p->bufs[0] && !buffers_alloc(p, frame, size)) {
+            ok = false;
+        }
+
+        lv_result_t res = LV_RESULT_INVALID;
+        uint32_t start = rtos_time_get_current_system_time_ms();
+        if (ok) {
+            // front only changes while back_ready is set, the back buffer is ours
+            res = jpeg_decoder_decode_into(frame, size, p->bufs[p->front ^ 1]);
+        }
+        uint32_t time_used = rtos_time_get_current_system_time_ms() - start;
+
+        lv_mutex_lock(&p->lock);
+        p->stats.frames_dropped += dropped;
+        if (!ok) {
+            p->eos = true;
+        } else if (res == LV_RESULT_OK) {
+            p->back_ready = true;
+            p->stats.frames_decoded++;
+            p->stats.decode_time_last = time_used;
+            p->stats.decode_time_max = LV_MAX(p->stats.decode_time_max, time_used);
+        } else {
+            p->stats.decode_errors++;
+        }
+        p->frame_no = frame_no + (ok ? 1 : 0);
+        p->busy = false;
+        lv_mutex_unlock(&p->lock);
+    }
+
+    // Returning ends the task, lv_thread_delete must not be called afterwards
+    p->thread_exited = true;
+}
+
+/* Keep the worker away from stream and buffers, a running decode is finished first */
+static void player_wait_idle(lv_ameba_mjpeg_player_t *p)
+{
+    lv_mutex_lock(&p->lock);
+    p->playing = false;
+    lv_mutex_unlock(&p->lock);
+    lv_timer_pause(p->timer);
+
+    while (p->busy) {
+        rtos_time_delay_ms(1);
+    }
+}
+
+static void player_rebase(lv_ameba_mjpeg_player_t *p)
+{
+    // A frame already decoded is the next one due
+    p->start_ms = rtos_time_get_current_system_time_ms() + p->period_ms;
+    p->frame_base = p->frame_no - (p->back_ready ? 1 : 0);
+    p->want_frame = p->frame_no;
+}
+
+static void player_timer_cb(lv_timer_t *timer)
+{
+    lv_ameba_mjpeg_player_t *p = lv_timer_get_user_data(timer);
+    int32_t elapsed = rtos_time_get_current_system_time_ms() - p->start_ms;
+    uint32_t due = p->frame_base + (elapsed > 0 ? elapsed / p->period_ms : 0);
+    bool show = false;
+    bool finished = false;
+
+    lv_mutex_lock(&p->lock);
+    if (p->back_ready) {
+        p->front ^= 1;
+        p->back_ready = false;
+        p->want_frame = due + 1;
+        p->stats.frames_shown++;
+        show = true;
+    } else if (p->eos) {
+        p->playing = false;
+        finished = true;
+    } else {
+        p->stats.late_ticks++;
+    }
+    lv_mutex_unlock(&p->lock);
+
+    if (show) {
+        lv_draw_buf_t *buf = p->bufs[p->front];
+        lv_image_cache_drop(buf);
+        lv_image_set_src(p->img, buf);
+        lv_obj_invalidate(p->img);
+        lv_thread_sync_signal(&p->sync);
+    } else if (finished) {
+        lv_timer_pause(timer);
+        lv_obj_send_event(p->img, LV_EVENT_READY, NULL);
+    }
+}
+
+static void source_close(lv_ameba_mjpeg_player_t *p)
+{
+    if (p->file_opened) {
+        lv_fs_close(&p->file);
+        p->file_opened = false;
+    }
+    if (p->fbuf) {
+        lv_free(p->fbuf);
+        p->fbuf = NULL;
+    }
+    p->fbuf_cap = 0;
+    p->data = NULL;
+    p->data_size = 0;
+    p->has_src = false;
+
+    stream_rewind(p);
+    p->frame_no = 0;
+    p->back_ready = false;
+    p->eos = false;
+}
+
+static void player_free(lv_ameba_mjpeg_player_t *p)
+{
+    lv_mutex_lock(&p->lock);
+    p->exit_status = true;
+    lv_mutex_unlock(&p->lock);
+    lv_thread_sync_signal(&p->sync);
+
+    while (!p->thread_exited) {
+        rtos_time_delay_ms(1);
+    }
+
+    lv_timer_delete(p->timer);
+    source_close(p);
+    buffers_free(p);
+    lv_thread_sync_delete(&p->sync);
+    lv_mutex_delete(&p->lock);
+    lv_free(p);
+}
+
+static void img_delete_cb(lv_event_t *e)
+{
+    player_free(lv_event_get_user_data(e));
+}
+
+lv_ameba_mjpeg_player_t *lv_ameba_mjpeg_player_create(lv_obj_t *parent)
+{
+    lv_ameba_mjpeg_player_t *p = lv_malloc_zeroed(sizeof(lv_ameba_mjpeg_player_t));
+    if (!p) {
+        return NULL;
+    }
+
+    p->period_ms = 1000 / MJPEG_DEF_FPS;
+    lv_mutex_init(&p->lock);
+    lv_thread_sync_init(&p->sync);
+
+    if (lv_thread_init(&p->thread, "mjpeg", LV_THREAD_PRIO_MID,
+                       player_thread_cb, MJPEG_STACK_SIZE, p) != LV_RESULT_OK) {
+        RTK_LOGE(LOG_TAG, "Create worker thread failed\n");
+        lv_thread_sync_delete(&p->sync);
+        lv_mutex_delete(&p->lock);
+        lv_free(p);
+        return NULL;
+    }
+
+    p->timer = lv_timer_create(player_timer_cb, p->period_ms, p);
+    lv_timer_pause(p->timer);
+
+    p->img = lv_image_create(parent);
+    lv_obj_add_event_cb(p->img, img_delete_cb, LV_EVENT_DELETE, p);
+
+    return p;
+}
+
+void lv_ameba_mjpeg_player_delete(lv_ameba_mjpeg_player_t *player)
+{
+    // Frees the player through img_delete_cb
+    lv_obj_delete(player->img);
+}
+
+lv_obj_t *lv_ameba_mjpeg_player_get_obj(lv_ameba_mjpeg_player_t *player)
+{
+    return player->img;
+}
+
+static void source_reset(lv_ameba_mjpeg_player_t *p)
+{
+    player_wait_idle(p);
+    source_close(p);
+
+    // Next source may have another frame size
+    lv_image_set_src(p->img, NULL);
+    buffers_free(p);
+    lv_memzero(&p->stats, sizeof(p->stats));
+}
+
+lv_result_t lv_ameba_mjpeg_player_set_src_file(lv_ameba_mjpeg_player_t *player, const char *path)
+{
+    source_reset(player);
+
+    if (lv_fs_open(&player->file, path, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+        RTK_LOGE(LOG_TAG, "Can't open %s\n", path);
+        return LV_RESULT_INVALID;
+    }
+    player->file_opened = true;
+    player->has_src = true;
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_ameba_mjpeg_player_set_src_data(lv_ameba_mjpeg_player_t *player, const uint8_t *data, uint32_t size)
+{
+    source_reset(player);
+
+    if (!data || size < 4) {
+        return LV_RESULT_INVALID;
+    }
+    player->data = data;
+    player->data_size = size;
+    player->has_src = true;
+
+    return LV_RESULT_OK;
+}
+
+void lv_ameba_mjpeg_player_set_fps(lv_ameba_mjpeg_player_t *player, uint32_t fps)
+{
+    player->period_ms = LV_MAX(1000 / LV_MAX(fps, 1), 1);
+    lv_timer_set_period(player->timer, player->period_ms);
+
+    lv_mutex_lock(&player->lock);
+    player_rebase(player);
+    lv_mutex_unlock(&player->lock);
+}
+
+void lv_ameba_mjpeg_player_set_loop(lv_ameba_mjpeg_player_t *player, bool loop)
+{
+    // Only read by the worker at the end of the stream
+    player->loop = loop;
+}
+
+void lv_ameba_mjpeg_player_play(lv_ameba_mjpeg_player_t *player)
+{
+    if (!player->has_src) {
+        return;
+    }
+
+    lv_mutex_lock(&player->lock);
+    if (player->eos) {
+        // Play again after the end of the stream
+        stream_rewind(player);
+        player->frame_no = 0;
+        player->eos = false;
+    }
+    player_rebase(player);
+    player->playing = true;
+    lv_mutex_unlock(&player->lock);
+
+    lv_timer_resume(player->timer);
+    lv_thread_sync_signal(&player->sync);
+}
+
+void lv_ameba_mjpeg_player_pause(lv_ameba_mjpeg_player_t *player)
+{
+    player_wait_idle(player);
+}
+
+void lv_ameba_mjpeg_player_stop(lv_ameba_mjpeg_player_t *player)
+{
+    player_wait_idle(player);
+
+    stream_rewind(player);
+    player->frame_no = 0;
+    player->back_ready = false;
+    player->eos = false;
+}
+
+void lv_ameba_mjpeg_player_get_stats(lv_ameba_mjpeg_player_t *player, lv_ameba_mjpeg_player_stats_t *stats)
+{
+    lv_mutex_lock(&player->lock);
+    *stats = player->stats;
+    lv_mutex_unlock(&player->lock);
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <math.h>
+
+#include "nv12_draw.h"
+
+/* JFIF (BT.601 full range) YCbCr -> RGB coefficients, 16.16 fixed point */
+#define YUV_FIX_SHIFT               16
+#define YUV_FIX_ROUND               (1 << (YUV_FIX_SHIFT - 1))
+#define YUV_CR_TO_R                 91881   // 1.402
+#define YUV_CB_TO_G                 22554   // 0.344136
+#define YUV_CR_TO_G                 46802   // 0.714136
+#define YUV_CB_TO_B                 116130  // 1.772
+
+#define NV12_TRANSFORM_MARGIN       2       // px around the mapped clip, bilinear filtering and rounding
+
+static inline uint8_t yuv_clamp(int32_t v)
+{
+    return v < 0 ? 0 : (v > 255 ? 255 : (uint8_t)v);
+}
+
+void nv12_to_rgb_line(const uint8_t *y_line, const uint8_t *uv_line, uint32_t x, uint32_t w,
+                      uint8_t *dest, nv12_out_format_t format)
+{
+    int32_t r_add = 0, g_add = 0, b_add = 0;
+
+    // Chroma terms are shared by each horizontal pixel pair
+    for (uint32_t i = 0; i < w; i++, x++) {
+        if (i == 0 || (x & 1) == 0) {
+            int32_t cb = uv_line[x & ~1U] - 128;
+            int32_t cr = uv_line[(x & ~1U) + 1] - 128;
+            r_add = (YUV_CR_TO_R * cr + YUV_FIX_ROUND) >> YUV_FIX_SHIFT;
+            g_add = (-YUV_CB_TO_G * cb - YUV_CR_TO_G * cr + YUV_FIX_ROUND) >> YUV_FIX_SHIFT;
+            b_add = (YUV_CB_TO_B * cb + YUV_FIX_ROUND) >> YUV_FIX_SHIFT;
+        }
+
+        int32_t luma = y_line[i];
+        uint8_t r = yuv_clamp(luma + r_add);
+        uint8_t g = yuv_clamp(luma + g_add);
+        uint8_t b = yuv_clamp(luma + b_add);
+
+        switch (format) {
+        case NV12_OUT_RGB565:
+            ((uint16_t *)dest)[i] = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+            break;
+        case NV12_OUT_RGB888:
+            dest[i * 3] = b;
+            dest[i * 3 + 1] = g;
+            dest[i * 3 + 2] = r;
+            break;
+        default:
+            dest[i * 4] = b;
+            dest[i * 4 + 1] = g;
+            dest[i * 4 + 2] = r;
+            dest[i * 4 + 3] = 0xFF;
+            break;
+        }
+    }
+}
+
+bool nv12_source_rect(uint32_t w, uint32_t h, const nv12_rect_t *clip, int32_t pivot_x, int32_t pivot_y,
+                      int32_t rotation, int32_t scale_x, int32_t scale_y, nv12_rect_t *src)
+{
+    float min_x, min_y, max_x, max_y;
+
+    if (scale_x <= 0 || scale_y <= 0) {
+        return false;
+    }
+
+    // Inverse of LVGL's transform: rotate back around the pivot, then unscale
+    float rad = -(float)rotation * 3.14159265f / 1800.0f;
+    float sin_a = sinf(rad);
+    float cos_a = cosf(rad);
+    const float corner_x[4] = { clip->x1, clip->x2 + 1, clip->x1, clip->x2 + 1 };
+    const float corner_y[4] = { clip->y1, clip->y1, clip->y2 + 1, clip->y2 + 1 };
+
+    for (int i = 0; i < 4; i++) {
+        float dx = corner_x[i] - pivot_x;
+        float dy = corner_y[i] - pivot_y;
+        float x = (cos_a * dx - sin_a * dy) * 256.0f / scale_x + pivot_x;
+        float y = (sin_a * dx + cos_a * dy) * 256.0f / scale_y + pivot_y;
+
+        if (i == 0 || x < min_x) {
+            min_x = x;
+        }
+        if (i == 0 || x > max_x) {
+            max_x = x;
+        }
+        if (i == 0 || y < min_y) {
+            min_y = y;
+        }
+        if (i == 0 || y > max_y) {
+            max_y = y;
+        }
+    }
+
+    int32_t margin = (rotation == 0 && scale_x == 256 && scale_y == 256) ? 0 : NV12_TRANSFORM_MARGIN;
+    float x1 = floorf(min_x) - margin;
+    float y1 = floorf(min_y) - margin;
+    float x2 = ceilf(max_x) - 1 + margin;
+    float y2 = ceilf(max_y) - 1 + margin;
+
+    if (x2 < 0 || y2 < 0 || x1 > (float)w - 1 || y1 > (float)h - 1) {
+        return false;
+    }
+    src->x1 = x1 < 0 ? 0 : (int32_t)x1;
+    src->y1 = y1 < 0 ? 0 : (int32_t)y1;
+    src->x2 = x2 > (float)w - 1 ? (int32_t)w - 1 : (int32_t)x2;
+    src->y2 = y2 > (float)h - 1 ? (int32_t)h - 1 : (int32_t)y2;
+    return true;
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_UI_LVGL_LV_DRIVERS_NV12_DRAW
+#define AMEBA_UI_LVGL_LV_DRIVERS_NV12_DRAW
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * CPU side of drawing NV12 images (JPEG YUV output): row conversion to the layer
+ * formats and the source rectangle a transformed draw reads.
+ * Free of SDK and LVGL headers so it builds on a host.
+ */
+
+typedef enum {
+    NV12_OUT_RGB565,
+    NV12_OUT_RGB888,            // B,G,R in memory, as LVGL
+    NV12_OUT_XRGB8888,          // B,G,R,0xFF in memory
+} nv12_out_format_t;
+
+typedef struct {
+    int32_t x1;
+    int32_t y1;
+    int32_t x2;                 // inclusive, as lv_area_t
+    int32_t y2;
+} nv12_rect_t;
+
+/*
+ * Convert w pixels of one NV12 row starting at image column x, y_line points at that
+ * column, uv_line at the start of the CbCr row. JFIF (BT.601 full range) coefficients.
+ */
+void nv12_to_rgb_line(const uint8_t *y_line, const uint8_t *uv_line, uint32_t x, uint32_t w,
+                      uint8_t *dest, nv12_out_format_t format);
+
+/*
+ * Part of a w x h image that covers clip (relative to the image origin) once drawn
+ * scaled (256 = 1.0) and rotated (0.1 degree) around pivot, as LVGL transforms images.
+ * Has a margin for the filtering of transformed draws. False if nothing is visible.
+ */
+bool nv12_source_rect(uint32_t w, uint32_t h, const nv12_rect_t *clip, int32_t pivot_x, int32_t pivot_y,
+                      int32_t rotation, int32_t scale_x, int32_t scale_y, nv12_rect_t *src);
+
+#endif // AMEBA_UI_LVGL_LV_DRIVERS_NV12_DRAW
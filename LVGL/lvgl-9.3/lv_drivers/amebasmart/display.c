@@ -18,86 +18,108 @@
 #include "display.h"
 #include "os_wrapper.h"
 
+#include "panel_display.h"
 #include "st7701s.h"
 
-static int g_width = 0;
-static int g_height = 0;
+/* LCDC planes: background at the bottom, video, LVGL on top once a lower plane is used */
+#define PLANE_BACKGROUND_ID     0
+#define PLANE_VIDEO_ID          1
+#define PLANE_UI_ID             2
 
-static uint8_t *g_buffer_0 = NULL;
-static uint8_t *g_buffer_1 = NULL;
+static int g_planes_in_use = 0;
 
-static rtos_sema_t g_vsync_sem;
-static int g_id = 0;
-volatile int wait_for_vsync = 0;
+static int display_plane_id(display_plane_t plane)
+{
+    return plane == DISPLAY_PLANE_BACKGROUND ? PLANE_BACKGROUND_ID : PLANE_VIDEO_ID;
+}
 
-void display_vsync_handle(void *data)
+static void display_plane_fill_config(st7701s_plane_config *config, uint8_t *buffer, int image_format, const lv_area_t *area)
 {
-    UNUSED(data);
-    if (wait_for_vsync == 1) {
-        rtos_sema_give(g_vsync_sem);
+    memset(config, 0, sizeof(st7701s_plane_config));
+    config->buffer = buffer;
+    config->image_format = image_format;
+    if (area) {
+        config->x = area->x1;
+        config->y = area->y1;
+        config->width = lv_area_get_width(area);
+        config->height = lv_area_get_height(area);
+    } else {
+        panel_caps_t caps;
+        panel_display_get_caps(&caps);
+        config->width = caps.width;
+        config->height = caps.height;
     }
+    config->alpha = 0xFF;
 }
 
-void display_init(void)
+/* LVGL moves above the planes, its transparent pixels show them */
+static int display_ui_to_top(void)
 {
-    int image_format = 0;
+    st7701s_plane_config config;
+    display_plane_fill_config(&config, panel_display_get_front_buffer(), LV_COLOR_DEPTH == 16 ? RGB565 : ARGB8888, NULL);
     if (LV_COLOR_DEPTH == 16) {
-        image_format = RGB565;
-    } else {
-        image_format = ARGB8888;
+        config.color_key_en = 1;
+        config.color_key = DISPLAY_PLANE_KEY_COLOR;
     }
-    st7701s_init(image_format);
 
-    st7701s_get_info(&g_width, &g_height);
+    return st7701s_set_ui_plane(PLANE_UI_ID, &config);
+}
 
-    g_buffer_0 = (uint8_t *)malloc(g_width * g_height * LV_COLOR_DEPTH / 8);
-    g_buffer_1 = (uint8_t *)malloc(g_width * g_height * LV_COLOR_DEPTH / 8);
+int display_plane_show(display_plane_t plane, uint8_t *buffer, lv_color_format_t cf, const lv_area_t *area)
+{
+    st7701s_plane_config config;
+    int plane_bit = 1 << plane;
+
+    // XRGB8888 would be scanned out as ARGB8888 and blended with its undefined X byte,
+    // the LCDC layers have no per-pixel alpha disable
+    if (cf != LV_COLOR_FORMAT_RGB565 && cf != LV_COLOR_FORMAT_ARGB8888) {
+        printf("[display] plane format %d not supported\n", cf);
+        return -1;
+    }
 
-    rtos_sema_create(&g_vsync_sem, 0, RTOS_SEMA_MAX_COUNT);
+    if (!g_planes_in_use && display_ui_to_top() != 0) {
+        return -1;
+    }
 
-    st7701s_clean_invalidate_buffer(g_buffer_1);
+    display_plane_fill_config(&config, buffer, cf == LV_COLOR_FORMAT_RGB565 ? RGB565 : ARGB8888, area);
+    if (st7701s_plane_setup(display_plane_id(plane), &config) != 0) {
+        if (!g_planes_in_use) {
+            display_plane_fill_config(&config, panel_display_get_front_buffer(),
+                                      LV_COLOR_DEPTH == 16 ? RGB565 : ARGB8888, NULL);
+            st7701s_set_ui_plane(PLANE_BACKGROUND_ID, &config);
+        }
+        return -1;
+    }
 
-    ST7701SVBlankCallback *callback = (ST7701SVBlankCallback *)malloc(sizeof(ST7701SVBlankCallback));
-    callback->VBlank = display_vsync_handle;
-    st7701s_register_callback(callback, NULL);
+    g_planes_in_use |= plane_bit;
+    return 0;
 }
 
-void display_get_info(int *width, int *height)
+void display_plane_set_buffer(display_plane_t plane, uint8_t *buffer)
 {
-    *width = g_width;
-    *height = g_height;
+    if (g_planes_in_use & (1 << plane)) {
+        st7701s_plane_set_buffer(display_plane_id(plane), buffer);
+    }
 }
 
-uint8_t *display_get_buffer(int buffer_id)
+void display_plane_hide(display_plane_t plane)
 {
-    if (buffer_id == 1) {
-        return g_buffer_1;
-    } else if (buffer_id == 0) {
-        return g_buffer_0;
-    } else {
-        return NULL;
+    if (!(g_planes_in_use & (1 << plane))) {
+        return;
     }
-}
 
-void display_flush(lv_display_t * display, const lv_area_t * area, void * color_p)
-{
-    //printf("display_flush %d %d %d %d\n", area->x1, area->y1, area->x2, area->y2);
-    UNUSED(area);
-    UNUSED(color_p);
-
-    if (g_id == 1) {
-        st7701s_clean_invalidate_buffer(g_buffer_1);
-        wait_for_vsync = 1;
-        rtos_sema_take(g_vsync_sem, RTOS_MAX_TIMEOUT);
-        wait_for_vsync = 0;
-        g_id = 0;
-    } else {
-        st7701s_clean_invalidate_buffer(g_buffer_0);
-        wait_for_vsync = 1;
-        rtos_sema_take(g_vsync_sem, RTOS_MAX_TIMEOUT);
-        wait_for_vsync = 0;
-        g_id = 1;
+    g_planes_in_use &= ~(1 << plane);
+    if (g_planes_in_use) {
+        st7701s_plane_disable(display_plane_id(plane));
+        return;
     }
 
-    lv_disp_flush_ready(display);
-}
\ No newline at end of file
+    // Last plane gone, LVGL goes back to the bottom layer without color keying
+    st7701s_plane_config config;
+    display_plane_fill_config(&config, panel_display_get_front_buffer(),
+                              LV_COLOR_DEPTH == 16 ? RGB565 : ARGB8888, NULL);
+    if (plane != DISPLAY_PLANE_BACKGROUND) {
+        st7701s_plane_disable(display_plane_id(plane));
+    }
+    st7701s_set_ui_plane(PLANE_BACKGROUND_ID, &config);
+}
@@ -17,7 +17,8 @@
 #include <stdio.h>
 
 #include "lvgl.h"
-#include "display.h"
+#include "panel_display.h"
+#include "st7701s.h"
 #include "touch.h"
 
 #include "lv_ameba_hal.h"
@@ -32,18 +33,8 @@ void lv_ameba_hal_init(void)
 {
     lv_tick_set_cb(custom_tick_get);
 
-    display_init();
-
-    int width;
-    int height;
-    display_get_info(&width, &height);
-
-    uint8_t *buffer_1 = display_get_buffer(0);
-    uint8_t *buffer_2 = display_get_buffer(1);
-
-    lv_display_t *display = lv_display_create(width, height); /*Create the display*/
-    lv_display_set_flush_cb(display, display_flush);        /*Set a flush callback to draw to the display*/
-    lv_display_set_buffers(display, buffer_1, buffer_2, width * height * 2, LV_DISPLAY_RENDER_MODE_FULL); /*Set an initialized buffer*/
+    lv_display_t *display = panel_display_create(&st7701s_panel_ops, 2);
+    LV_ASSERT_NULL(display);
     //lv_display_set_rotation(display, LV_DISPLAY_ROTATION_270);
 
     touch_init();
@@ -52,3 +43,12 @@ void lv_ameba_hal_init(void)
     lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
     lv_indev_set_read_cb(indev, touch_read);
 }
+
+void lv_ameba_hal_wait(uint32_t ms)
+{
+    rtos_time_delay_ms(ms == LV_NO_TIMER_READY ? LV_DEF_REFR_PERIOD : ms);
+}
+
+void lv_ameba_hal_wake(void)
+{
+}
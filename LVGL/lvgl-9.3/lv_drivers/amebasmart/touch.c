@@ -14,33 +14,111 @@
  */
 
 #include "cst328.h"
-#include "lvgl.h"
+#include "touch_gesture.h"
+#include "touch.h"
 
-static uint16_t g_x = 0;
-static uint16_t g_y = 0;
-static uint8_t g_status = 3;
+static touch_ring_t g_ring;
+static touch_gesture_state_t g_gesture;
+static uint32_t g_gesture_event;
 
-static void touch_data_callback(cst328_touch_data_t data)
+static lv_point_t g_point;
+static lv_indev_state_t g_state = LV_INDEV_STATE_RELEASED;
+static uint8_t g_primary_id;
+static bool g_primary_down;
+static bool g_multi;         // a second finger came down, pointer held released until all are up
+
+/* Object under the gesture, scrolled by two finger scrolls and sent the gesture event */
+static void touch_send_gesture(const touch_gesture_t *gesture)
+{
+    lv_point_t point = { gesture->x, gesture->y };
+    lv_obj_t *obj = lv_indev_search_obj(lv_screen_active(), &point);
+
+    if (!obj) {
+        return;
+    }
+
+    if (gesture->type == TOUCH_GESTURE_SCROLL) {
+        lv_obj_t *scroll = obj;
+        while (scroll && !lv_obj_has_flag(scroll, LV_OBJ_FLAG_SCROLLABLE)) {
+            scroll = lv_obj_get_parent(scroll);
+        }
+        if (scroll) {
+            // same direction as a one finger drag
+            lv_obj_scroll_by_bounded(scroll, gesture->dx, gesture->dy, LV_ANIM_OFF);
+        }
+    }
+
+    lv_obj_send_event(obj, (lv_event_code_t)g_gesture_event, (void *)gesture);
+}
+
+static void touch_update_pointer(lv_indev_t *indev, const touch_frame_t *frame)
 {
-    g_x = data.x;
-    g_y = data.y;
-    if (data.state == TOUCH_PRESS) {
-        g_status = LV_INDEV_STATE_PR;
-    } else {
-        g_status = LV_INDEV_STATE_REL;
+    if (frame->count == 0) {
+        g_primary_down = false;
+        g_multi = false;
+        g_state = LV_INDEV_STATE_RELEASED;
+        return;
+    }
+
+    if (frame->count >= 2 && !g_multi) {
+        // hand the touch to the gesture engine, no click or scroll from the first finger
+        g_multi = true;
+        lv_indev_reset(indev, NULL);
+    }
+
+    if (g_multi) {
+        g_state = LV_INDEV_STATE_RELEASED;
+        return;
+    }
+
+    const touch_point_t *point = g_primary_down ? touch_frame_find(frame, g_primary_id) : NULL;
+    if (!point) {
+        point = &frame->points[0];
+        g_primary_id = point->id;
+        g_primary_down = true;
     }
+    g_point.x = point->x;
+    g_point.y = point->y;
+    g_state = LV_INDEV_STATE_PRESSED;
 }
 
 void touch_init(void)
 {
+    g_gesture_event = lv_event_register_id();
+    touch_gesture_reset(&g_gesture);
+
     cst328_init();
-    cst328_register_touch_data_callback(touch_data_callback);
+    cst328_register_touch_ring(&g_ring);
+}
+
+uint32_t touch_get_gesture_event(void)
+{
+    return g_gesture_event;
 }
 
 void touch_read(lv_indev_t * indev, lv_indev_data_t * data)
 {
-    (void)indev;
-    data->point.x = g_x;
-    data->point.y = g_y;
-    data->state = g_status;
-}
\ No newline at end of file
+    touch_frame_t frame;
+    touch_gesture_t gesture;
+
+    /* LVGL takes one sample per read period for drag speed and scroll throw, so the
+     * reports queued since the last poll are folded into the latest one and the whole
+     * move reaches LVGL in this period. Every report still goes through the gesture
+     * engine, which works on their timestamps. A press or release ends the fold and the
+     * rest is read again right away, so a short tap between two polls is not lost. */
+    while (touch_ring_pop(&g_ring, &frame)) {
+        lv_indev_state_t prev = g_state;
+
+        if (touch_gesture_process(&g_gesture, &frame, &gesture)) {
+            touch_send_gesture(&gesture);
+        }
+        touch_update_pointer(indev, &frame);
+        if (g_state != prev) {
+            data->continue_reading = touch_ring_count(&g_ring) > 0;
+            break;
+        }
+    }
+
+    data->point = g_point;
+    data->state = g_state;
+}
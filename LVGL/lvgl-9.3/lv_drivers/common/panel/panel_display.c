@@ -0,0 +1,508 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ameba_soc.h"
+#include "os_wrapper.h"
+
+#include "lvgl.h"
+#include "panel_display.h"
+
+#define LOG_TAG "Panel"
+
+#define PANEL_MAX_BUFFERS   3
+
+#ifndef PANEL_PARTIAL_BUF_LINES
+#define PANEL_PARTIAL_BUF_LINES 32      // height of the partial mode buffers
+#endif
+
+#ifndef PANEL_AREA_ALIGN
+#define PANEL_AREA_ALIGN        8       // invalidated areas are widened to this grid
+#endif
+
+/*
+ * Before a flush is started the previous one has to be done: the bus is free and,
+ * for scan-out panels, the previous buffer is latched. Transfer panels return right
+ * away so LVGL renders into the other buffer while this one is sent. A scan-out
+ * panel with two buffers also waits after the flip, as LVGL renders into the buffer
+ * on screen next.
+ */
+/*
+ * Scroll offload: rows top..top + height - 1 are the panel scroll area. Screen row y
+ * of it is frame memory line top + (y - top + offset) % height, so a scroll step only
+ * moves offset and the rows it exposes are rendered.
+ */
+typedef struct {
+    lv_obj_t *obj;
+    int32_t top;
+    int32_t height;
+    int32_t offset;
+    int32_t scroll_y;           // of obj when offset was last moved
+    int32_t shift;              // rows moved since the last refresh, positive upwards
+    bool step;                  // scroll step not refreshed yet
+    bool cut;                   // the invalidation of obj that follows LV_EVENT_SCROLL is pending
+    bool frame;                 // this refresh follows a scroll step
+    uint64_t frame_start_bytes;
+} panel_scroll_t;
+
+typedef struct {
+    const panel_ops_t *ops;
+    panel_caps_t caps;
+    uint8_t *buffers[PANEL_MAX_BUFFERS];
+    uint8_t buffer_count;
+    uint16_t buffer_lines;
+    uint8_t px_size;
+    uint8_t *front;
+    lv_display_t *display;
+    bool partial;
+    rtos_sema_t done_sema;
+    volatile bool busy;
+    panel_scroll_t scroll;
+    panel_display_stats_t stats;
+} panel_display_context_t;
+
+static panel_display_context_t panel_ctx = {0};
+
+static void panel_display_done(void *user_data) {
+    panel_display_context_t *ctx = (panel_display_context_t *)user_data;
+    if (ctx->busy) {
+        ctx->busy = false;
+        rtos_sema_give(ctx->done_sema);
+    }
+}
+
+static void panel_display_wait(void) {
+    uint32_t start = rtos_time_get_current_system_time_ms();
+    while (panel_ctx.busy) {
+        rtos_sema_take(panel_ctx.done_sema, RTOS_MAX_TIMEOUT);
+    }
+    panel_ctx.stats.wait_time_ms += rtos_time_get_current_system_time_ms() - start;
+}
+
+static void panel_display_send_area(uint8_t *buf, int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
+    panel_display_wait();
+    panel_ctx.busy = true;
+    panel_ctx.ops->flush_area(buf, x1, y1, x2, y2);
+    panel_ctx.stats.area_flushes++;
+}
+
+// Send the rows of an area to where the scroll offset puts them in frame memory
+static void panel_display_send_scrolled(uint8_t *px_map, const lv_area_t *area) {
+    panel_scroll_t *scroll = &panel_ctx.scroll;
+    int32_t line_size = lv_area_get_width(area) * panel_ctx.px_size;
+    int32_t y = area->y1;
+
+    while (y <= area->y2) {
+        uint8_t *buf = px_map + (y - area->y1) * line_size;
+        int32_t end;
+        int32_t line;
+
+        if (y < scroll->top) {
+            end = LV_MIN(area->y2, scroll->top - 1);
+            line = y;
+        } else if (y >= scroll->top + scroll->height) {
+            end = area->y2;
+            line = y;
+        } else {
+            // Up to the end of the area, the scroll area or the wrap in frame memory
+            line = scroll->top + (y - scroll->top + scroll->offset) % scroll->height;
+            end = LV_MIN(area->y2, scroll->top + scroll->height - 1);
+            end = LV_MIN(end, y + (scroll->top + scroll->height - 1 - line));
+        }
+
+        panel_display_send_area(buf, area->x1, line, area->x2, line + end - y);
+        y = end + 1;
+    }
+}
+
+static void panel_display_flush(lv_display_t *display, const lv_area_t *area, uint8_t *px_map) {
+    if (panel_ctx.scroll.obj) {
+        panel_display_send_scrolled(px_map, area);
+    } else if (panel_ctx.partial) {
+        panel_display_send_area(px_map, area->x1, area->y1, area->x2, area->y2);
+    } else {
+        panel_display_wait();
+        panel_ctx.busy = true;
+        panel_ctx.ops->flush_full(px_map);
+        panel_ctx.stats.full_flushes++;
+    }
+    panel_ctx.front = px_map;
+    panel_ctx.stats.bytes += lv_area_get_size(area) * panel_ctx.px_size;
+
+    if ((panel_ctx.caps.flags & PANEL_CAP_SCANOUT) && panel_ctx.buffer_count == 2) {
+        panel_display_wait();
+    }
+
+    lv_display_flush_ready(display);
+}
+
+/*
+ * Widen invalidated areas to a PANEL_AREA_ALIGN grid. Rects a few pixels apart then
+ * overlap and LVGL joins them, so fewer windows are sent and each costs a CASET/RASET
+ * command sequence less. With scroll offload, the invalidation of the scroll step itself
+ * is cut down to the exposed rows first.
+ */
+static void panel_display_invalidate_cb(lv_event_t *e) {
+    lv_area_t *area = lv_event_get_param(e);
+
+    // LVGL invalidates the whole object after LV_EVENT_SCROLL. The rest of the scroll area
+    // is still in frame memory, only the exposed rows are redrawn. Anything else that
+    // changed (pressed state, animations in the list) is sent as it is.
+    panel_scroll_t *scroll = &panel_ctx.scroll;
+    if (scroll->cut && area->y1 <= scroll->top && area->y2 >= scroll->top + scroll->height - 1) {
+        scroll->cut = false;
+        lv_area_t exposed = {0, scroll->top, panel_ctx.caps.width - 1, scroll->top + scroll->height - 1};
+        int32_t rows = LV_MIN(LV_ABS(scroll->shift), scroll->height);
+        if (scroll->shift > 0) {
+            exposed.y1 = exposed.y2 - rows + 1;
+        } else {
+            exposed.y2 = exposed.y1 + rows - 1;
+        }
+        lv_area_intersect(area, area, &exposed);
+    }
+
+    area->x1 &= ~(PANEL_AREA_ALIGN - 1);
+    area->y1 &= ~(PANEL_AREA_ALIGN - 1);
+    area->x2 = LV_MIN(area->x2 | (PANEL_AREA_ALIGN - 1), panel_ctx.caps.width - 1);
+    area->y2 = LV_MIN(area->y2 | (PANEL_AREA_ALIGN - 1), panel_ctx.caps.height - 1);
+}
+
+static void panel_display_scroll_cb(lv_event_t *e) {
+    LV_UNUSED(e);
+    panel_scroll_t *scroll = &panel_ctx.scroll;
+    int32_t scroll_y = lv_obj_get_scroll_y(scroll->obj);
+    int32_t dy = scroll_y - scroll->scroll_y;
+
+    if (!dy) {
+        return;
+    }
+    scroll->scroll_y = scroll_y;
+    scroll->offset = ((scroll->offset + dy) % scroll->height + scroll->height) % scroll->height;
+    scroll->shift += dy;
+    scroll->step = true;
+    scroll->cut = true;
+}
+
+// The new offset is used by this refresh, the panel switches to it once it is sent
+static void panel_display_refr_cb(lv_event_t *e) {
+    panel_scroll_t *scroll = &panel_ctx.scroll;
+
+    if (lv_event_get_code(e) == LV_EVENT_REFR_START) {
+        scroll->frame = scroll->step;
+        scroll->step = false;
+        scroll->cut = false;
+        scroll->shift = 0;
+        scroll->frame_start_bytes = panel_ctx.stats.bytes;
+        return;
+    }
+
+    if (scroll->frame) {
+        scroll->frame = false;
+        panel_display_wait();
+        panel_ctx.ops->set_scroll_start(scroll->top + scroll->offset);
+        panel_ctx.stats.scroll_frames++;
+        panel_ctx.stats.scroll_bytes += panel_ctx.stats.bytes - scroll->frame_start_bytes;
+        panel_ctx.stats.scroll_full_bytes += (uint64_t)panel_ctx.caps.width * scroll->height * panel_ctx.px_size;
+    }
+}
+
+static void panel_display_scroll_delete_cb(lv_event_t *e);
+
+static void panel_display_scroll_stop(bool obj_valid) {
+    panel_scroll_t *scroll = &panel_ctx.scroll;
+
+    if (obj_valid) {
+        lv_obj_remove_event_cb(scroll->obj, panel_display_scroll_cb);
+        lv_obj_remove_event_cb(scroll->obj, panel_display_scroll_delete_cb);
+    }
+    lv_display_remove_event_cb_with_user_data(panel_ctx.display, panel_display_refr_cb, NULL);
+
+    // Back to the normal display, the whole area has to be sent unshifted again
+    panel_display_wait();
+    panel_ctx.ops->set_scroll_area(0, panel_ctx.caps.height);
+    panel_ctx.ops->set_scroll_start(0);
+    lv_area_t area = {0, scroll->top, panel_ctx.caps.width - 1, scroll->top + scroll->height - 1};
+    memset(scroll, 0, sizeof(*scroll));
+    lv_inv_area(panel_ctx.display, &area);
+}
+
+static void panel_display_scroll_delete_cb(lv_event_t *e) {
+    LV_UNUSED(e);
+    panel_display_scroll_stop(false);
+}
+
+static bool panel_display_pick_format(panel_format_t *format, lv_color_format_t *cf) {
+    switch (LV_COLOR_DEPTH) {
+        case 16:
+            *format = PANEL_FORMAT_RGB565;
+            *cf = LV_COLOR_FORMAT_RGB565;
+            break;
+        case 24:
+            *format = PANEL_FORMAT_RGB888;
+            *cf = LV_COLOR_FORMAT_RGB888;
+            break;
+        default:
+            *format = PANEL_FORMAT_ARGB8888;
+            *cf = LV_COLOR_FORMAT_ARGB8888;
+            break;
+    }
+
+    return (panel_ctx.caps.formats & *format) != 0;
+}
+
+lv_display_t *panel_display_create(const panel_ops_t *ops, uint8_t buffer_count) {
+    panel_format_t format;
+    lv_color_format_t cf;
+
+    if (panel_ctx.ops) {
+        RTK_LOGE(LOG_TAG, "Already created\n");
+        return NULL;
+    }
+
+    if (buffer_count < 2 || buffer_count > PANEL_MAX_BUFFERS) {
+        RTK_LOGE(LOG_TAG, "Unsupported buffer count: %d\n", buffer_count);
+        return NULL;
+    }
+
+    ops->get_caps(&panel_ctx.caps);
+    if (!panel_display_pick_format(&format, &cf)) {
+        RTK_LOGE(LOG_TAG, "%s doesn't support color depth %d\n", panel_ctx.caps.name, LV_COLOR_DEPTH);
+        return NULL;
+    }
+
+    if (ops->init(format) != 0) {
+        RTK_LOGE(LOG_TAG, "%s init failed\n", panel_ctx.caps.name);
+        return NULL;
+    }
+
+    panel_ctx.partial = (panel_ctx.caps.flags & PANEL_CAP_PARTIAL_UPDATE) && ops->flush_area;
+
+    // Partial mode renders each area in one go, a band of lines is enough
+    uint32_t stride = lv_draw_buf_width_to_stride(panel_ctx.caps.width, cf);
+    uint32_t buffer_lines = panel_ctx.partial ? LV_MIN(PANEL_PARTIAL_BUF_LINES, panel_ctx.caps.height) :
+                            panel_ctx.caps.height;
+    uint32_t buffer_size = stride * buffer_lines;
+    panel_ctx.buffer_lines = buffer_lines;
+    panel_ctx.px_size = lv_color_format_get_size(cf);
+    for (int i = 0; i < buffer_count; i++) {
+        panel_ctx.buffers[i] = malloc(buffer_size);
+        if (!panel_ctx.buffers[i]) {
+            RTK_LOGE(LOG_TAG, "Alloc display buffer %d fail\n", i);
+            goto err_finish;
+        }
+        memset(panel_ctx.buffers[i], 0, buffer_size);
+    }
+    panel_ctx.buffer_count = buffer_count;
+
+    rtos_sema_create(&panel_ctx.done_sema, 0, RTOS_SEMA_MAX_COUNT);
+    panel_ctx.ops = ops;
+    ops->register_done_cb(panel_display_done, &panel_ctx);
+
+    lv_display_t *display = lv_display_create(panel_ctx.caps.width, panel_ctx.caps.height);
+    lv_display_set_color_format(display, cf);
+    lv_display_set_flush_cb(display, panel_display_flush);
+    lv_display_set_buffers(display, panel_ctx.buffers[0], panel_ctx.buffers[1], buffer_size,
+                           panel_ctx.partial ? LV_DISPLAY_RENDER_MODE_PARTIAL : LV_DISPLAY_RENDER_MODE_FULL);
+
+    if (panel_ctx.partial) {
+        lv_display_add_event_cb(display, panel_display_invalidate_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+    }
+
+    // LVGL has no third buffer in partial mode, the areas are sent as they are rendered
+    if (buffer_count > 2 && !panel_ctx.partial) {
+        static lv_draw_buf_t buf3;
+        lv_draw_buf_init(&buf3, panel_ctx.caps.width, panel_ctx.caps.height, cf, stride,
+                         panel_ctx.buffers[2], buffer_size);
+        lv_display_set_3rd_draw_buffer(display, &buf3);
+    }
+
+    panel_ctx.display = display;
+    RTK_LOGI(LOG_TAG, "%s: %dx%d, %d buffers of %lu bytes, %s updates\n", panel_ctx.caps.name,
+             panel_ctx.caps.width, panel_ctx.caps.height, buffer_count, (unsigned long)buffer_size,
+             panel_ctx.partial ? "partial" : "full");
+
+    return display;
+
+err_finish:
+    for (int i = 0; i < PANEL_MAX_BUFFERS; i++) {
+        if (panel_ctx.buffers[i]) {
+            free(panel_ctx.buffers[i]);
+        }
+    }
+    memset(&panel_ctx, 0, sizeof(panel_ctx));
+
+    return NULL;
+}
+
+void panel_display_get_caps(panel_caps_t *caps) {
+    *caps = panel_ctx.caps;
+}
+
+uint8_t *panel_display_get_buffer(int buffer_id) {
+    if (buffer_id >= 0 && buffer_id < panel_ctx.buffer_count) {
+        return panel_ctx.buffers[buffer_id];
+    }
+    return NULL;
+}
+
+uint8_t *panel_display_get_front_buffer(void) {
+    return panel_ctx.front ? panel_ctx.front : panel_ctx.buffers[0];
+}
+
+void panel_display_get_stats(panel_display_stats_t *stats) {
+    *stats = panel_ctx.stats;
+}
+
+// One full screen transfer from buffer 0, in buffer_lines bands for partial panels
+static void panel_display_send_frame(void) {
+    int width = panel_ctx.caps.width;
+    int height = panel_ctx.caps.height;
+
+    if (panel_ctx.partial) {
+        for (int y = 0; y < height; y += panel_ctx.buffer_lines) {
+            panel_display_wait();
+            panel_ctx.busy = true;
+            panel_ctx.ops->flush_area(panel_ctx.buffers[0], 0, y, width - 1,
+                                      LV_MIN(y + panel_ctx.buffer_lines, height) - 1);
+        }
+    } else {
+        panel_display_wait();
+        panel_ctx.busy = true;
+        panel_ctx.ops->flush_full(panel_ctx.buffers[0]);
+    }
+    panel_display_wait();
+}
+
+int panel_display_bus_benchmark(int frames, panel_display_bus_result_t *results, int max_results) {
+    const panel_ops_t *ops = panel_ctx.ops;
+    panel_bus_caps_t *bus_caps = &panel_ctx.caps.bus;
+    if (!ops || !ops->set_bus || !ops->get_bus || frames <= 0) {
+        return 0;
+    }
+
+    panel_bus_config_t best;
+    uint32_t best_fps = 0;
+    int count = 0;
+    ops->get_bus(&best);
+
+    for (uint8_t lanes = 1; lanes <= 4; lanes <<= 1) {
+        // PANEL_LANES_n is n for 1, 2 and 4 lanes
+        if (!(bus_caps->lanes & lanes)) {
+            continue;
+        }
+        for (uint8_t ddr = 0; ddr <= bus_caps->ddr; ddr++) {
+            // Clock from the max down in quarters
+            for (int quarter = 4; quarter >= 1 && count < max_results; quarter--) {
+                panel_display_bus_result_t *result = &results[count++];
+                memset(result, 0, sizeof(*result));
+                result->bus.clock_hz = bus_caps->max_clock_hz / 4 * quarter;
+                result->bus.lanes = lanes;
+                result->bus.ddr = ddr;
+
+                if (ops->set_bus(&result->bus) != 0) {
+                    result->self_test = -1;
+                    continue;
+                }
+                ops->get_bus(&result->bus);    // the clock the divider gave
+                result->calc_fps_x10 = panel_bus_fps_x10(&result->bus, panel_ctx.caps.width,
+                                                         panel_ctx.caps.height, panel_ctx.px_size);
+                result->self_test = ops->self_test ? ops->self_test() : 1;
+                if (result->self_test < 0) {
+                    RTK_LOGW(LOG_TAG, "bus %lu Hz x%d%s: self-test failed\n", result->bus.clock_hz,
+                             lanes, ddr ? " DDR" : "");
+                    continue;
+                }
+
+                uint32_t start = rtos_time_get_current_system_time_ms();
+                for (int i = 0; i < frames; i++) {
+                    panel_display_send_frame();
+                }
+                uint32_t elapsed = rtos_time_get_current_system_time_ms() - start;
+                result->fps_x10 = elapsed ? frames * 10000 / elapsed : 0;
+
+                RTK_LOGI(LOG_TAG, "bus %lu Hz x%d%s: %lu.%lu fps max, %lu.%lu fps measured%s\n",
+                         result->bus.clock_hz, lanes, ddr ? " DDR" : "",
+                         result->calc_fps_x10 / 10, result->calc_fps_x10 % 10,
+                         result->fps_x10 / 10, result->fps_x10 % 10,
+                         result->self_test ? ", not verified" : "");
+
+                // Only a setup the panel read back correctly replaces the current one
+                if (result->self_test == 0 && result->fps_x10 > best_fps) {
+                    best_fps = result->fps_x10;
+                    best = result->bus;
+                }
+            }
+        }
+    }
+
+    ops->set_bus(&best);
+    RTK_LOGI(LOG_TAG, "bus set to %lu Hz x%d%s\n", best.clock_hz, best.lanes, best.ddr ? " DDR" : "");
+
+    // The frames sent over whatever was on screen
+    if (panel_ctx.display) {
+        lv_obj_invalidate(lv_display_get_screen_active(panel_ctx.display));
+    }
+    return count;
+}
+
+lv_result_t panel_display_set_scroll_offload(lv_obj_t *obj) {
+    panel_scroll_t *scroll = &panel_ctx.scroll;
+    const panel_ops_t *ops = panel_ctx.ops;
+
+    if (scroll->obj) {
+        panel_display_scroll_stop(true);
+    }
+
+    if (!obj) {
+        return LV_RESULT_OK;
+    }
+
+    if (!ops || !panel_ctx.partial || !(panel_ctx.caps.flags & PANEL_CAP_HW_SCROLL) ||
+        lv_display_get_rotation(panel_ctx.display) != LV_DISPLAY_ROTATION_0) {
+        return LV_RESULT_INVALID;
+    }
+
+    lv_area_t coords;
+    lv_obj_update_layout(obj);
+    lv_obj_get_coords(obj, &coords);
+    if (coords.x1 > 0 || coords.x2 < panel_ctx.caps.width - 1 || coords.y1 < 0 ||
+        coords.y2 >= panel_ctx.caps.height) {
+        RTK_LOGW(LOG_TAG, "scroll offload needs a full width object on screen\n");
+        return LV_RESULT_INVALID;
+    }
+
+    panel_display_wait();
+    if (ops->set_scroll_area(coords.y1, lv_area_get_height(&coords)) != 0) {
+        return LV_RESULT_INVALID;
+    }
+    ops->set_scroll_start(coords.y1);
+
+    scroll->obj = obj;
+    scroll->top = coords.y1;
+    scroll->height = lv_area_get_height(&coords);
+    scroll->scroll_y = lv_obj_get_scroll_y(obj);
+
+    // A scrollbar would move with the content
+    lv_obj_set_scrollbar_mode(obj, LV_SCROLLBAR_MODE_OFF);
+    lv_obj_add_event_cb(obj, panel_display_scroll_cb, LV_EVENT_SCROLL, NULL);
+    lv_obj_add_event_cb(obj, panel_display_scroll_delete_cb, LV_EVENT_DELETE, NULL);
+    lv_display_add_event_cb(panel_ctx.display, panel_display_refr_cb, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(panel_ctx.display, panel_display_refr_cb, LV_EVENT_REFR_READY, NULL);
+
+    RTK_LOGI(LOG_TAG, "scroll offload on lines %ld..%ld\n", scroll->top, scroll->top + scroll->height - 1);
+    return LV_RESULT_OK;
+}
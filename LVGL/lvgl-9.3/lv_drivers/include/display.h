@@ -5,11 +5,91 @@
 
 #include "lvgl.h"
 
+typedef struct {
+    uint32_t frames;            // frames submitted by LVGL
+    uint32_t flips;             // flips completed by the LCDC
+    uint32_t fps;               // submitted frames per second, last second
+    uint32_t stall_time_ms;     // render thread blocked waiting for flips, total
+    uint32_t stall_max_us;      // longest single wait
+    uint32_t sync_kpx;          // pixels copied between framebuffers in direct sync mode, in 1000s
+    uint32_t vsync_period_us;   // measured LCDC frame period
+    uint32_t frame_interval_us; // between the last two completed flips
+    uint32_t frame_interval_max_us;
+    uint32_t missed_vsyncs;     // frames submitted after the frame done they were scheduled for
+    uint32_t render_time_us;    // vsync scheduler estimate
+    uint32_t underflows;        // LCDC scan-out DMA underflows since init
+    uint32_t underflow_last_ms; // system time of the last one
+    uint32_t throttled_frames;  // refreshes and jobs delayed to a frame done by DISPLAY_UNDERFLOW_THROTTLE
+    uint8_t dma_burst_size;
+    uint32_t idle_time_ms;      // spent in idle mode
+    uint32_t idle_entries;
+    uint8_t idle_residency;     // idle time since init or reset, percent
+    uint8_t buffer_count;
+} display_stats_t;
+
 bool display_init(uint16_t bpp, uint32_t width, uint32_t height);
+// buffer_count 2: double buffering, 3: triple buffering, rendering continues while a flip is pending
+bool display_init_with_buffers(uint16_t bpp, uint32_t width, uint32_t height, uint8_t buffer_count);
 void display_set_lv_display(lv_display_t *display);
 void display_get_info(uint32_t *width, uint32_t *height);
 uint8_t *display_get_buffer(int buffer_id);
+uint8_t display_get_buffer_count(void);
+void display_get_stats(display_stats_t *stats);
+void display_reset_stats(void);
 void display_flush_full(lv_display_t * display, const lv_area_t * area, void * px_map);
 void display_flush_direct(lv_display_t *display, const lv_area_t *area, void *px_map);
 
+// Scan line that completes flips, earlier lines return the old buffer sooner
+bool display_set_flip_line(uint32_t line);
+// Start LVGL refreshes so a frame is submitted just before the next frame done
+void display_enable_vsync_scheduler(bool enable);
+
+// Underflow policy flags, what to do when the scan-out DMA can't keep up
+#define DISPLAY_UNDERFLOW_RAISE_BURST   (1 << 0)    // longer LCDC DMA bursts, one step per underflow
+#define DISPLAY_UNDERFLOW_THROTTLE      (1 << 1)    // PPE/JPEG work of a refresh starts at frame done, for a while
+
+// Called from the LCDC interrupt with the total underflow count
+typedef void (*display_underflow_cb_t)(uint32_t count, void *user_data);
+void display_set_underflow_policy(uint32_t policy, display_underflow_cb_t cb, void *user_data);
+// Called before PPE draw tasks and JPEG hardware decodes, delays them while throttling.
+// Not for the display's own buffer copies.
+void display_bandwidth_wait(void);
+
+/*
+ * Idle mode: after idle_frames LVGL refreshes with nothing to draw, the refresh timer
+ * (and with pause_input the input device read timers) are paused. Invalidating any
+ * area, e.g. from an animation or timer, resumes them. Paused input must be woken by
+ * display_idle_wake() from its interrupt. idle_frames 0 disables idle mode.
+ */
+void display_set_idle_mode(uint32_t idle_frames, bool pause_input);
+// Sleep in the LVGL task until the next timer is due (ms from lv_timer_handler) or a wake
+void display_idle_wait(uint32_t ms);
+// Safe from interrupts
+void display_idle_wake(void);
+
+// Direct mode where the driver rotates the framebuffers and copies each frame's
+// redrawn areas to the next back buffer (with the PPE if use_ppe), instead of LVGL
+void display_setup_direct_sync(lv_display_t *display, bool use_ppe);
+void display_flush_direct_sync(lv_display_t *display, const lv_area_t *area, void *px_map);
+
+/*
+ * Hardware planes below the LVGL layer, on LCDCs with several layers (amebasmart).
+ * Plane buffers are scanned out directly and never re-blended by LVGL. The screen
+ * must leave them visible: a transparent background with LV_COLOR_DEPTH 32, or
+ * DISPLAY_PLANE_KEY_COLOR with LV_COLOR_DEPTH 16 where LVGL uses color keying.
+ * area NULL covers the whole screen, the buffer stride is the area width.
+ * cf is RGB565 or ARGB8888, whose alpha is blended with the planes below.
+ */
+#define DISPLAY_PLANE_KEY_COLOR 0xFF00FF
+
+typedef enum {
+    DISPLAY_PLANE_BACKGROUND,   // e.g. a static wallpaper
+    DISPLAY_PLANE_VIDEO,        // above the background, e.g. decoded MJPEG frames
+} display_plane_t;
+
+int display_plane_show(display_plane_t plane, uint8_t *buffer, lv_color_format_t cf, const lv_area_t *area);
+// Swap the buffer of a shown plane, e.g. the next video frame, at the next frame
+void display_plane_set_buffer(display_plane_t plane, uint8_t *buffer);
+void display_plane_hide(display_plane_t plane);
+
 #endif /* UI_LVGL_LV_DRIVERS_DISPLAY */
@@ -16,16 +16,99 @@
 #ifndef AMEBA_UI_LVGL_LV_DRIVERS_JPEG_DECODER_H
 #define AMEBA_UI_LVGL_LV_DRIVERS_JPEG_DECODER_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lvgl.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t entries;
+    uint32_t used_size;         /**< Bytes held by cached draw buffers */
+    uint32_t max_size;          /**< Byte budget of the cache */
+} lv_ameba_jpeg_cache_stats_t;
+
 /**
  * Register ameba jpeg decoder functions in LVGL
  */
 void lv_ameba_jpeg_init(void);
 void lv_ameba_jpeg_deinit(void);
 
+/**
+ * Keep decoded images in NV12 (1.5 bytes per pixel) instead of RGB. The visible part is
+ * converted to RGB by the PPE draw unit at draw time; rotated, scaled, recolored or
+ * faded images are converted on the CPU, so prefer the decode scale hints for sizing.
+ * Needs the PPE draw unit (LV_USE_DRAW_PPE, lv_draw_ppe_init()), decodes stay RGB
+ * without it. Changing the mode drops the decoded image caches.
+ */
+void lv_ameba_jpeg_set_output_yuv(bool enable);
+
+/**
+ * Images whose decode would take more than size bytes (unscaled ones only) are not
+ * decoded as a whole, every draw decodes just the visible area (MCU aligned) instead.
+ * Saves memory for large panoramas or map tiles at the cost of decoding on each draw.
+ * 0 disables area decoding. Default JPEG_ROI_DEF_THRESHOLD.
+ */
+void lv_ameba_jpeg_set_roi_threshold(uint32_t size);
+
+/**
+ * Set the byte budget of the decoded image cache, 0 disables caching
+ */
+void lv_ameba_jpeg_cache_set_size(uint32_t max_size);
+
+/**
+ * Drop the cached decode of src (path or lv_image_dsc_t), NULL drops all unused entries
+ */
+void lv_ameba_jpeg_cache_drop(const void *src);
+
+/**
+ * Get hit/miss/eviction counters of the decoded image cache
+ */
+void lv_ameba_jpeg_cache_get_stats(lv_ameba_jpeg_cache_stats_t *stats);
+
+/**
+ * Decode src downscaled instead of letting LVGL scale the full image at draw time.
+ * scale uses LVGL units (LV_SCALE_NONE = 1x, only downscaling applies) and is rounded
+ * up to 1/8 steps. Set it before the source is given to an lv_image, or use
+ * lv_ameba_jpeg_image_apply_scale(). LV_SCALE_NONE removes the hint.
+ */
+void lv_ameba_jpeg_set_decode_scale(const void *src, uint32_t scale);
+
+/**
+ * Decode src downscaled to fit in max_w x max_h, 0 x 0 removes the hint
+ */
+void lv_ameba_jpeg_set_decode_size(const void *src, uint32_t max_w, uint32_t max_h);
+
+/**
+ * Move the current lv_image scale of img into the decoder, so the JPEG is decoded
+ * at (about) the displayed size and the image is shown with scale LV_SCALE_NONE.
+ */
+void lv_ameba_jpeg_image_apply_scale(lv_obj_t *img);
+
+/**
+ * Set the source of img and decode it on the JPEG worker thread instead of the
+ * render thread. The placeholder is shown until the decode is done, then img is
+ * updated and invalidated. Deleting img or setting a new source cancels the job.
+ * Falls back to lv_image_set_src() when the LVGL image cache is enabled.
+ */
+void lv_ameba_jpeg_image_set_src_async(lv_obj_t *img, const void *src);
+
+/**
+ * Cancel a pending async decode for img
+ */
+void lv_ameba_jpeg_async_cancel(lv_obj_t *img);
+
+/**
+ * Image source shown while an async decode is pending, NULL to keep the old image
+ */
+void lv_ameba_jpeg_async_set_placeholder(const void *src);
+
 #ifdef __cplusplus
 }
 #endif
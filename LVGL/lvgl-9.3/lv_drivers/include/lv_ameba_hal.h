@@ -24,6 +24,12 @@ extern "C" {
 
 void lv_ameba_hal_init(void);
 
+/* Sleep between lv_task_handler calls, ms is its return value (may be LV_NO_TIMER_READY) */
+void lv_ameba_hal_wait(uint32_t ms);
+
+/* Wake lv_ameba_hal_wait early, e.g. from a touch interrupt. Safe from interrupts. */
+void lv_ameba_hal_wake(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -70,6 +70,11 @@ void lv_draw_ppe_init(void);
  */
 void lv_draw_ppe_configure_and_start_transfer(lv_draw_ppe_configuration_t *ppe_draw_conf);
 
+/**
+ * @brief Whether the PPE draw unit was created, the only one that draws NV12 images
+ */
+bool lv_draw_ppe_is_inited(void);
+
 /**
  * @brief Deinitialize the PPE draw unit
  */
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_UI_LVGL_LV_DRIVERS_MJPEG_PLAYER_H
+#define AMEBA_UI_LVGL_LV_DRIVERS_MJPEG_PLAYER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct lv_ameba_mjpeg_player lv_ameba_mjpeg_player_t;
+
+typedef struct {
+    uint32_t frames_decoded;
+    uint32_t frames_shown;
+    uint32_t frames_dropped;     /**< Skipped without decoding to keep up with the frame rate */
+    uint32_t late_ticks;         /**< Frame periods where the next frame was not ready yet */
+    uint32_t decode_errors;
+    uint32_t decode_time_last;   /**< ms */
+    uint32_t decode_time_max;    /**< ms */
+} lv_ameba_mjpeg_player_stats_t;
+
+/**
+ * Create an MJPEG player showing its frames in a new lv_image on parent.
+ * Frames are decoded on a worker thread into two buffers, frame N+1 is decoded
+ * while N is shown. Requires lv_ameba_jpeg_init(). Deleting the image (or its
+ * parent) deletes the player.
+ */
+lv_ameba_mjpeg_player_t *lv_ameba_mjpeg_player_create(lv_obj_t *parent);
+void lv_ameba_mjpeg_player_delete(lv_ameba_mjpeg_player_t *player);
+
+/**
+ * Get the lv_image the frames are shown in, to position or style it
+ */
+lv_obj_t *lv_ameba_mjpeg_player_get_obj(lv_ameba_mjpeg_player_t *player);
+
+/**
+ * Play a file (e.g. on romfs) or a memory buffer of concatenated JPEG frames.
+ * Stops the current playback, call lv_ameba_mjpeg_player_play() to start.
+ */
+lv_result_t lv_ameba_mjpeg_player_set_src_file(lv_ameba_mjpeg_player_t *player, const char *path);
+lv_result_t lv_ameba_mjpeg_player_set_src_data(lv_ameba_mjpeg_player_t *player, const uint8_t *data, uint32_t size);
+
+/**
+ * Target frame rate, frames that can't be decoded in time are dropped. Default 25.
+ */
+void lv_ameba_mjpeg_player_set_fps(lv_ameba_mjpeg_player_t *player, uint32_t fps);
+
+/**
+ * Restart from the first frame at the end of the stream, otherwise LV_EVENT_READY
+ * is sent to the image and playback stops on the last frame
+ */
+void lv_ameba_mjpeg_player_set_loop(lv_ameba_mjpeg_player_t *player, bool loop);
+
+void lv_ameba_mjpeg_player_play(lv_ameba_mjpeg_player_t *player);
+void lv_ameba_mjpeg_player_pause(lv_ameba_mjpeg_player_t *player);
+
+/**
+ * Stop and rewind to the first frame, the last shown frame stays on screen
+ */
+void lv_ameba_mjpeg_player_stop(lv_ameba_mjpeg_player_t *player);
+
+void lv_ameba_mjpeg_player_get_stats(lv_ameba_mjpeg_player_t *player, lv_ameba_mjpeg_player_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMEBA_UI_LVGL_LV_DRIVERS_MJPEG_PLAYER_H */
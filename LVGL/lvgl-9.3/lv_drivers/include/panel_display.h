@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AMEBA_UI_LVGL_LV_DRIVERS_PANEL_DISPLAY_H
+#define AMEBA_UI_LVGL_LV_DRIVERS_PANEL_DISPLAY_H
+
+#include <stdint.h>
+
+#include "lvgl.h"
+#include "panel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t full_flushes;
+    uint32_t area_flushes;
+    uint32_t wait_time_ms;      // render thread blocked on the panel, total
+    uint64_t bytes;             // pixel data sent
+    uint32_t scroll_frames;     // refreshes after scroll offload steps
+    uint64_t scroll_bytes;      // sent by those refreshes
+    uint64_t scroll_full_bytes; // the same refreshes redrawing the whole scroll area
+} panel_display_stats_t;
+
+typedef struct {
+    panel_bus_config_t bus;
+    uint32_t calc_fps_x10;      // full frames the bus carries, x10
+    uint32_t fps_x10;           // measured full frames, x10, 0 if not run
+    int self_test;              // 0 passed, -1 failed or setup refused, 1 panel can't read back
+} panel_display_bus_result_t;
+
+/**
+ * Flush engine shared by the panel drivers: initializes the panel in the format of
+ * LV_COLOR_DEPTH, allocates buffer_count (2 or 3) full screen buffers and creates the
+ * LVGL display. Panels with PANEL_CAP_PARTIAL_UPDATE get partial render mode instead:
+ * buffers of PANEL_PARTIAL_BUF_LINES lines, invalidated areas aligned to PANEL_AREA_ALIGN
+ * so close ones merge, and only the redrawn areas are sent.
+ */
+lv_display_t *panel_display_create(const panel_ops_t *ops, uint8_t buffer_count);
+void panel_display_get_caps(panel_caps_t *caps);
+uint8_t *panel_display_get_buffer(int buffer_id);
+/* Buffer of the last flush, the one on screen for scan-out panels */
+uint8_t *panel_display_get_front_buffer(void);
+void panel_display_get_stats(panel_display_stats_t *stats);
+
+/**
+ * Map the vertical scrolling of obj onto the panel hardware scroll (PANEL_CAP_HW_SCROLL,
+ * partial mode, no rotation). obj has to span the full width, its rows become the panel
+ * scroll area and a scroll step only renders and sends the exposed rows. Its scrollbar is
+ * turned off as it would move with the content. Content of obj shouldn't reach outside
+ * it (shadow, outline). NULL turns the offload off, deleting obj does too.
+ */
+lv_result_t panel_display_set_scroll_offload(lv_obj_t *obj);
+
+/**
+ * Walk the bus setups in the panel caps (lane counts, DDR, clock from the max down in
+ * quarters), self-test each and time frames full screen transfers. The fastest setup
+ * that passed the self-test is kept, panels without one keep their setup and only get
+ * the report. Run before LVGL draws and before TE sync, it writes over the screen.
+ * Returns the number of results, 0 for panels without bus setup.
+ */
+int panel_display_bus_benchmark(int frames, panel_display_bus_result_t *results, int max_results);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMEBA_UI_LVGL_LV_DRIVERS_PANEL_DISPLAY_H */
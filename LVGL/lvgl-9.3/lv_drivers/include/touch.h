@@ -5,5 +5,9 @@
 
 void touch_init(void);
 void touch_read(lv_indev_t * indev, lv_indev_data_t * data);
+/* LVGL event ID of multi-finger gestures, sent to the object under the fingers with a
+ * touch_gesture_t (touch_gesture.h) as parameter. Two finger scrolls also scroll the
+ * nearest scrollable object. */
+uint32_t touch_get_gesture_event(void);
 
 #endif
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+#include "os_wrapper.h"
 #include "i2c_api.h"
 #include "cst328.h"
 #include "gpio_api.h"
@@ -45,6 +46,8 @@
 static i2c_t g_obj;
 static cst328_touch_data_t g_cst328_touch_data;
 cst328_touch_data_callback g_cb = NULL;
+static touch_ring_t *g_ring;
+static touch_frame_t g_frame;
 
 static void CST328_read_reg(u16 reg, u8 *buf, u8 len)
 {
@@ -109,7 +112,8 @@ static int CST328_firmware_info(void)
     return 0;
 }
 
-static void CST328_touch_report(void)
+/* 1 if g_frame holds a new report */
+static int CST328_touch_report(void)
 {
     u8 i = 0;
     u8 i2c_buf[8];
@@ -133,6 +137,7 @@ static void CST328_touch_report(void)
         if (ret < 0) {
             printf("[cst328][err]Scan send read touch info ending failed\n");
         }
+        return 0;
     }
 
     cnt = buf[5] & 0x7F;
@@ -147,13 +152,16 @@ static void CST328_touch_report(void)
         if (ret < 0) {
             printf("[cst328][err]Scan send read touch info ending failed\n");
         }
-        return;
+        return 0;
     } else if (cnt == 0) {
-        return;
+        g_frame.count = 0;
+        return 1;
     }
 
     if (cnt > 0x01) { // touch cnt greater than one
-        printf("[cst328][err]Scan cnt: %d\n", cnt);
+        if (CST328_DEBUG) {
+            printf("[cst328][debug]Scan cnt: %d\n", cnt);
+        }
         i2c_len = (cnt - 1) * 5 + 1;
         len_1   = i2c_len;
         for (idx = 0; idx < i2c_len; idx += 6) {
@@ -188,7 +196,7 @@ static void CST328_touch_report(void)
             if (ret < 0) {
                 printf("[cst328][err]Scan send read touch info ending failed\n");
             }
-            return;
+            return 0;
         }
     }
 
@@ -202,6 +210,7 @@ static void CST328_touch_report(void)
     }
 
     idx = 0;
+    g_frame.count = 0;
     for (i = 0; i < cnt; i++) {
         input_x = (u16)((buf[idx + 1] << 4) | ((buf[idx + 3] >> 4) & 0x0F));
         input_y = (u16)((buf[idx + 2] << 4) | (buf[idx + 3] & 0x0F));
@@ -212,6 +221,11 @@ static void CST328_touch_report(void)
         }
 
         if (sw == 0x03) {   //touch pressed
+            touch_point_t *point = &g_frame.points[g_frame.count++];
+            point->id = buf[idx] >> 4;
+            point->x = XSIZE - input_x;
+            point->y = YSIZE - input_y;
+
             g_cst328_touch_data.x = XSIZE - input_x;
             g_cst328_touch_data.y = YSIZE - input_y;
             g_cst328_touch_data.state = TOUCH_PRESS;
@@ -225,13 +239,18 @@ static void CST328_touch_report(void)
         idx += 5;
     }
 
+    return 1;
 }
 
 void gpio_touch_irq_handler(uint32_t id, uint32_t event)
 {
     UNUSED(id);
     UNUSED(event);
-    CST328_touch_report();
+    int fresh = CST328_touch_report();
+    if (g_ring && fresh) {
+        g_frame.time_ms = rtos_time_get_current_system_time_ms();
+        touch_ring_push(g_ring, &g_frame);
+    }
     if (g_cb) {
         g_cb(g_cst328_touch_data);
     }
@@ -280,3 +299,9 @@ void cst328_register_touch_data_callback(cst328_touch_data_callback cb)
 {
     g_cb = cb;
 }
+
+void cst328_register_touch_ring(touch_ring_t *ring)
+{
+    touch_ring_init(ring);
+    g_ring = ring;
+}
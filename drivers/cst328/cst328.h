@@ -2,6 +2,7 @@
 #define __CST328_H
 
 #include "lwip/sys.h"
+#include "touch_ring.h"
 
 typedef enum {
 	TOUCH_PRESS = 1,
@@ -18,5 +19,8 @@ typedef void (*cst328_touch_data_callback)(cst328_touch_data_t data);
 
 void cst328_init(void);
 void cst328_register_touch_data_callback(cst328_touch_data_callback cb);
+/* Every report with all fingers and their track IDs, pushed from the touch interrupt.
+ * The ring is initialized here, the caller is its only consumer. */
+void cst328_register_touch_ring(touch_ring_t *ring);
 
 #endif
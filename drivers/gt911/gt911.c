@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+#include "os_wrapper.h"
 #include "i2c_api.h"
 #include "i2c_ex_api.h"
 #include "gt911.h"
@@ -37,6 +38,8 @@
 #define GT_TP5_REG          0X8170
 
 #define TPD_MAX_FINGERS     5
+#define GT_POINT_SIZE       8
+#define GT_REPORT_SIZE      (1 + TPD_MAX_FINGERS * GT_POINT_SIZE)  //status and all points, from GT_GSTID_REG
 #define XSIZE               480
 #define YSIZE               480
 #define I2C_ADDR            0x14
@@ -44,6 +47,10 @@
 
 #define GT911_PATCH_FOR_LCD_NOISE 1
 
+/* The I2C reads run in this task, above the UI task so touch latency stays low */
+#define GT911_TASK_PRIORITY     6
+#define GT911_TASK_STACK_SIZE   4096
+
 const uint8_t GT911_CFG_TBL[] =
 {
     0X60, 0XE0, 0X01, 0XE0, 0X01, 0X05, 0X35, 0X00, 0X02, 0X08,
@@ -71,6 +78,13 @@ static i2c_t g_obj;
 static gt911_touch_data_t g_gt911_touch_data;
 gt911_touch_data_callback g_cb = NULL;
 
+static gpio_irq_t g_irq;
+static rtos_sema_t g_irq_sema;
+static volatile u64 g_irq_ns;
+static gt911_stats_t g_stats;
+static u8 g_write_buf[2 + sizeof(GT911_CFG_TBL)];
+static touch_ring_t *g_ring;
+
 static int GT911_read_reg(u16 reg, u8 *buf, u8 len)
 {
     u16 r;
@@ -89,17 +103,20 @@ static int GT911_read_reg(u16 reg, u8 *buf, u8 len)
     return i2c_read(&g_obj, I2C_ADDR, (char *)buf, len, 1);
 }
 
+/* Not reentrant, only called from init and the gt911 task */
 static int GT911_write_reg(u16 reg, u8 *buf, u8 len)
 {
-    u8 *temp;
+    u8 *temp = g_write_buf;
     int ret = 0;
-    temp =  malloc(len + 2);
+
+    if (len > sizeof(g_write_buf) - 2) {
+        return -1;
+    }
     temp[1] = reg & 0xff;
     temp[0] = (reg >> 8);
 
     memcpy(temp + 2, buf, len);
     ret = i2c_write(&g_obj, I2C_ADDR, (char *)temp, len + 2, 2);
-    free(temp);
 
     if (ret != (len + 2)) {
         RTK_LOGS(NOTAG, RTK_LOG_ALWAYS, "%s: Write to slave error. \r\n", __func__);
@@ -109,51 +126,38 @@ static int GT911_write_reg(u16 reg, u8 *buf, u8 len)
     return 1;
 }
 
-uint32_t GT911_read(uint8_t *buf, int len)
+/* Status and all points in one burst read, buf holds GT_REPORT_SIZE bytes.
+ * Returns the fingers down, 0 when all are up, -1 if there is no new report. */
+int GT911_read(uint8_t *buf, int len)
 {
-    uint8_t *read = buf;
-
-    uint8_t mode = 0;
-    uint8_t point_num = 0;
     uint8_t reset = 0;
     int ret = 0;
 
-    ret = GT911_read_reg(GT_GSTID_REG, &mode, 1);
-    if (ret < 0) {
-        RTK_LOGS(NOTAG, RTK_LOG_ALWAYS, "%s: Read mode fail. \r\n", __func__);
-        return 0;
+    if (len < GT_REPORT_SIZE) {
+        return -1;
     }
 
-    RTK_LOGS(NOTAG, RTK_LOG_DEBUG, "%s: mode: %x \r\n", __func__, mode);
-    read[0] = mode;
-    if (mode & 0x80) {
-        ret = GT911_write_reg(GT_GSTID_REG, &reset, 1); // clear flags
-        if (ret < 0) {
-            RTK_LOGS(NOTAG, RTK_LOG_ALWAYS, "%s: Slave no ACK. \r\n", __func__);
-            return 0;
-        }
-    } else {
-        return 0;
-    }
-    point_num = mode & 0x0F;
-    if (point_num == 0)
-    {
-        return 0;
+    ret = GT911_read_reg(GT_GSTID_REG, buf, GT_REPORT_SIZE);
+    if (ret < 0) {
+        RTK_LOGS(NOTAG, RTK_LOG_ALWAYS, "%s: Read report fail. \r\n", __func__);
+        g_stats.i2c_errors++;
+        return -1;
     }
 
-    len = GT911_read_reg(0x814F, read + 1, 7);
-    if (len < 0) {
-        RTK_LOGS(NOTAG, RTK_LOG_ALWAYS, "%s: Slave no response. \r\n", __func__);
-        return 0;
+    RTK_LOGS(NOTAG, RTK_LOG_DEBUG, "%s: mode: %x \r\n", __func__, buf[0]);
+    if (!(buf[0] & 0x80)) {
+        return -1;
     }
 
-    ret = GT911_write_reg(GT_GSTID_REG, &reset, 1);
+    ret = GT911_write_reg(GT_GSTID_REG, &reset, 1); // clear flags
     if (ret < 0) {
         RTK_LOGS(NOTAG, RTK_LOG_ALWAYS, "%s: Write reset fail. \r\n", __func__);
-        return 0;
+        g_stats.i2c_errors++;
+        return -1;
     }
 
-    return len;
+    ret = buf[0] & 0x0F;
+    return ret > TPD_MAX_FINGERS ? TPD_MAX_FINGERS : ret;
 }
 
 static int GT911_firmware_info(void)
@@ -170,30 +174,43 @@ static int GT911_firmware_info(void)
     return 0;
 }
 
-void transform_point(void)
+static void transform_point(u16 *x, u16 *y)
+{
+    u16 tx = *x;
+
+    *x = YSIZE - *y;
+    *y = tx;
+}
+
+/* Point i of a report: track ID, x, y (little endian), size, reserved */
+static void GT911_get_point(const uint8_t *buf, int i, touch_point_t *point)
 {
-    int x = g_gt911_touch_data.x;
-    int y = g_gt911_touch_data.y;
+    const uint8_t *p = buf + 1 + i * GT_POINT_SIZE;
 
-    g_gt911_touch_data.x = YSIZE - y;
-    g_gt911_touch_data.y = x;
+    point->id = p[0];
+    point->x = p[1] | (p[2] << 8);
+    point->y = p[3] | (p[4] << 8);
+    transform_point(&point->x, &point->y);
 }
 
 static void GT911_touch_report(void)
 {
     g_gt911_touch_data.state = TOUCH_RELEASE;
-    uint8_t buf[10] = {0};
+    static uint8_t buf[GT_REPORT_SIZE];
+    static touch_frame_t frame;
     g_gt911_touch_data.x = 480;
     g_gt911_touch_data.y = 480;
     static uint16_t x_old = 0;
     static uint16_t y_old = 0;
 
-    if (GT911_read(buf, 0)) {
-        g_gt911_touch_data.state = TOUCH_PRESS;
-        g_gt911_touch_data.x = (buf[2] | (buf[3] << 8));
-        g_gt911_touch_data.y = (buf[4] | (buf[5] << 8));
+    int cnt = GT911_read(buf, sizeof(buf));
+    if (cnt > 0) {
+        touch_point_t point;
 
-        transform_point();
+        GT911_get_point(buf, 0, &point);
+        g_gt911_touch_data.state = TOUCH_PRESS;
+        g_gt911_touch_data.x = point.x;
+        g_gt911_touch_data.y = point.y;
         x_old = g_gt911_touch_data.x;
         y_old = g_gt911_touch_data.y;
     } else {
@@ -201,16 +218,62 @@ static void GT911_touch_report(void)
         g_gt911_touch_data.y = y_old;
     }
     RTK_LOGS(NOTAG, RTK_LOG_DEBUG, "%s: (x, y) = (%d, %d) \r\n", __func__, x_old, y_old);
+
+    if (g_ring && cnt >= 0) {
+        frame.time_ms = rtos_time_get_current_system_time_ms();
+        frame.count = cnt;
+        for (int i = 0; i < cnt; i++) {
+            GT911_get_point(buf, i, &frame.points[i]);
+        }
+        touch_ring_push(g_ring, &frame);
+    }
 }
 
+/* Only wakes the task, the I2C transfers take long enough to delay other interrupts
+ * (LCDC line/frame done) */
 void gpio_touch_irq_handler(uint32_t id, uint32_t event)
 {
     UNUSED(id);
     UNUSED(event);
 
-    GT911_touch_report();
-    if (g_cb) {
-        g_cb(g_gt911_touch_data);
+    u64 start = rtos_time_get_current_system_time_ns();
+    g_stats.irq_count++;
+    if (rtos_sema_give(g_irq_sema) != SUCCESS) {
+        g_stats.coalesced++;
+    } else {
+        g_irq_ns = start;
+    }
+
+    u32 irq_ns = rtos_time_get_current_system_time_ns() - start;
+    if (irq_ns > g_stats.irq_max_ns) {
+        g_stats.irq_max_ns = irq_ns;
+    }
+}
+
+static void gt911_irq_task(void *param)
+{
+    UNUSED(param);
+
+    for (;;) {
+        rtos_sema_take(g_irq_sema, RTOS_MAX_TIMEOUT);
+
+        u64 start = rtos_time_get_current_system_time_ns();
+        u32 defer_us = (start - g_irq_ns) / 1000;
+        if (defer_us > g_stats.defer_max_us) {
+            g_stats.defer_max_us = defer_us;
+        }
+
+        GT911_touch_report();
+
+        u32 read_us = (rtos_time_get_current_system_time_ns() - start) / 1000;
+        if (read_us > g_stats.read_max_us) {
+            g_stats.read_max_us = read_us;
+        }
+        g_stats.read_avg_us = g_stats.read_avg_us ? (g_stats.read_avg_us * 7 + read_us) / 8 : read_us;
+
+        if (g_cb) {
+            g_cb(g_gt911_touch_data);
+        }
     }
 }
 
@@ -291,13 +354,29 @@ void gt911_init(void)
 
     GT911_firmware_info();
 
-    gpio_irq_t gpio_btn;
-    gpio_irq_init(&gpio_btn, INT_PIN, gpio_touch_irq_handler, (uint32_t)(&gpio_btn));
-    gpio_irq_set(&gpio_btn, IRQ_RISE, 1); // IRQ_FALL
-    gpio_irq_enable(&gpio_btn);
+    rtos_sema_create(&g_irq_sema, 0, 1);
+    if (rtos_task_create(NULL, "gt911", gt911_irq_task, NULL, GT911_TASK_STACK_SIZE, GT911_TASK_PRIORITY) != SUCCESS) {
+        RTK_LOGS(NOTAG, RTK_LOG_ALWAYS, "%s: Create task fail. \r\n", __func__);
+        return;
+    }
+
+    gpio_irq_init(&g_irq, INT_PIN, gpio_touch_irq_handler, (uint32_t)(&g_irq));
+    gpio_irq_set(&g_irq, IRQ_RISE, 1); // IRQ_FALL
+    gpio_irq_enable(&g_irq);
 }
 
 void gt911_register_touch_data_callback(gt911_touch_data_callback cb)
 {
     g_cb = cb;
 }
+
+void gt911_register_touch_ring(touch_ring_t *ring)
+{
+    touch_ring_init(ring);
+    g_ring = ring;
+}
+
+void gt911_get_stats(gt911_stats_t *stats)
+{
+    *stats = g_stats;
+}
@@ -2,6 +2,7 @@
 #define __CST328_H
 
 #include "lwip/sys.h"
+#include "touch_ring.h"
 
 typedef enum {
 	TOUCH_PRESS = 1,
@@ -14,9 +15,24 @@ typedef struct {
 	u16 y;
 } gt911_touch_data_t;
 
+typedef struct {
+	u32 irq_count;			/* touch interrupts */
+	u32 coalesced;			/* interrupts while a read was still pending */
+	u32 irq_max_ns;			/* longest time spent in the interrupt handler */
+	u32 defer_max_us;		/* longest interrupt to read start */
+	u32 read_max_us;		/* longest I2C read of a report */
+	u32 read_avg_us;		/* average of the last reads */
+	u32 i2c_errors;
+} gt911_stats_t;
+
+/* Called from the gt911 task, not from the interrupt */
 typedef void (*gt911_touch_data_callback)(gt911_touch_data_t data);
 
 void gt911_init(void);
 void gt911_register_touch_data_callback(gt911_touch_data_callback cb);
+/* Every report with all fingers and their track IDs, pushed from the gt911 task.
+ * The ring is initialized here, the caller is its only consumer. */
+void gt911_register_touch_ring(touch_ring_t *ring);
+void gt911_get_stats(gt911_stats_t *stats);
 
 #endif
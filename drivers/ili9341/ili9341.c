@@ -16,172 +16,110 @@
 #include "ameba_soc.h"
 #include "ameba_qspi.h"
 #include "os_wrapper.h"
+#include "panel_cmd.h"
+#include "panel_te.h"
 #include "ili9341.h"
 
+/* QSPI source clock of the board clock config, SCLK = ILI9341_QSPI_SRC_HZ / (2 * baud).
+ * Only converts dividers to Hz, the limit below is a divider and holds for any source clock. */
+#ifndef ILI9341_QSPI_SRC_HZ
+#define ILI9341_QSPI_SRC_HZ     100000000
+#endif
+#define QSPI_DEF_BAUD    2
+/* Fastest divider in use on the boards, already above the 10 MHz datasheet write clock.
+ * Only D0 is wired so there is no readback to verify anything faster. */
+#define QSPI_MIN_BAUD    QSPI_DEF_BAUD
+
 #define WIDTH            240
 #define HEIGHT           320
-#define PPE_MEM_SIZE     WIDTH * HEIGHT * 2        //rgb565
 
+#define QSPI_IDLE_TIMEOUT_US    1000
 
 static QSPI_CmdAddrInfo info;
-u8 ili9341_buf[100];
-u32 ili9341_buf_len = 0;
+static panel_bus_config_t g_bus_config = {ILI9341_QSPI_SRC_HZ / (2 * QSPI_DEF_BAUD), 1, 0};
 
 static ILI9341VBlankCallback *g_callback = NULL;
 static void *g_data = NULL;
 
-static void LCD_SPI_WR_REG(u8 cmd)
+/* PPE frame done only means the last pixels reached the QSPI FIFO, let them go out
+ * before any command: CASET/RASET of the next flush, scroll and TE setup */
+static void ili9341_wait_qspi_idle(void)
+{
+    int timeout = QSPI_IDLE_TIMEOUT_US;
+
+    while ((QSPI->SR & BIT_BUSY) && timeout--) {
+        DelayUs(1);
+    }
+}
+
+/* QSPI sends the command phase and the payload in one transfer */
+static void ili9341_bus_write(void *ctx, u8 cmd, const u8 *data, u32 len)
 {
+    UNUSED(ctx);
+    ili9341_wait_qspi_idle();
     info.cmd[0] = cmd;
-    ili9341_buf_len = 0;
+    QSPI_Write(&info, (u8 *)data, len);
 }
 
-static void LCD_SPI_WR_DATA(u8 para)
+static void ili9341_bus_delay(u32 ms)
 {
-    ili9341_buf[ili9341_buf_len] = para;
-    ili9341_buf_len++ ;
+    DelayMs(ms);
 }
 
+static const panel_bus_t g_bus = {
+    .ctx = NULL,
+    .write = ili9341_bus_write,
+    .delay_ms = ili9341_bus_delay,
+};
+
+static panel_cmd_window_t g_window;
+
+static const panel_cmd_t ili9341_init_cmds[] = {
+    {0xCF, 3, 0, {0x00, 0xD9, 0x30}},
+    {0xED, 4, 0, {0x64, 0x03, 0x12, 0x81}},
+    {0xE8, 3, 0, {0x85, 0x10, 0x78}},
+    {0xCB, 5, 0, {0x39, 0x2C, 0x00, 0x34, 0x02}},
+    {0xF7, 1, 0, {0x20}},
+    {0xEA, 2, 0, {0x00, 0x00}},
+    {0xC0, 1, 0, {0x21}},
+    {0xC1, 1, 0, {0x12}},
+    {0xC5, 2, 0, {0x32, 0x3C}},
+    {0xC7, 1, 0, {0xC1}},
+    {0x36, 1, 0, {0x08}},
+    {0x3A, 1, 0, {0x55}},
+    {0xB1, 2, 0, {0x00, 0x18}},
+    {0xB6, 2, 0, {0x0A, 0xA2}},
+    {0xF2, 1, 0, {0x00}},
+    {0x26, 1, 0, {0x01}},
+    {0xE0, 15, 0, {0x0F, 0x20, 0x1E, 0x09, 0x12, 0x0B, 0x50, 0xBA, 0x44, 0x09, 0x14, 0x05, 0x23, 0x21, 0x00}},
+    {0xE1, 15, 0, {0x00, 0x19, 0x19, 0x00, 0x12, 0x07, 0x2D, 0x28, 0x3F, 0x02, 0x0A, 0x08, 0x25, 0x2D, 0x0F}},
+    {0x11, 0, 120, {0}},
+    {0x29, 0, 0, {0}},
+};
+
 static void ili9341_config_init(void)
 {
-    LCD_SPI_WR_REG(0xCF);
-    LCD_SPI_WR_DATA(0x00);
-    LCD_SPI_WR_DATA(0xD9);
-    LCD_SPI_WR_DATA(0X30);
-    QSPI_Write(&info, ili9341_buf, ili9341_buf_len);
-
-    LCD_SPI_WR_REG(0xED);
-    LCD_SPI_WR_DATA(0x64);
-    LCD_SPI_WR_DATA(0x03);
-    LCD_SPI_WR_DATA(0X12);
-    LCD_SPI_WR_DATA(0X81);
-    QSPI_Write(&info, ili9341_buf, ili9341_buf_len);
-
-    LCD_SPI_WR_REG(0xE8);
-    LCD_SPI_WR_DATA(0x85);
-    LCD_SPI_WR_DATA(0x10);
-    LCD_SPI_WR_DATA(0x78);
-    QSPI_Write(&info, ili9341_buf, ili9341_buf_len);
-
-    LCD_SPI_WR_REG(0xCB);
-    LCD_SPI_WR_DATA(0x39);
-    LCD_SPI_WR_DATA(0x2C);
-    LCD_SPI_WR_DATA(0x00);
-    LCD_SPI_WR_DATA(0x34);
-    LCD_SPI_WR_DATA(0x02);
-    QSPI_Write(&info, ili9341_buf, ili9341_buf_len);
-
-    LCD_SPI_WR_REG(0xF7);
-    LCD_SPI_WR_DATA(0x20);
-    QSPI_Write(&info, ili9341_buf, ili9341_buf_len);
-
-    LCD_SPI_WR_REG(0xEA);
-    LCD_SPI_WR_DATA(0x00);
-    LCD_SPI_WR_DATA(0x00);
-    QSPI_Write(&info, ili9341_buf, ili9341_buf_len);
-
-    LCD_SPI_WR_REG(0xC0);
-    LCD_SPI_WR_DATA(0x21);
-    QSPI_Write(&info, ili9341_buf, ili9341_buf_len);
-
-    LCD_SPI_WR_REG(0xC1);
-    LCD_SPI_WR_DATA(0x12);
-    QSPI_Write(&info, ili9341_buf, ili9341_buf_len);
-
-    LCD_SPI_WR_REG(0xC5);
-    LCD_SPI_WR_DATA(0x32);
-    LCD_SPI_WR_DATA(0x3C);
-    QSPI_Write(&info, ili9341_buf, ili9341_buf_len);
-
-    LCD_SPI_WR_REG(0xC7);
-    LCD_SPI_WR_DATA(0XC1);
-    QSPI_Write(&info, ili9341_buf, ili9341_buf_len);
-
-    LCD_SPI_WR_REG(0x36);
-    LCD_SPI_WR_DATA(0x08);
-    QSPI_Write(&info, ili9341_buf, ili9341_buf_len);
-
-    LCD_SPI_WR_REG(0x3A);
-    LCD_SPI_WR_DATA(0x55);
-    QSPI_Write(&info, ili9341_buf, ili9341_buf_len);
-
-    LCD_SPI_WR_REG(0xB1);
-    LCD_SPI_WR_DATA(0x00);
-    LCD_SPI_WR_DATA(0x18);
-    QSPI_Write(&info, ili9341_buf, ili9341_buf_len);
-
-    LCD_SPI_WR_REG(0xB6);
-    LCD_SPI_WR_DATA(0x0A);
-    LCD_SPI_WR_DATA(0xA2);
-    QSPI_Write(&info, ili9341_buf, ili9341_buf_len);
-
-    LCD_SPI_WR_REG(0xF2);
-    LCD_SPI_WR_DATA(0x00);
-    QSPI_Write(&info, ili9341_buf, ili9341_buf_len);
-
-    LCD_SPI_WR_REG(0x26);
-    LCD_SPI_WR_DATA(0x01);
-    QSPI_Write(&info, ili9341_buf, ili9341_buf_len);
-
-    LCD_SPI_WR_REG(0xE0);
-    LCD_SPI_WR_DATA(0x0F);
-    LCD_SPI_WR_DATA(0x20);
-    LCD_SPI_WR_DATA(0x1E);
-    LCD_SPI_WR_DATA(0x09);
-    LCD_SPI_WR_DATA(0x12);
-    LCD_SPI_WR_DATA(0x0B);
-    LCD_SPI_WR_DATA(0x50);
-    LCD_SPI_WR_DATA(0XBA);
-    LCD_SPI_WR_DATA(0x44);
-    LCD_SPI_WR_DATA(0x09);
-    LCD_SPI_WR_DATA(0x14);
-    LCD_SPI_WR_DATA(0x05);
-    LCD_SPI_WR_DATA(0x23);
-    LCD_SPI_WR_DATA(0x21);
-    LCD_SPI_WR_DATA(0x00);
-    QSPI_Write(&info, ili9341_buf, ili9341_buf_len);
-
-    LCD_SPI_WR_REG(0XE1);
-    LCD_SPI_WR_DATA(0x00);
-    LCD_SPI_WR_DATA(0x19);
-    LCD_SPI_WR_DATA(0x19);
-    LCD_SPI_WR_DATA(0x00);
-    LCD_SPI_WR_DATA(0x12);
-    LCD_SPI_WR_DATA(0x07);
-    LCD_SPI_WR_DATA(0x2D);
-    LCD_SPI_WR_DATA(0x28);
-    LCD_SPI_WR_DATA(0x3F);
-    LCD_SPI_WR_DATA(0x02);
-    LCD_SPI_WR_DATA(0x0A);
-    LCD_SPI_WR_DATA(0x08);
-    LCD_SPI_WR_DATA(0x25);
-    LCD_SPI_WR_DATA(0x2D);
-    LCD_SPI_WR_DATA(0x0F);
-    QSPI_Write(&info, ili9341_buf, ili9341_buf_len);
-
-    LCD_SPI_WR_REG(0x11);
-    QSPI_Write(&info, ili9341_buf, ili9341_buf_len);
-    DelayMs(120);
-    LCD_SPI_WR_REG(0x29);
-    QSPI_Write(&info, ili9341_buf, ili9341_buf_len);
+    panel_cmd_exec(&g_bus, ili9341_init_cmds, PANEL_CMD_COUNT(ili9341_init_cmds));
+    panel_cmd_window_reset(&g_window);
 }
 
-/* PPE use as a DMA */
-static void Prepare_PPE(uint8_t *buffer)
+/* PPE use as a DMA, reads width x height pixels from lines of line_len pixels */
+static void Prepare_PPE(uint8_t *buffer, int line_len, int width, int height)
 {
-    DCache_CleanInvalidate((u32)buffer, PPE_MEM_SIZE);
+    /* PPE only reads, clean just the lines of the area */
+    DCache_Clean((u32)buffer, ((height - 1) * line_len + width) * 2);
     PPE_InputLayer_InitTypeDef PPE_Input_Layer1;
     PPE_InputLayer_StructInit(&PPE_Input_Layer1);
     PPE_Input_Layer1.src_addr = (u32)buffer;
     PPE_Input_Layer1.start_x = 0;
     PPE_Input_Layer1.start_y = 0;
-    PPE_Input_Layer1.width = WIDTH;
-    PPE_Input_Layer1.height = HEIGHT;
+    PPE_Input_Layer1.width = width;
+    PPE_Input_Layer1.height = height;
     PPE_Input_Layer1.const_ABGR8888_value = 0xFFFFFFFF;
     PPE_Input_Layer1.format = PPE_RGB565;
     PPE_Input_Layer1.src = PPE_LAYER_SRC_FROM_DMA;
     PPE_Input_Layer1.color_key_en = DISABLE;
-    PPE_Input_Layer1.line_len = PPE_Input_Layer1.width;
+    PPE_Input_Layer1.line_len = line_len;
     PPE_Input_Layer1.key_color_value = 0;
     PPE_InitInputLayer(1, &PPE_Input_Layer1);
 
@@ -189,8 +127,8 @@ static void Prepare_PPE(uint8_t *buffer)
     PPE_ResultLayer_InitTypeDef PPE_Result_Layer;
     PPE_ResultLayer_StructInit(&PPE_Result_Layer);
     PPE_Result_Layer.src_addr = (u32) & (QSPI->DR[0].BYTE);
-    PPE_Result_Layer.width = WIDTH;
-    PPE_Result_Layer.height = HEIGHT;
+    PPE_Result_Layer.width = width;
+    PPE_Result_Layer.height = height;
     PPE_Result_Layer.format = PPE_RGB565;
     PPE_Result_Layer.line_len = PPE_Result_Layer.width;
     PPE_Result_Layer.type = PPE_ADDR_QSPI;
@@ -203,10 +141,35 @@ static void Prepare_PPE(uint8_t *buffer)
     PPE_Init(&PPE_Init_User);
 }
 
+static void ili9341_set_window(int x1, int y1, int x2, int y2)
+{
+    panel_cmd_set_window(&g_bus, &g_window, x1, y1, x2, y2);
+}
+
+/* Send x1..x2, y1..y2 (inclusive) from buffer, whose lines are stride pixels */
+static void ili9341_flush_start(u8 *buffer, int stride, int x1, int y1, int x2, int y2)
+{
+    int width = x2 - x1 + 1;
+    int height = y2 - y1 + 1;
+
+    ili9341_wait_qspi_idle();
+    if (panel_te_enabled()) {
+        panel_te_sync(y1, y2, width * height * 2);
+    }
+
+    Prepare_PPE(buffer, stride, width, height);
+    ili9341_set_window(x1, y1, x2, y2);
+
+    info.cmd[0] = 0x2C;
+    QSPI_WriteStart(&info, width * height * 2);
+    PPE_Cmd(ENABLE);
+}
+
 void *PPE_Handler(void)
 {
     if (PPE->INT_STATUS & BIT1) {
         PPE->INT_CLR |= BIT1;
+        panel_te_transfer_done();
         if (g_callback) {
             g_callback->VBlank(g_data);
         }
@@ -241,7 +204,7 @@ void ili9341_init(void)
 
     /* Init QSPI */
     QSPI_Init();
-    QSPI_SetBaud(2);
+    QSPI_SetBaud(QSPI_DEF_BAUD);
 
     /* Set QSPI parameter */
     QSPI_StructInit(&info);
@@ -264,6 +227,25 @@ void ili9341_init(void)
     PPE_MaskINTConfig(PPE_FR_OVER_INT, ENABLE);
 }
 
+int ili9341_te_enable(u32 pin)
+{
+    if (panel_te_init(pin, HEIGHT) != 0) {
+        return -1;
+    }
+
+    /* TEON, V-blanking only */
+    u8 mode = 0x00;
+    ili9341_bus_write(NULL, 0x35, &mode, 1);
+    return 0;
+}
+
+void ili9341_te_disable(void)
+{
+    /* TEOFF */
+    ili9341_bus_write(NULL, 0x34, NULL, 0);
+    panel_te_deinit();
+}
+
 void ili9341_get_info(int *width, int *height)
 {
     *width = WIDTH;
@@ -278,27 +260,116 @@ void ili9341_register_callback(ILI9341VBlankCallback *callback, void *data)
 
 void ili9341_clean_invalidate_buffer(uint8_t *buffer)
 {
-    Prepare_PPE(buffer);
+    ili9341_flush_start(buffer, WIDTH, 0, 0, WIDTH - 1, HEIGHT - 1);
+}
 
-    /* Set window to (0, 0, 240, 320)*/
-    u8 data[4];
-    data[0] = 0 >> 8;
-    data[1] = 0 & 0xff;
-    data[2] = (WIDTH - 1) >> 8;
-    data[3] = (WIDTH - 1) & 0xff;
-    info.cmd[0] = 0x2A;
+void ili9341_flush_area(u8 *buffer, int x1, int y1, int x2, int y2)
+{
+    ili9341_flush_start(buffer, x2 - x1 + 1, x1, y1, x2, y2);
+}
 
-    QSPI_Write(&info, data, 4);
+static panel_done_cb_t g_panel_done_cb = NULL;
+static void *g_panel_done_data = NULL;
+static ILI9341VBlankCallback g_panel_callback;
 
-    data[0] = 0 >> 8;
-    data[1] = 0 & 0xff;
-    data[2] = (HEIGHT - 1) >> 8;
-    data[3] = (HEIGHT - 1) & 0xff;
-    info.cmd[0] = 0x2B;
-    QSPI_Write(&info, data, 4);
+static void ili9341_panel_done(void *data)
+{
+    UNUSED(data);
+    if (g_panel_done_cb) {
+        g_panel_done_cb(g_panel_done_data);
+    }
+}
 
-    info.cmd[0] = 0x2C;
-    QSPI_WriteStart(&info, PPE_MEM_SIZE);
-    PPE_Cmd(ENABLE);
+static int ili9341_panel_init(panel_format_t format)
+{
+    if (format != PANEL_FORMAT_RGB565) {
+        return -1;
+    }
+
+    ili9341_init();
+    return 0;
+}
+
+static void ili9341_panel_get_caps(panel_caps_t *caps)
+{
+    caps->name = "ili9341";
+    caps->width = WIDTH;
+    caps->height = HEIGHT;
+    caps->formats = PANEL_FORMAT_RGB565;
+    caps->flags = PANEL_CAP_PARTIAL_UPDATE | PANEL_CAP_HW_SCROLL;
+    /* 4-wire serial with D/C is single lane, the QSPI side would take 2/4 lanes and DDR */
+    caps->bus.max_clock_hz = ILI9341_QSPI_SRC_HZ / (2 * QSPI_MIN_BAUD);
+    caps->bus.lanes = PANEL_LANES_1;
+    caps->bus.ddr = 0;
+}
+
+static int ili9341_panel_set_bus(const panel_bus_config_t *config)
+{
+    panel_caps_t caps;
+    ili9341_panel_get_caps(&caps);
+    if (!config->clock_hz || config->clock_hz > caps.bus.max_clock_hz ||
+        !(caps.bus.lanes & config->lanes) || (config->ddr && !caps.bus.ddr)) {
+        return -1;
+    }
+
+    /* Round the divider up, never faster than asked */
+    u32 baud = (ILI9341_QSPI_SRC_HZ + 2 * config->clock_hz - 1) / (2 * config->clock_hz);
+    QSPI_SetBaud(baud);
+    info.data_ch = config->lanes == 4 ? 2 : config->lanes == 2 ? 1 : 0;
+    info.ddr_en = config->ddr;
+
+    g_bus_config.clock_hz = ILI9341_QSPI_SRC_HZ / (2 * baud);
+    g_bus_config.lanes = config->lanes;
+    g_bus_config.ddr = config->ddr;
+    return 0;
+}
+
+static void ili9341_panel_get_bus(panel_bus_config_t *config)
+{
+    *config = g_bus_config;
+}
+
+static void ili9341_panel_register_done_cb(panel_done_cb_t cb, void *user_data)
+{
+    g_panel_done_cb = cb;
+    g_panel_done_data = user_data;
+    g_panel_callback.VBlank = ili9341_panel_done;
+    ili9341_register_callback(&g_panel_callback, NULL);
+}
+
+static int ili9341_panel_set_scroll_area(int top, int height)
+{
+    if (top < 0 || height <= 0 || top + height > HEIGHT) {
+        return -1;
+    }
+
+    /* VSCRDEF: top fixed, scroll and bottom fixed lines */
+    int bottom = HEIGHT - top - height;
+    u8 data[6] = {top >> 8, top & 0xff, height >> 8, height & 0xff, bottom >> 8, bottom & 0xff};
+    ili9341_bus_write(NULL, 0x33, data, 6);
+    panel_te_set_scroll_area(top, height);
+    return 0;
+}
+
+static void ili9341_panel_set_scroll_start(int line)
+{
+    /* VSCSAD */
+    u8 data[2] = {line >> 8, line & 0xff};
+    ili9341_bus_write(NULL, 0x37, data, 2);
+    panel_te_set_scroll_start(line);
 }
 
+const panel_ops_t ili9341_panel_ops = {
+    .init = ili9341_panel_init,
+    .get_caps = ili9341_panel_get_caps,
+    .flush_full = ili9341_clean_invalidate_buffer,
+    .flush_area = ili9341_flush_area,
+    .set_window = ili9341_set_window,
+    .register_done_cb = ili9341_panel_register_done_cb,
+    .set_bus = ili9341_panel_set_bus,
+    .get_bus = ili9341_panel_get_bus,
+    /* Only D0 is wired (see the pinmux in ili9341_init), no readback */
+    .self_test = NULL,
+    .set_scroll_area = ili9341_panel_set_scroll_area,
+    .set_scroll_start = ili9341_panel_set_scroll_start,
+};
@@ -2,6 +2,7 @@
 #define _ILI9341_H
 
 #include "ameba_soc.h"
+#include "panel.h"
 
 typedef struct {
 	void (*VBlank)(void *user_data);
@@ -12,5 +13,13 @@ void ili9341_get_info(int *width, int *height);
 void ili9341_clean_invalidate_buffer(u8 *buffer);
 
 void ili9341_register_callback(ILI9341VBlankCallback *callback, void *data);
+/* Send a buffer holding only the area (x2, y2 inclusive), VBlank is called when done */
+void ili9341_flush_area(u8 *buffer, int x1, int y1, int x2, int y2);
+/* Sync transfers to the panel TE output wired to pin, counters in panel_te_get_info */
+int ili9341_te_enable(u32 pin);
+void ili9341_te_disable(void);
+
+/* Common panel interface, see panel.h */
+extern const panel_ops_t ili9341_panel_ops;
 
 #endif
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "panel.h"
+
+static uint16_t g_width = 480;
+static uint16_t g_height = 272;
+static int g_px_size = 2;
+static panel_done_cb_t g_done_cb = NULL;
+static void *g_done_data = NULL;
+static null_panel_stats_t g_stats;
+static uint8_t *g_gram = NULL;
+static int g_scroll_top;
+static int g_scroll_height;
+static int g_scroll_start;
+
+static int null_panel_init(panel_format_t format)
+{
+    switch (format) {
+    case PANEL_FORMAT_RGB565:
+        g_px_size = 2;
+        break;
+    case PANEL_FORMAT_RGB888:
+        g_px_size = 3;
+        break;
+    default:
+        g_px_size = 4;
+        break;
+    }
+    memset(&g_stats, 0, sizeof(g_stats));
+    g_scroll_top = 0;
+    g_scroll_height = g_height;
+    g_scroll_start = 0;
+
+    return 0;
+}
+
+static void null_panel_get_caps(panel_caps_t *caps)
+{
+    caps->name = "null";
+    caps->width = g_width;
+    caps->height = g_height;
+    caps->formats = PANEL_FORMAT_RGB565 | PANEL_FORMAT_RGB888 | PANEL_FORMAT_ARGB8888;
+    caps->flags = PANEL_CAP_PARTIAL_UPDATE | PANEL_CAP_HW_SCROLL;
+}
+
+static void null_panel_done(void)
+{
+    if (g_done_cb) {
+        g_done_cb(g_done_data);
+    }
+}
+
+static void null_panel_flush_full(uint8_t *buffer)
+{
+    if (g_gram) {
+        memcpy(g_gram, buffer, (size_t)g_width * g_height * g_px_size);
+    }
+    g_stats.full_flushes++;
+    g_stats.bytes += (uint64_t)g_width * g_height * g_px_size;
+    null_panel_done();
+}
+
+static void null_panel_flush_area(uint8_t *buffer, int x1, int y1, int x2, int y2)
+{
+    if (g_gram) {
+        size_t line_size = (size_t)(x2 - x1 + 1) * g_px_size;
+        for (int y = y1; y <= y2; y++) {
+            memcpy(g_gram + ((size_t)y * g_width + x1) * g_px_size, buffer + (y - y1) * line_size, line_size);
+        }
+    }
+    g_stats.area_flushes++;
+    g_stats.bytes += (uint64_t)(x2 - x1 + 1) * (y2 - y1 + 1) * g_px_size;
+    null_panel_done();
+}
+
+static void null_panel_register_done_cb(panel_done_cb_t cb, void *user_data)
+{
+    g_done_cb = cb;
+    g_done_data = user_data;
+}
+
+static int null_panel_set_scroll_area(int top, int height)
+{
+    if (top < 0 || height <= 0 || top + height > g_height) {
+        return -1;
+    }
+    g_scroll_top = top;
+    g_scroll_height = height;
+    return 0;
+}
+
+static void null_panel_set_scroll_start(int line)
+{
+    g_scroll_start = line;
+    g_stats.scroll_starts++;
+}
+
+const panel_ops_t null_panel_ops = {
+    .init = null_panel_init,
+    .get_caps = null_panel_get_caps,
+    .flush_full = null_panel_flush_full,
+    .flush_area = null_panel_flush_area,
+    .set_window = NULL,
+    .register_done_cb = null_panel_register_done_cb,
+    .set_scroll_area = null_panel_set_scroll_area,
+    .set_scroll_start = null_panel_set_scroll_start,
+};
+
+void null_panel_set_size(uint16_t width, uint16_t height)
+{
+    g_width = width;
+    g_height = height;
+}
+
+void null_panel_get_stats(null_panel_stats_t *stats)
+{
+    *stats = g_stats;
+}
+
+void null_panel_set_frame_memory(uint8_t *gram)
+{
+    g_gram = gram;
+}
+
+const uint8_t *null_panel_get_row(int y)
+{
+    int line = y;
+
+    if (!g_gram || y < 0 || y >= g_height) {
+        return NULL;
+    }
+    // As VSCRDEF/VSCSAD: the first row of the scroll area shows line g_scroll_start
+    if (y >= g_scroll_top && y < g_scroll_top + g_scroll_height) {
+        line = g_scroll_top + (y - g_scroll_top + g_scroll_start - g_scroll_top) % g_scroll_height;
+    }
+    return g_gram + (size_t)line * g_width * g_px_size;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _PANEL_H
+#define _PANEL_H
+
+#include <stdint.h>
+
+/*
+ * Common interface of the display panel drivers. Each driver exports a const
+ * panel_ops_t next to its own API, the flush engine in lv_drivers only uses this.
+ * Kept free of SDK headers so it builds on a host for the null panel.
+ */
+
+typedef enum {
+	PANEL_FORMAT_RGB565		= 1 << 0,
+	PANEL_FORMAT_RGB888		= 1 << 1,
+	PANEL_FORMAT_ARGB8888	= 1 << 2,
+} panel_format_t;
+
+/* Framebuffer is scanned out continuously (RGB/DSI). It stays in use until the
+ * next flush_full is latched, instead of until the transfer is done. */
+#define PANEL_CAP_SCANOUT			(1 << 0)
+/* flush_area is supported, only the changed rectangle is sent (SPI/QSPI GRAM panels) */
+#define PANEL_CAP_PARTIAL_UPDATE	(1 << 1)
+/* Hardware vertical scrolling (VSCRDEF/VSCSAD), set_scroll_area and set_scroll_start */
+#define PANEL_CAP_HW_SCROLL			(1 << 2)
+
+/* Bus of a GRAM panel (SPI/QSPI), all zero for scan-out panels */
+#define PANEL_LANES_1		(1 << 0)
+#define PANEL_LANES_2		(1 << 1)
+#define PANEL_LANES_4		(1 << 2)
+
+typedef struct {
+	uint32_t max_clock_hz;	/* fastest write clock the driver allows */
+	uint8_t lanes;			/* PANEL_LANES_* the panel accepts */
+	uint8_t ddr;			/* data on both clock edges */
+} panel_bus_caps_t;
+
+typedef struct {
+	uint32_t clock_hz;
+	uint8_t lanes;			/* 1, 2 or 4 */
+	uint8_t ddr;
+} panel_bus_config_t;
+
+typedef struct {
+	const char *name;
+	uint16_t width;
+	uint16_t height;
+	uint32_t formats;		/* panel_format_t mask */
+	uint32_t flags;			/* PANEL_CAP_* */
+	panel_bus_caps_t bus;
+} panel_caps_t;
+
+/* Transfer done (SPI) or new buffer latched (scan-out). May run in interrupt context. */
+typedef void (*panel_done_cb_t)(void *user_data);
+
+typedef struct {
+	int (*init)(panel_format_t format);
+	void (*get_caps)(panel_caps_t *caps);
+	/* Start sending / showing a full screen buffer, done_cb follows */
+	void (*flush_full)(uint8_t *buffer);
+	/* Send a buffer holding only the area (x2, y2 inclusive), done_cb follows.
+	 * NULL without PANEL_CAP_PARTIAL_UPDATE. */
+	void (*flush_area)(uint8_t *buffer, int x1, int y1, int x2, int y2);
+	/* Set the GRAM window for following pixel writes, NULL if not applicable */
+	void (*set_window)(int x1, int y1, int x2, int y2);
+	void (*register_done_cb)(panel_done_cb_t cb, void *user_data);
+	/* Bus setup, NULL for scan-out panels. set_bus returns 0 or -1 when outside the caps.
+	 * Only call with no flush in progress. */
+	int (*set_bus)(const panel_bus_config_t *config);
+	void (*get_bus)(panel_bus_config_t *config);
+	/* Write a pattern at the current bus setup and read it back, 0 if it matches.
+	 * NULL where the panel or the board can't read back. */
+	int (*self_test)(void);
+	/* Rows top..top + height - 1 scroll, the others stay fixed. NULL without
+	 * PANEL_CAP_HW_SCROLL. (0, height of the panel) with start 0 is the normal display. */
+	int (*set_scroll_area)(int top, int height);
+	/* Frame memory line shown on the first row of the scroll area */
+	void (*set_scroll_start)(int line);
+} panel_ops_t;
+
+/* Frames per second x10 the bus carries for full frames, without command overhead */
+uint32_t panel_bus_fps_x10(const panel_bus_config_t *config, uint16_t width, uint16_t height,
+						   uint8_t px_size);
+
+/* Panel without hardware, completes every flush at once and counts the traffic.
+ * Used to benchmark the flush path without a display, also on a host. */
+typedef struct {
+	uint32_t full_flushes;
+	uint32_t area_flushes;
+	uint32_t scroll_starts;
+	uint64_t bytes;
+} null_panel_stats_t;
+
+extern const panel_ops_t null_panel_ops;
+void null_panel_set_size(uint16_t width, uint16_t height);
+void null_panel_get_stats(null_panel_stats_t *stats);
+/* Keep the pixels sent in gram (width x height in the format of init), NULL to only count */
+void null_panel_set_frame_memory(uint8_t *gram);
+/* Frame memory line shown on screen row y, through the hardware scroll. NULL without
+ * frame memory. */
+const uint8_t *null_panel_get_row(int y);
+
+#endif
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "panel.h"
+
+uint32_t panel_bus_fps_x10(const panel_bus_config_t *config, uint16_t width, uint16_t height,
+                           uint8_t px_size)
+{
+    uint64_t bits_per_s = (uint64_t)config->clock_hz * config->lanes * (config->ddr ? 2 : 1);
+    uint64_t frame_bits = (uint64_t)width * height * px_size * 8;
+
+    if (!frame_bits) {
+        return 0;
+    }
+    return bits_per_s * 10 / frame_bits;
+}
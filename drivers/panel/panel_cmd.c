@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "panel_cmd.h"
+
+#define PANEL_CMD_CASET     0x2A
+#define PANEL_CMD_RASET     0x2B
+
+void panel_cmd_exec(const panel_bus_t *bus, const panel_cmd_t *table, int count)
+{
+    for (int i = 0; i < count; i++) {
+        uint8_t len = table[i].len > PANEL_CMD_MAX_DATA ? PANEL_CMD_MAX_DATA : table[i].len;
+
+        bus->write(bus->ctx, table[i].cmd, table[i].data, len);
+        if (table[i].delay_ms && bus->delay_ms) {
+            bus->delay_ms(table[i].delay_ms);
+        }
+    }
+}
+
+void panel_cmd_window_reset(panel_cmd_window_t *win)
+{
+    win->x1 = -1;
+    win->x2 = -1;
+    win->y1 = -1;
+    win->y2 = -1;
+}
+
+static void panel_cmd_send_range(const panel_bus_t *bus, uint8_t cmd, int start, int end)
+{
+    uint8_t range[4] = {start >> 8, start & 0xFF, end >> 8, end & 0xFF};
+
+    bus->write(bus->ctx, cmd, range, 4);
+}
+
+void panel_cmd_set_window(const panel_bus_t *bus, panel_cmd_window_t *win, int x1, int y1, int x2, int y2)
+{
+    if (x1 != win->x1 || x2 != win->x2) {
+        panel_cmd_send_range(bus, PANEL_CMD_CASET, x1, x2);
+        win->x1 = x1;
+        win->x2 = x2;
+    }
+
+    if (y1 != win->y1 || y2 != win->y2) {
+        panel_cmd_send_range(bus, PANEL_CMD_RASET, y1, y2);
+        win->y1 = y1;
+        win->y2 = y2;
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _PANEL_CMD_H
+#define _PANEL_CMD_H
+
+#include <stdint.h>
+
+/*
+ * Table-driven panel commands. A table of (cmd, payload, delay) entries is sent through
+ * a panel_bus_t, one write per command since D/C toggles between command and payload,
+ * so init sequences are data and the window setup of every flush costs as few bus
+ * writes as possible.
+ * SDK free like panel.h, a bus that records its writes runs it on a host.
+ */
+
+#define PANEL_CMD_MAX_DATA	16
+
+typedef struct {
+	uint8_t cmd;
+	uint8_t len;			/* payload bytes */
+	uint16_t delay_ms;		/* wait after the command */
+	uint8_t data[PANEL_CMD_MAX_DATA];
+} panel_cmd_t;
+
+#define PANEL_CMD_COUNT(table)	((int)(sizeof(table) / sizeof((table)[0])))
+
+typedef struct {
+	void *ctx;
+	/* Send cmd with DC low, then len payload bytes with DC high */
+	void (*write)(void *ctx, uint8_t cmd, const uint8_t *data, uint32_t len);
+	void (*delay_ms)(uint32_t ms);
+} panel_bus_t;
+
+/* Send every entry of table in order, waiting delay_ms after those that have one */
+void panel_cmd_exec(const panel_bus_t *bus, const panel_cmd_t *table, int count);
+
+/* CASET/RASET state, a range is only sent again when it changes. Bands of a frame
+ * share the columns, so they only pay for RASET. */
+typedef struct {
+	int x1;
+	int x2;
+	int y1;
+	int y2;
+} panel_cmd_window_t;
+
+/* Forget the last window, after init or anything else that changed it */
+void panel_cmd_window_reset(panel_cmd_window_t *win);
+/* Send CASET/RASET for (x2, y2 inclusive) as needed, RAMWR is up to the driver */
+void panel_cmd_set_window(const panel_bus_t *bus, panel_cmd_window_t *win, int x1, int y1, int x2, int y2);
+
+#endif
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ameba_soc.h"
+#include "os_wrapper.h"
+#include "gpio_api.h"
+#include "gpio_irq_api.h"
+#include "panel_te.h"
+
+#define PANEL_TE_MARGIN_LINES   8       // guard band around the estimated scan line
+#define PANEL_TE_DEF_PERIOD_MS  17
+#define PANEL_TE_RESEED_REJECTS 4       // periods out of range in a row that replace the estimate
+
+static struct {
+    bool enabled;
+    gpio_irq_t irq;
+    u16 height;
+    rtos_sema_t sema;
+    volatile bool waiting;
+    volatile u32 seq;           // odd while the interrupt updates last_ns and period_ns
+    volatile u64 last_ns;
+    volatile u64 period_ns;
+    u8 rejects;
+    u64 xfer_start_ns;
+    u32 xfer_bytes;
+    panel_te_info_t info;
+} g_te;
+
+/* Hardware scroll of the panel, kept over panel_te_init. height 0 is no scroll area. */
+static struct {
+    int top;
+    int height;
+    int start;
+} g_te_scroll;
+
+static void panel_te_irq_handler(uint32_t id, uint32_t event)
+{
+    UNUSED(id);
+    UNUSED(event);
+
+    u64 now = rtos_time_get_current_system_time_ns();
+    g_te.seq++;
+    if (g_te.last_ns) {
+        u64 period = now - g_te.last_ns;
+        // Average over 8 pulses, a missed pulse must not double the estimate. A run of
+        // longer periods means the estimate started from a short one (a glitch, TE
+        // enabled mid-frame) or the panel slowed down, start over from the last one.
+        if (!g_te.period_ns) {
+            g_te.period_ns = period;
+        } else if (period < g_te.period_ns * 3 / 2) {
+            g_te.period_ns = (g_te.period_ns * 7 + period) / 8;
+            g_te.rejects = 0;
+        } else if (++g_te.rejects >= PANEL_TE_RESEED_REJECTS) {
+            g_te.period_ns = period;
+            g_te.rejects = 0;
+        }
+        g_te.info.period_us = g_te.period_ns / 1000;
+    }
+    g_te.last_ns = now;
+    g_te.seq++;
+    g_te.info.te_count++;
+
+    if (g_te.waiting) {
+        g_te.waiting = false;
+        rtos_sema_give(g_te.sema);
+    }
+}
+
+int panel_te_init(u32 pin, u16 height)
+{
+    if (g_te.enabled) {
+        return 0;
+    }
+
+    memset(&g_te, 0, sizeof(g_te));
+    if (rtos_sema_create(&g_te.sema, 0, RTOS_SEMA_MAX_COUNT) != SUCCESS) {
+        return -1;
+    }
+    g_te.height = height;
+
+    gpio_irq_init(&g_te.irq, pin, panel_te_irq_handler, (uint32_t)&g_te);
+    gpio_irq_set(&g_te.irq, IRQ_RISE, 1);
+    gpio_irq_enable(&g_te.irq);
+    g_te.enabled = true;
+
+    RTK_LOGS(NOTAG, RTK_LOG_INFO, "panel TE on pin 0x%x \r\n", (unsigned int)pin);
+    return 0;
+}
+
+void panel_te_deinit(void)
+{
+    if (!g_te.enabled) {
+        return;
+    }
+
+    g_te.enabled = false;
+    gpio_irq_disable(&g_te.irq);
+    gpio_irq_deinit(&g_te.irq);
+    if (g_te.waiting) {
+        g_te.waiting = false;
+        rtos_sema_give(g_te.sema);
+    }
+    rtos_sema_delete(g_te.sema);
+}
+
+bool panel_te_enabled(void)
+{
+    return g_te.enabled;
+}
+
+// The 64 bit values take two loads, read again if the TE interrupt came in between
+static void panel_te_snapshot(u64 *last_ns, u64 *period_ns)
+{
+    u32 seq;
+
+    do {
+        seq = g_te.seq;
+        *last_ns = g_te.last_ns;
+        *period_ns = g_te.period_ns;
+    } while ((seq & 1) || seq != g_te.seq);
+}
+
+/*
+ * Scanline racing: the write may start at once when it is done before the scan reaches
+ * y1 (scan above the area), or the scan already passed y2 and the write is done before
+ * the next scan gets back to y1. The scan line is estimated from the time since TE.
+ */
+static bool panel_te_can_race(int y1, int y2, u32 bytes)
+{
+    u64 last;
+    u64 period;
+
+    panel_te_snapshot(&last, &period);
+    if (!period || !g_te.info.bytes_per_ms) {
+        return false;
+    }
+
+    u64 line_ns = period / g_te.height;
+    u64 xfer_ns = (u64)bytes * 1000000 / g_te.info.bytes_per_ms;
+    int line = ((rtos_time_get_current_system_time_ns() - last) % period) / line_ns;
+
+    if (line + PANEL_TE_MARGIN_LINES <= y1) {
+        return xfer_ns < (u64)(y1 - line - PANEL_TE_MARGIN_LINES) * line_ns;
+    }
+    if (line >= y2 + PANEL_TE_MARGIN_LINES) {
+        return xfer_ns < (u64)(g_te.height - line + y1) * line_ns;
+    }
+    return false;
+}
+
+void panel_te_set_scroll_area(int top, int height)
+{
+    g_te_scroll.top = top;
+    g_te_scroll.height = height;
+}
+
+void panel_te_set_scroll_start(int line)
+{
+    g_te_scroll.start = line;
+}
+
+/*
+ * The scan runs over screen rows, transfers address frame memory lines. In the scroll
+ * area line L is on screen row top + (L - start) mod height. False if the lines aren't
+ * one run of rows on screen: across the scroll area edge or the line shown first.
+ */
+static bool panel_te_map_rows(int *y1, int *y2)
+{
+    int top = g_te_scroll.top;
+    int height = g_te_scroll.height;
+    int start = g_te_scroll.start;
+
+    if (!height || start == top || *y2 < top || *y1 >= top + height) {
+        return true;
+    }
+    if (*y1 < top || *y2 >= top + height || (*y1 < start && start <= *y2)) {
+        return false;
+    }
+    *y1 = top + (*y1 - start + height) % height;
+    *y2 = top + (*y2 - start + height) % height;
+    return true;
+}
+
+void panel_te_sync(int y1, int y2, u32 bytes)
+{
+    if (!g_te.enabled) {
+        return;
+    }
+
+    if (panel_te_map_rows(&y1, &y2) && panel_te_can_race(y1, y2, bytes)) {
+        g_te.info.raced++;
+    } else {
+        u64 last;
+        u64 period;
+        panel_te_snapshot(&last, &period);
+        u32 timeout = period ? 2 * period / 1000000 + 1 : 2 * PANEL_TE_DEF_PERIOD_MS;
+
+        // Drop a give left by a TE that came after the previous wait timed out
+        while (rtos_sema_take(g_te.sema, 0) == SUCCESS) {
+        }
+        g_te.waiting = true;
+        if (rtos_sema_take(g_te.sema, timeout) != SUCCESS) {
+            g_te.waiting = false;
+            g_te.info.missed++;
+        }
+        g_te.info.waits++;
+    }
+
+    g_te.xfer_bytes = bytes;
+    g_te.xfer_start_ns = rtos_time_get_current_system_time_ns();
+}
+
+void panel_te_transfer_done(void)
+{
+    if (!g_te.enabled || !g_te.xfer_bytes) {
+        return;
+    }
+
+    u64 elapsed = rtos_time_get_current_system_time_ns() - g_te.xfer_start_ns;
+    if (elapsed) {
+        u32 rate = (u64)g_te.xfer_bytes * 1000000 / elapsed;
+        g_te.info.bytes_per_ms = g_te.info.bytes_per_ms ? (g_te.info.bytes_per_ms * 3 + rate) / 4 : rate;
+    }
+    g_te.xfer_bytes = 0;
+}
+
+void panel_te_get_info(panel_te_info_t *info)
+{
+    *info = g_te.info;
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _PANEL_TE_H
+#define _PANEL_TE_H
+
+#include "ameba_soc.h"
+
+/*
+ * Tearing effect (TE) sync for GRAM panels on SPI/QSPI. The panel pulses TE when its
+ * scan restarts, transfers are held until a TE unless they can't meet the scan line.
+ * One panel per system, like the drivers using it.
+ */
+
+typedef struct {
+	u32 period_us;		/* average TE period, 0 until measured */
+	u32 te_count;		/* TE pulses seen */
+	u32 waits;			/* transfers held until the next TE */
+	u32 raced;			/* transfers sent at once, clear of the scan line */
+	u32 missed;			/* waits that timed out, no TE in two periods */
+	u32 bytes_per_ms;	/* measured bus throughput, 0 until the first transfer */
+} panel_te_info_t;
+
+/* Enable the TE input on pin for a panel of height lines, 0 on success */
+int panel_te_init(u32 pin, u16 height);
+void panel_te_deinit(void);
+bool panel_te_enabled(void);
+
+/* Block until frame memory lines y1..y2 (inclusive) can be written, bytes is the transfer size */
+void panel_te_sync(int y1, int y2, u32 bytes);
+/* Hardware scroll written to the panel (VSCRDEF/VSCSAD), transfers are matched against
+ * the screen rows their lines are shown on */
+void panel_te_set_scroll_area(int top, int height);
+void panel_te_set_scroll_start(int line);
+/* Transfer started after panel_te_sync is done, call from the done interrupt */
+void panel_te_transfer_done(void);
+
+void panel_te_get_info(panel_te_info_t *info);
+
+#endif
@@ -249,3 +249,57 @@ void st7262_register_callback(ST7262VBlankCallback *callback, void *data)
     g_callback = callback;
     g_data = data;
 }
+
+static panel_done_cb_t g_panel_done_cb = NULL;
+static void *g_panel_done_data = NULL;
+static ST7262VBlankCallback g_panel_callback;
+
+static void st7262_panel_done(void *data)
+{
+    UNUSED(data);
+    if (g_panel_done_cb) {
+        g_panel_done_cb(g_panel_done_data);
+    }
+}
+
+static int st7262_panel_init(panel_format_t format)
+{
+    switch (format) {
+    case PANEL_FORMAT_RGB565:
+        st7262_init(RGB565);
+        break;
+    case PANEL_FORMAT_RGB888:
+        st7262_init(RGB888);
+        break;
+    default:
+        st7262_init(ARGB8888);
+        break;
+    }
+    return 0;
+}
+
+static void st7262_panel_get_caps(panel_caps_t *caps)
+{
+    caps->name = "st7262";
+    caps->width = WIDTH;
+    caps->height = HEIGHT;
+    caps->formats = PANEL_FORMAT_RGB565 | PANEL_FORMAT_RGB888 | PANEL_FORMAT_ARGB8888;
+    caps->flags = PANEL_CAP_SCANOUT;
+}
+
+static void st7262_panel_register_done_cb(panel_done_cb_t cb, void *user_data)
+{
+    g_panel_done_cb = cb;
+    g_panel_done_data = user_data;
+    g_panel_callback.VBlank = st7262_panel_done;
+    st7262_register_callback(&g_panel_callback, NULL);
+}
+
+const panel_ops_t st7262_panel_ops = {
+    .init = st7262_panel_init,
+    .get_caps = st7262_panel_get_caps,
+    .flush_full = st7262_clean_invalidate_buffer,
+    .flush_area = NULL,
+    .set_window = NULL,
+    .register_done_cb = st7262_panel_register_done_cb,
+};
@@ -2,6 +2,7 @@
 #define _ST7262_H
 
 #include "ameba_soc.h"
+#include "panel.h"
 
 typedef enum {
 	RGB565,
@@ -17,4 +18,7 @@ void st7262_get_info(int *width, int *height);
 void st7262_clean_invalidate_buffer(u8 *buffer);
 void st7262_register_callback(ST7262VBlankCallback *callback, void *data);
 
+/* Common panel interface, see panel.h */
+extern const panel_ops_t st7262_panel_ops;
+
 #endif
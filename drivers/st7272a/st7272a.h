@@ -2,6 +2,7 @@
 #define _ST7272A_H
 
 #include "ameba_soc.h"
+#include "panel.h"
 
 typedef enum {
 	RGB565,
@@ -17,4 +18,7 @@ void st7272a_get_info(int *width, int *height);
 void st7272a_clean_invalidate_buffer(u8 *buffer);
 void st7272a_register_callback(ST7272AVBlankCallback *callback, void *data);
 
+/* Common panel interface, see panel.h */
+extern const panel_ops_t st7272a_panel_ops;
+
 #endif
@@ -100,12 +100,19 @@ typedef struct {
 static u32 g_ST7701S_init_done = 0;
 static u32 g_ST7701S_send_cmd = 1;
 static u32 g_under_flow_cnt = 0;
+static u32 g_underflow_total = 0;
+static u32 g_underflow_resets = 0;
+static u64 g_underflow_ns = 0;
+static st7701s_underflow_cb g_underflow_cb = NULL;
+static void *g_underflow_data = NULL;
 static LCDC_InitTypeDef g_lcdc_init_struct;
 static MIPI_InitTypeDef g_mipi_init_struct;
 
 static ST7701SVBlankCallback *g_callback = NULL;
 static void *g_data = NULL;
 static int g_color_depth = 0;
+static int g_plane_depth[ST7701S_PLANE_NUM];
+static int g_ui_plane = 0;
 
 static int g_first_flag = 1;
 
@@ -437,6 +444,7 @@ static void mipi_dsi_underflow_reset(void)
 
     if (reg_val) {
         g_under_flow_cnt = 0;
+        g_underflow_resets++;
         MIPI_DSI_INT_Config(MIPI, DISABLE, DISABLE, DISABLE);
 
         /*Disable the LCDC*/
@@ -457,6 +465,12 @@ static u32 lcdc_underflow_isr(void *data)
     volatile u32 IntId = LCDC_GetINTStatus(LCDCx);
 
     if (IntId & LCDC_BIT_DMA_UN_INTS) {
+        g_underflow_total++;
+        g_underflow_ns = rtos_time_get_current_system_time_ns();
+        if (g_underflow_cb) {
+            g_underflow_cb(g_underflow_total, g_underflow_data);
+        }
+
         g_under_flow_cnt++;
         if (g_under_flow_cnt == 1) {
             printf("[warn] DMA Under--------------------\n");
@@ -507,6 +521,8 @@ static void lcdc_init_config(int width, int height, int image_format)
         image_format = LCDC_LAYER_IMG_FORMAT_ARGB8888;
         g_color_depth = 4;
     }
+    g_plane_depth[0] = g_color_depth;
+    g_ui_plane = 0;
 
     g_lcdc_init_struct.layerx[0].LCDC_LayerImgFormat = image_format;
     g_lcdc_init_struct.layerx[0].LCDC_LayerHorizontalStart = 1;/*1-based*/
@@ -553,17 +569,88 @@ void st7701s_init(int image_format)
     lcdc_display_init(image_format);
 }
 
-static void lcdc_layer_config(u8 *buffer)
+static void lcdc_layer_config(int plane, u8 *buffer)
 {
-    DCache_CleanInvalidate(buffer, LCDC_TEST_IMG_BUF_X * LCDC_TEST_IMG_BUF_Y * g_color_depth);
-    g_lcdc_init_struct.layerx[0].LCDC_LayerImgBaseAddr = (u32)buffer;
-    LCDC_LayerConfig(LCDC, LCDC_LAYER_LAYER1, &g_lcdc_init_struct.layerx[LCDC_LAYER_LAYER1]);
+    LCDC_LayerConfigTypeDef *layer = &g_lcdc_init_struct.layerx[plane];
+    u32 width = layer->LCDC_LayerHorizontalStop - layer->LCDC_LayerHorizontalStart + 1;
+    u32 height = layer->LCDC_LayerVerticalStop - layer->LCDC_LayerVerticalStart + 1;
+
+    DCache_CleanInvalidate((u32)buffer, width * height * g_plane_depth[plane]);
+    layer->LCDC_LayerImgBaseAddr = (u32)buffer;
+    LCDC_LayerConfig(LCDC, LCDC_LAYER_LAYER1 + plane, layer);
     LCDC_TrigerSHWReload(LCDC);
 }
 
 void st7701s_clean_invalidate_buffer(u8 *buffer)
 {
-    lcdc_layer_config(buffer);
+    lcdc_layer_config(g_ui_plane, buffer);
+}
+
+int st7701s_plane_setup(int plane, st7701s_plane_config *config)
+{
+    if (plane < 0 || plane >= ST7701S_PLANE_NUM || !config->buffer ||
+        config->x < 0 || config->y < 0 || config->width <= 0 || config->height <= 0 ||
+        config->x + config->width > LCDC_TEST_IMG_BUF_X || config->y + config->height > LCDC_TEST_IMG_BUF_Y) {
+        printf("[st7701s] invalid plane %d config\n", plane);
+        return -1;
+    }
+
+    LCDC_LayerConfigTypeDef *layer = &g_lcdc_init_struct.layerx[plane];
+    layer->LCDC_LayerEn = ENABLE;
+    if (config->image_format == RGB565) {
+        layer->LCDC_LayerImgFormat = LCDC_LAYER_IMG_FORMAT_RGB565;
+        g_plane_depth[plane] = 2;
+    } else {
+        layer->LCDC_LayerImgFormat = LCDC_LAYER_IMG_FORMAT_ARGB8888;
+        g_plane_depth[plane] = 4;
+    }
+    layer->LCDC_LayerHorizontalStart = config->x + 1;/*1-based*/
+    layer->LCDC_LayerHorizontalStop = config->x + config->width;
+    layer->LCDC_LayerVerticalStart = config->y + 1;/*1-based*/
+    layer->LCDC_LayerVerticalStop = config->y + config->height;
+    layer->LCDC_LayerConstAlpha = config->alpha;
+    layer->LCDC_LayerColorKeyingEn = config->color_key_en ? ENABLE : DISABLE;
+    layer->LCDC_LayerColorKeyingVal = config->color_key;
+
+    lcdc_layer_config(plane, config->buffer);
+
+    return 0;
+}
+
+void st7701s_plane_disable(int plane)
+{
+    if (plane < 0 || plane >= ST7701S_PLANE_NUM || plane == g_ui_plane) {
+        return;
+    }
+
+    g_lcdc_init_struct.layerx[plane].LCDC_LayerEn = DISABLE;
+    LCDC_LayerConfig(LCDC, LCDC_LAYER_LAYER1 + plane, &g_lcdc_init_struct.layerx[plane]);
+    LCDC_TrigerSHWReload(LCDC);
+}
+
+void st7701s_plane_set_buffer(int plane, u8 *buffer)
+{
+    if (plane < 0 || plane >= ST7701S_PLANE_NUM || !g_lcdc_init_struct.layerx[plane].LCDC_LayerEn) {
+        return;
+    }
+
+    lcdc_layer_config(plane, buffer);
+}
+
+int st7701s_set_ui_plane(int plane, st7701s_plane_config *config)
+{
+    int old_plane = g_ui_plane;
+
+    if (st7701s_plane_setup(plane, config) != 0) {
+        return -1;
+    }
+
+    g_ui_plane = plane;
+    if (old_plane != plane) {
+        st7701s_plane_disable(old_plane);
+    }
+
+    return 0;
 }
 
 void st7701s_get_info(int *width, int *height)
@@ -577,3 +664,64 @@ void st7701s_register_callback(ST7701SVBlankCallback *callback, void *data)
     g_callback = callback;
     g_data = data;
 }
+
+void st7701s_register_underflow_callback(st7701s_underflow_cb callback, void *data)
+{
+    g_underflow_cb = callback;
+    g_underflow_data = data;
+}
+
+void st7701s_get_underflow_info(st7701s_underflow_info *info)
+{
+    info->count = g_underflow_total;
+    info->resets = g_underflow_resets;
+    info->last_ns = g_underflow_ns;
+}
+
+static panel_done_cb_t g_panel_done_cb = NULL;
+static void *g_panel_done_data = NULL;
+static ST7701SVBlankCallback g_panel_callback;
+
+static void st7701s_panel_done(void *data)
+{
+    UNUSED(data);
+    if (g_panel_done_cb) {
+        g_panel_done_cb(g_panel_done_data);
+    }
+}
+
+static int st7701s_panel_init(panel_format_t format)
+{
+    if (format == PANEL_FORMAT_RGB888) {
+        return -1;
+    }
+
+    st7701s_init(format == PANEL_FORMAT_RGB565 ? RGB565 : ARGB8888);
+    return 0;
+}
+
+static void st7701s_panel_get_caps(panel_caps_t *caps)
+{
+    caps->name = "st7701s";
+    caps->width = LCDC_TEST_IMG_BUF_X;
+    caps->height = LCDC_TEST_IMG_BUF_Y;
+    caps->formats = PANEL_FORMAT_RGB565 | PANEL_FORMAT_ARGB8888;
+    caps->flags = PANEL_CAP_SCANOUT;
+}
+
+static void st7701s_panel_register_done_cb(panel_done_cb_t cb, void *user_data)
+{
+    g_panel_done_cb = cb;
+    g_panel_done_data = user_data;
+    g_panel_callback.VBlank = st7701s_panel_done;
+    st7701s_register_callback(&g_panel_callback, NULL);
+}
+
+const panel_ops_t st7701s_panel_ops = {
+    .init = st7701s_panel_init,
+    .get_caps = st7701s_panel_get_caps,
+    .flush_full = st7701s_clean_invalidate_buffer,
+    .flush_area = NULL,
+    .set_window = NULL,
+    .register_done_cb = st7701s_panel_register_done_cb,
+};
@@ -2,6 +2,7 @@
 #define _ST7701S_H
 
 #include "ameba_soc.h"
+#include "panel.h"
 
 typedef enum {
 	RGB565,
@@ -11,9 +12,46 @@ typedef enum {
 typedef struct {
 	void (*VBlank)(void *user_data);
 } ST7701SVBlankCallback;
+
+typedef struct {
+	u32 count;			/* DMA underflows since init */
+	u32 resets;			/* MIPI resets done to recover */
+	u64 last_ns;		/* time of the last one, 0 for none */
+} st7701s_underflow_info;
+
+/* Called from the LCDC interrupt with the total underflow count */
+typedef void (*st7701s_underflow_cb)(u32 count, void *user_data);
+
+/* LCDC layers, plane 0 is the bottom one. The UI (LVGL) is on plane 0 after init. */
+#define ST7701S_PLANE_NUM	3
+
+typedef struct {
+	u8 *buffer;
+	int image_format;	/* RGB565 or ARGB8888 */
+	int x;				/* window on the panel, buffer lines are width pixels */
+	int y;
+	int width;
+	int height;
+	u8 alpha;			/* constant alpha, 0xFF opaque. ARGB8888 also blends per pixel */
+	int color_key_en;
+	u32 color_key;		/* pixels of this color show the planes below */
+} st7701s_plane_config;
+
 void st7701s_init(int image_format);
 void st7701s_get_info(int *width, int *height);
 void st7701s_clean_invalidate_buffer(u8 *buffer);
 void st7701s_register_callback(ST7701SVBlankCallback *callback, void *data);
+void st7701s_register_underflow_callback(st7701s_underflow_cb callback, void *data);
+void st7701s_get_underflow_info(st7701s_underflow_info *info);
+
+/* Changes take effect at the next frame */
+int st7701s_plane_setup(int plane, st7701s_plane_config *config);
+void st7701s_plane_disable(int plane);
+void st7701s_plane_set_buffer(int plane, u8 *buffer);
+/* Move the UI layer that st7701s_clean_invalidate_buffer flips to another plane */
+int st7701s_set_ui_plane(int plane, st7701s_plane_config *config);
+
+/* Common panel interface, see panel.h */
+extern const panel_ops_t st7701s_panel_ops;
 
 #endif
\ No newline at end of file
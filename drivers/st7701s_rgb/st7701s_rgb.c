@@ -343,3 +343,51 @@ void st7701s_rgb_register_callback(ST7701S_RGBVBlankCallback *callback, void *da
     g_callback = callback;
     g_data = data;
 }
+
+static panel_done_cb_t g_panel_done_cb = NULL;
+static void *g_panel_done_data = NULL;
+static ST7701S_RGBVBlankCallback g_panel_callback;
+
+static void st7701s_rgb_panel_done(void *data)
+{
+    UNUSED(data);
+    if (g_panel_done_cb) {
+        g_panel_done_cb(g_panel_done_data);
+    }
+}
+
+static int st7701s_rgb_panel_init(panel_format_t format)
+{
+    if (format != PANEL_FORMAT_RGB565) {
+        return -1;
+    }
+
+    st7701s_rgb_init(RGB565);
+    return 0;
+}
+
+static void st7701s_rgb_panel_get_caps(panel_caps_t *caps)
+{
+    caps->name = "st7701s_rgb";
+    caps->width = WIDTH;
+    caps->height = HEIGHT;
+    caps->formats = PANEL_FORMAT_RGB565;
+    caps->flags = PANEL_CAP_SCANOUT;
+}
+
+static void st7701s_rgb_panel_register_done_cb(panel_done_cb_t cb, void *user_data)
+{
+    g_panel_done_cb = cb;
+    g_panel_done_data = user_data;
+    g_panel_callback.VBlank = st7701s_rgb_panel_done;
+    st7701s_rgb_register_callback(&g_panel_callback, NULL);
+}
+
+const panel_ops_t st7701s_rgb_panel_ops = {
+    .init = st7701s_rgb_panel_init,
+    .get_caps = st7701s_rgb_panel_get_caps,
+    .flush_full = st7701s_rgb_clean_invalidate_buffer,
+    .flush_area = NULL,
+    .set_window = NULL,
+    .register_done_cb = st7701s_rgb_panel_register_done_cb,
+};
@@ -2,6 +2,7 @@
 #define _ST7701S_RGB_H
 
 #include "ameba_soc.h"
+#include "panel.h"
 
 typedef enum {
 	RGB565,
@@ -16,4 +17,7 @@ void st7701s_rgb_get_info(int *width, int *height);
 void st7701s_rgb_clean_invalidate_buffer(u8 *buffer);
 void st7701s_rgb_register_callback(ST7701S_RGBVBlankCallback *callback, void *data);
 
+/* Common panel interface, see panel.h */
+extern const panel_ops_t st7701s_rgb_panel_ops;
+
 #endif
@@ -18,6 +18,8 @@
 #include "spi_api.h"
 #include "spi_ex_api.h"
 #include "gpio_api.h"
+#include "panel_cmd.h"
+#include "panel_te.h"
 #include "st7789v.h"
 
 #define SPI_SCLK_PIN       _PA_28  //SCL
@@ -29,6 +31,10 @@
 
 #define SPI_MISO_PIN       _PA_30
 
+#define SPI_DEF_HZ         50000000
+#define SPI_MAX_HZ         62500000  //16 ns serial write cycle
+#define SPI_READ_HZ        6000000   //150 ns serial read cycle
+
 #define WIDTH              240
 #define HEIGHT             320
 #define MEM_SIZE           WIDTH * HEIGHT * 2        //rgb565
@@ -37,6 +43,7 @@ static ST7789VVBlankCallback *g_callback = NULL;
 static void *g_data = NULL;
 
 static spi_t spi_lcd;
+static panel_bus_config_t g_bus_config = {SPI_DEF_HZ, 1, 0};
 
 static void LCD_WR_REG(u16 data)
 {
@@ -56,6 +63,7 @@ void spi_tx_done_callback(uint32_t pdata, SpiIrq event)
 
     switch (event) {
     case SpiTxIrq:
+        panel_te_transfer_done();
         if (g_callback) {
             g_callback->VBlank(g_data);
         }
@@ -65,108 +73,69 @@ void spi_tx_done_callback(uint32_t pdata, SpiIrq event)
     }
 }
 
-static void LCD_WR_PIX(u8 *pbuf, u16 x0, u16 y0, u16 x1, u16 y1)
+/* Payloads are at most PANEL_CMD_MAX_DATA bytes, cheaper to write than to set up DMA for */
+static void st7789v_bus_write(void *ctx, u8 cmd, const u8 *data, u32 len)
 {
-    LCD_WR_REG(0x2a);
-    LCD_WR_DATA8(x0 >> 8);
-    LCD_WR_DATA8(x0 & 0xff);
-    LCD_WR_DATA8(x1 >> 8);
-    LCD_WR_DATA8(x1 & 0xff);
-    LCD_WR_REG(0x2b);
-    LCD_WR_DATA8(y0 >> 8);
-    LCD_WR_DATA8(y0 & 0xff);
-    LCD_WR_DATA8(y1 >> 8);
-    LCD_WR_DATA8(y1 & 0xff);
-    LCD_WR_REG(0x2c);
+    UNUSED(ctx);
+    LCD_WR_REG(cmd);
+    for (u32 i = 0; i < len; i++) {
+        LCD_WR_DATA8(data[i]);
+    }
+}
 
-    spi_master_write_stream_dma(&spi_lcd, (char *) pbuf, (x1 - x0 + 1) * (y1 - y0 + 1) * 2);
+static void st7789v_bus_delay(u32 ms)
+{
+    DelayMs(ms);
 }
 
-static void st7789v_config_init(void)
+static const panel_bus_t g_bus = {
+    .ctx = NULL,
+    .write = st7789v_bus_write,
+    .delay_ms = st7789v_bus_delay,
+};
+
+static panel_cmd_window_t g_window;
+
+static void LCD_SET_WINDOW(u16 x0, u16 y0, u16 x1, u16 y1)
 {
-    LCD_WR_REG(0x11);
-    DelayMs(120);
+    panel_cmd_set_window(&g_bus, &g_window, x0, y0, x1, y1);
+}
 
-    LCD_WR_REG(0x36);
-    LCD_WR_DATA8(0x0);
-
-    LCD_WR_REG(0x3A);
-    LCD_WR_DATA8(0x05);
-
-    LCD_WR_REG(0xB2);
-    LCD_WR_DATA8(0x0C);
-    LCD_WR_DATA8(0x0C);
-    LCD_WR_DATA8(0x00);
-    LCD_WR_DATA8(0x33);
-    LCD_WR_DATA8(0x33);
-
-    LCD_WR_REG(0xB7);
-    LCD_WR_DATA8(0x71);
-
-    LCD_WR_REG(0xBB);
-    LCD_WR_DATA8(0x3B);
-
-    LCD_WR_REG(0xC0);
-    LCD_WR_DATA8(0x2C);
-
-    LCD_WR_REG(0xC2);
-    LCD_WR_DATA8(0x01);
-
-    LCD_WR_REG(0xC3);
-    LCD_WR_DATA8(0x13);
-
-    LCD_WR_REG(0xC4);
-    LCD_WR_DATA8(0x20);
-
-    LCD_WR_REG(0xC6);
-    LCD_WR_DATA8(0x0F);
-
-    LCD_WR_REG(0xD0);
-    LCD_WR_DATA8(0xA4);
-    LCD_WR_DATA8(0xA1);
-
-    LCD_WR_REG(0xD6);
-    LCD_WR_DATA8(0xA1);
-
-    LCD_WR_REG(0xE0);
-    LCD_WR_DATA8(0xD0);
-    LCD_WR_DATA8(0x08);
-    LCD_WR_DATA8(0x0A);
-    LCD_WR_DATA8(0x0D);
-    LCD_WR_DATA8(0x0B);
-    LCD_WR_DATA8(0x07);
-    LCD_WR_DATA8(0x21);
-    LCD_WR_DATA8(0x33);
-    LCD_WR_DATA8(0x39);
-    LCD_WR_DATA8(0x39);
-    LCD_WR_DATA8(0x16);
-    LCD_WR_DATA8(0x16);
-    LCD_WR_DATA8(0x1F);
-    LCD_WR_DATA8(0x3C);
-
-    LCD_WR_REG(0xE1);
-    LCD_WR_DATA8(0xD0);
-    LCD_WR_DATA8(0x00);
-    LCD_WR_DATA8(0x03);
-    LCD_WR_DATA8(0x01);
-    LCD_WR_DATA8(0x00);
-    LCD_WR_DATA8(0x10);
-    LCD_WR_DATA8(0x21);
-    LCD_WR_DATA8(0x32);
-    LCD_WR_DATA8(0x38);
-    LCD_WR_DATA8(0x16);
-    LCD_WR_DATA8(0x14);
-    LCD_WR_DATA8(0x14);
-    LCD_WR_DATA8(0x20);
-    LCD_WR_DATA8(0x3D);
-
-    LCD_WR_REG(0x21);
+static void LCD_WR_PIX(u8 *pbuf, u16 x0, u16 y0, u16 x1, u16 y1)
+{
+    u32 len = (x1 - x0 + 1) * (y1 - y0 + 1) * 2;
 
-    DelayMs(120);
+    panel_te_sync(y0, y1, len);
+    LCD_SET_WINDOW(x0, y0, x1, y1);
+    LCD_WR_REG(0x2c);
 
-    LCD_WR_REG(0x29);
+    spi_master_write_stream_dma(&spi_lcd, (char *) pbuf, len);
+}
 
-    DelayMs(120);
+static const panel_cmd_t st7789v_init_cmds[] = {
+    {0x11, 0, 120, {0}},
+    {0x36, 1, 0, {0x00}},
+    {0x3A, 1, 0, {0x05}},
+    {0xB2, 5, 0, {0x0C, 0x0C, 0x00, 0x33, 0x33}},
+    {0xB7, 1, 0, {0x71}},
+    {0xBB, 1, 0, {0x3B}},
+    {0xC0, 1, 0, {0x2C}},
+    {0xC2, 1, 0, {0x01}},
+    {0xC3, 1, 0, {0x13}},
+    {0xC4, 1, 0, {0x20}},
+    {0xC6, 1, 0, {0x0F}},
+    {0xD0, 2, 0, {0xA4, 0xA1}},
+    {0xD6, 1, 0, {0xA1}},
+    {0xE0, 14, 0, {0xD0, 0x08, 0x0A, 0x0D, 0x0B, 0x07, 0x21, 0x33, 0x39, 0x39, 0x16, 0x16, 0x1F, 0x3C}},
+    {0xE1, 14, 0, {0xD0, 0x00, 0x03, 0x01, 0x00, 0x10, 0x21, 0x32, 0x38, 0x16, 0x14, 0x14, 0x20, 0x3D}},
+    {0x21, 0, 120, {0}},
+    {0x29, 0, 120, {0}},
+};
+
+static void st7789v_config_init(void)
+{
+    panel_cmd_exec(&g_bus, st7789v_init_cmds, PANEL_CMD_COUNT(st7789v_init_cmds));
+    panel_cmd_window_reset(&g_window);
 }
 
 void st7789v_init(void)
@@ -174,7 +143,7 @@ void st7789v_init(void)
     spi_lcd.spi_idx = MBED_SPI1;
     spi_init(&spi_lcd, SPI_MOSI_PIN, SPI_MISO_PIN, SPI_SCLK_PIN, SPI_CS_PIN);
     spi_format(&spi_lcd, 8, 3, 0);
-    spi_frequency(&spi_lcd, 50000000);
+    spi_frequency(&spi_lcd, g_bus_config.clock_hz);
 
     spi_irq_hook(&spi_lcd, (spi_irq_handler) spi_tx_done_callback, (uint32_t)&spi_lcd);
 
@@ -230,3 +199,162 @@ void st7789v_clean_invalidate_buffer(uint8_t *buffer)
     LCD_WR_PIX(buffer, 0, 0, WIDTH-1, HEIGHT-1);
 }
 
+void st7789v_flush_area(u8 *buffer, int x1, int y1, int x2, int y2)
+{
+    DCache_Clean((u32)buffer, (x2 - x1 + 1) * (y2 - y1 + 1) * 2);
+    LCD_WR_PIX(buffer, x1, y1, x2, y2);
+}
+
+int st7789v_te_enable(u32 pin)
+{
+    if (panel_te_init(pin, HEIGHT) != 0) {
+        return -1;
+    }
+
+    /* TEON, V-blanking only */
+    u8 mode = 0x00;
+    st7789v_bus_write(NULL, 0x35, &mode, 1);
+    return 0;
+}
+
+void st7789v_te_disable(void)
+{
+    /* TEOFF */
+    st7789v_bus_write(NULL, 0x34, NULL, 0);
+    panel_te_deinit();
+}
+
+static void st7789v_set_window(int x1, int y1, int x2, int y2)
+{
+    LCD_SET_WINDOW(x1, y1, x2, y2);
+}
+
+static panel_done_cb_t g_panel_done_cb = NULL;
+static void *g_panel_done_data = NULL;
+static ST7789VVBlankCallback g_panel_callback;
+
+static void st7789v_panel_done(void *data)
+{
+    UNUSED(data);
+    if (g_panel_done_cb) {
+        g_panel_done_cb(g_panel_done_data);
+    }
+}
+
+static int st7789v_panel_init(panel_format_t format)
+{
+    if (format != PANEL_FORMAT_RGB565) {
+        return -1;
+    }
+
+    st7789v_init();
+    return 0;
+}
+
+static void st7789v_panel_get_caps(panel_caps_t *caps)
+{
+    caps->name = "st7789v";
+    caps->width = WIDTH;
+    caps->height = HEIGHT;
+    caps->formats = PANEL_FORMAT_RGB565;
+    caps->flags = PANEL_CAP_PARTIAL_UPDATE | PANEL_CAP_HW_SCROLL;
+    caps->bus.max_clock_hz = SPI_MAX_HZ;
+    caps->bus.lanes = PANEL_LANES_1;
+    caps->bus.ddr = 0;
+}
+
+static int st7789v_panel_set_bus(const panel_bus_config_t *config)
+{
+    if (config->lanes != 1 || config->ddr || !config->clock_hz || config->clock_hz > SPI_MAX_HZ) {
+        return -1;
+    }
+
+    spi_frequency(&spi_lcd, config->clock_hz);
+    g_bus_config = *config;
+    return 0;
+}
+
+static void st7789v_panel_get_bus(panel_bus_config_t *config)
+{
+    *config = g_bus_config;
+}
+
+/*
+ * Write a few pixels at the current clock, then read them back with RAMRD at the read
+ * clock. Needs MISO wired. RAMRD starts with a dummy byte and returns RGB666, one byte
+ * per color with the bits at the top.
+ */
+static int st7789v_panel_self_test(void)
+{
+    static const u16 pattern[8] = {0xF800, 0x07E0, 0x001F, 0xFFFF, 0x0000, 0xA55A, 0x5AA5, 0x1234};
+    u8 data[sizeof(pattern)];
+    int ret = 0;
+
+    for (int i = 0; i < 8; i++) {
+        data[2 * i] = pattern[i] >> 8;
+        data[2 * i + 1] = pattern[i] & 0xff;
+    }
+    LCD_SET_WINDOW(0, 0, 7, 0);
+    st7789v_bus_write(NULL, 0x2C, data, sizeof(data));
+
+    spi_frequency(&spi_lcd, SPI_READ_HZ);
+    LCD_WR_REG(0x2E);
+    spi_master_write(&spi_lcd, 0xFF);
+    for (int i = 0; i < 8; i++) {
+        u8 r = spi_master_write(&spi_lcd, 0xFF);
+        u8 g = spi_master_write(&spi_lcd, 0xFF);
+        u8 b = spi_master_write(&spi_lcd, 0xFF);
+        u16 px = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+        if (px != pattern[i]) {
+            ret = -1;
+            break;
+        }
+    }
+    spi_frequency(&spi_lcd, g_bus_config.clock_hz);
+
+    return ret;
+}
+
+static void st7789v_panel_register_done_cb(panel_done_cb_t cb, void *user_data)
+{
+    g_panel_done_cb = cb;
+    g_panel_done_data = user_data;
+    g_panel_callback.VBlank = st7789v_panel_done;
+    st7789v_register_callback(&g_panel_callback, NULL);
+}
+
+static int st7789v_panel_set_scroll_area(int top, int height)
+{
+    if (top < 0 || height <= 0 || top + height > HEIGHT) {
+        return -1;
+    }
+
+    /* VSCRDEF: top fixed, scroll and bottom fixed lines */
+    int bottom = HEIGHT - top - height;
+    u8 data[6] = {top >> 8, top & 0xff, height >> 8, height & 0xff, bottom >> 8, bottom & 0xff};
+    st7789v_bus_write(NULL, 0x33, data, 6);
+    panel_te_set_scroll_area(top, height);
+    return 0;
+}
+
+static void st7789v_panel_set_scroll_start(int line)
+{
+    /* VSCSAD */
+    u8 data[2] = {line >> 8, line & 0xff};
+    st7789v_bus_write(NULL, 0x37, data, 2);
+    panel_te_set_scroll_start(line);
+}
+
+const panel_ops_t st7789v_panel_ops = {
+    .init = st7789v_panel_init,
+    .get_caps = st7789v_panel_get_caps,
+    .flush_full = st7789v_clean_invalidate_buffer,
+    .flush_area = st7789v_flush_area,
+    .set_window = st7789v_set_window,
+    .register_done_cb = st7789v_panel_register_done_cb,
+    .set_bus = st7789v_panel_set_bus,
+    .get_bus = st7789v_panel_get_bus,
+    .self_test = st7789v_panel_self_test,
+    .set_scroll_area = st7789v_panel_set_scroll_area,
+    .set_scroll_start = st7789v_panel_set_scroll_start,
+};
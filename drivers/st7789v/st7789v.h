@@ -2,6 +2,7 @@
 #define _ST7789V_H
 
 #include "ameba_soc.h"
+#include "panel.h"
 
 typedef struct {
 	void (*VBlank)(void *user_data);
@@ -12,5 +13,13 @@ void st7789v_get_info(int *width, int *height);
 void st7789v_clean_invalidate_buffer(u8 *buffer);
 
 void st7789v_register_callback(ST7789VVBlankCallback *callback, void *data);
+/* Send a buffer holding only the area (x2, y2 inclusive), VBlank is called when done */
+void st7789v_flush_area(u8 *buffer, int x1, int y1, int x2, int y2);
+/* Sync transfers to the panel TE output wired to pin, counters in panel_te_get_info */
+int st7789v_te_enable(u32 pin);
+void st7789v_te_disable(void);
+
+/* Common panel interface, see panel.h */
+extern const panel_ops_t st7789v_panel_ops;
 
 #endif
\ No newline at end of file
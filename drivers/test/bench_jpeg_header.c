@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Info call cost over a JPEG corpus: the SOF scanner reading through a file against what
+ * decoder_info_cb did before, loading the whole file and parsing it with a full decoder
+ * instance (libjpeg-turbo here). Also checks both agree on the size.
+ *   bench_jpeg_header [dir] [iterations]
+ */
+
+#include <dirent.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "jpeglib.h"
+#include "jpeg_header.h"
+
+typedef struct {
+    struct jpeg_error_mgr pub;
+    jmp_buf jb;
+} bench_error_mgr_t;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+typedef struct {
+    FILE *f;
+    uint32_t bytes;
+} file_stream_t;
+
+static bool file_read(void *user_data, uint32_t offset, uint8_t *buf, uint32_t len)
+{
+    file_stream_t *stream = user_data;
+
+    stream->bytes += len;
+    return fseek(stream->f, offset, SEEK_SET) == 0 && fread(buf, 1, len, stream->f) == len;
+}
+
+/* Bytes the scanner asked for in *bytes, the whole file is what the old path read */
+static int scan_file(const char *path, jpeg_header_t *header, uint32_t *bytes)
+{
+    file_stream_t stream = {0};
+    int ret;
+
+    stream.f = fopen(path, "rb");
+    if (!stream.f) {
+        return -1;
+    }
+    ret = jpeg_header_parse(file_read, &stream, header);
+    fclose(stream.f);
+    *bytes = stream.bytes;
+    return ret;
+}
+
+static void bench_error_exit(j_common_ptr cinfo)
+{
+    longjmp(((bench_error_mgr_t *)cinfo->err)->jb, 1);
+}
+
+/* Whole file into memory, then a decoder instance reads the header */
+static int full_info(const char *path, uint32_t *width, uint32_t *height, uint32_t *bytes)
+{
+    struct jpeg_decompress_struct cinfo;
+    bench_error_mgr_t jerr;
+    FILE *f = fopen(path, "rb");
+    uint8_t *data;
+    long size;
+    int ret = -1;
+
+    if (!f) {
+        return -1;
+    }
+    fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    data = malloc(size);
+    if (!data || fread(data, 1, size, f) != (size_t)size) {
+        free(data);
+        fclose(f);
+        return -1;
+    }
+    fclose(f);
+    *bytes = size;
+
+    cinfo.err = jpeg_std_error(&jerr.pub);
+    jerr.pub.error_exit = bench_error_exit;
+    if (setjmp(jerr.jb)) {
+        jpeg_destroy_decompress(&cinfo);
+        free(data);
+        return -1;
+    }
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, data, size);
+    if (jpeg_read_header(&cinfo, TRUE) == JPEG_HEADER_OK) {
+        *width = cinfo.image_width;
+        *height = cinfo.image_height;
+        ret = 0;
+    }
+    jpeg_destroy_decompress(&cinfo);
+    free(data);
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    const char *dir_path = argc > 1 ? argv[1] : "jpeg";
+    int iterations = argc > 2 ? atoi(argv[2]) : 200;
+    DIR *dir = opendir(dir_path);
+    struct dirent *ent;
+    uint64_t scan_total = 0;
+    uint64_t full_total = 0;
+    int files = 0;
+    int failed = 0;
+
+    if (!dir || iterations <= 0) {
+        printf("usage: %s [dir] [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%-36s %8s %8s %10s %10s %8s\n", "file", "scan B", "full B", "scan ns", "full ns", "speedup");
+    while ((ent = readdir(dir)) != NULL) {
+        const char *ext = strrchr(ent->d_name, '.');
+        char path[1024];
+        jpeg_header_t header;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t scan_bytes = 0;
+        uint32_t full_bytes = 0;
+
+        if (!ext || (strcmp(ext, ".jpg") && strcmp(ext, ".jpeg"))) {
+            continue;
+        }
+        snprintf(path, sizeof(path), "%s/%s", dir_path, ent->d_name);
+
+        if (scan_file(path, &header, &scan_bytes) != 0 || full_info(path, &width, &height, &full_bytes) != 0 ||
+            header.width != width || header.height != height) {
+            printf("%-36s size mismatch or parse error\n", ent->d_name);
+            failed++;
+            continue;
+        }
+
+        uint64_t start = now_ns();
+        for (int i = 0; i < iterations; i++) {
+            scan_file(path, &header, &scan_bytes);
+        }
+        uint64_t scan_ns = (now_ns() - start) / iterations;
+
+        start = now_ns();
+        for (int i = 0; i < iterations; i++) {
+            full_info(path, &width, &height, &full_bytes);
+        }
+        uint64_t full_ns = (now_ns() - start) / iterations;
+
+        printf("%-36s %8u %8u %10llu %10llu %7.1fx\n", ent->d_name, (unsigned)scan_bytes,
+               (unsigned)full_bytes, (unsigned long long)scan_ns,
+               (unsigned long long)full_ns, scan_ns ? (double)full_ns / scan_ns : 0.0);
+        scan_total += scan_ns;
+        full_total += full_ns;
+        files++;
+    }
+    closedir(dir);
+
+    if (files) {
+        printf("%d files, %llu ns scan, %llu ns full per file on average\n", files,
+               (unsigned long long)(scan_total / files), (unsigned long long)(full_total / files));
+    }
+    return failed || !files;
+}
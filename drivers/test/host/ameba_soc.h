@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Host stand-in for the SDK basics the drivers under test use: types and logging */
+
+#ifndef HOST_AMEBA_SOC_H
+#define HOST_AMEBA_SOC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int32_t s32;
+
+#define SUCCESS         0
+#define FAIL            (-1)
+#define UNUSED(x)       ((void)(x))
+#ifndef BIT
+#define BIT(n)          (1UL << (n))
+#endif
+
+enum {
+    RTK_LOG_NONE,
+    RTK_LOG_ERROR,
+    RTK_LOG_WARN,
+    RTK_LOG_INFO,
+    RTK_LOG_DEBUG,
+};
+
+#define NOTAG           "host"
+
+/* Errors and warnings are printed, the rest would only clutter the test output */
+#define RTK_LOGS(tag, level, ...)   do { if ((level) <= RTK_LOG_WARN) { printf("[%s] ", tag); printf(__VA_ARGS__); } } while (0)
+#define RTK_LOGE(tag, ...)          RTK_LOGS(tag, RTK_LOG_ERROR, __VA_ARGS__)
+#define RTK_LOGW(tag, ...)          RTK_LOGS(tag, RTK_LOG_WARN, __VA_ARGS__)
+#define RTK_LOGI(tag, ...)          RTK_LOGS(tag, RTK_LOG_INFO, __VA_ARGS__)
+#define RTK_LOGD(tag, ...)          RTK_LOGS(tag, RTK_LOG_DEBUG, __VA_ARGS__)
+
+#define DCache_Clean(addr, len)         do { (void)(addr); (void)(len); } while (0)
+#define DCache_Invalidate(addr, len)    do { (void)(addr); (void)(len); } while (0)
+
+#endif
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Host stand-in for the mbed GPIO IRQ API, host_gpio_irq_fire() plays the edge */
+
+#ifndef HOST_GPIO_IRQ_API_H
+#define HOST_GPIO_IRQ_API_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "gpio_api.h"
+
+typedef enum {
+    IRQ_NONE,
+    IRQ_RISE,
+    IRQ_FALL,
+    IRQ_LOW,
+    IRQ_HIGH,
+} gpio_irq_event;
+
+typedef void (*gpio_irq_handler)(uint32_t id, uint32_t event);
+
+typedef struct {
+    PinName pin;
+    gpio_irq_handler handler;
+    uint32_t id;
+    gpio_irq_event event;
+    bool enabled;
+} gpio_irq_t;
+
+int gpio_irq_init(gpio_irq_t *obj, PinName pin, gpio_irq_handler handler, uint32_t id);
+void gpio_irq_deinit(gpio_irq_t *obj);
+void gpio_irq_set(gpio_irq_t *obj, gpio_irq_event event, uint32_t enable);
+void gpio_irq_enable(gpio_irq_t *obj);
+void gpio_irq_disable(gpio_irq_t *obj);
+
+#endif
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Controls of the host stand-ins for the tests */
+
+#ifndef HOST_H
+#define HOST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "lvgl.h"
+
+/* Free heap reported to the drivers: total minus the draw buffers alive */
+void host_heap_set_total(uint32_t total);
+/* Draw buffers created and not destroyed yet */
+uint32_t host_draw_buf_live(void);
+uint32_t host_draw_buf_bytes(void);
+
+/* rtos_time_* follows host_time_advance_ms() instead of the host clock, delays still sleep */
+void host_time_manual(bool manual);
+void host_time_advance_ms(uint32_t ms);
+
+/* Calls the handler of the enabled GPIO interrupt on pin, as its edge would. False if
+ * there is none. */
+bool host_gpio_irq_fire(uint32_t pin);
+
+/* Every lv_thread is blocked in lv_thread_sync_wait() with no signal pending */
+bool host_threads_idle(void);
+
+/* One LVGL timer handler run: every timer not paused is called once. Returns the number
+ * of timers that ran. */
+int host_timer_handler(void);
+
+/* Times img was invalidated, by lv_image_set_src or lv_obj_invalidate */
+struct host_obj;
+uint32_t host_obj_invalidated(const struct host_obj *obj);
+void host_obj_set_coords(lv_obj_t *obj, int32_t x1, int32_t y1, int32_t x2, int32_t y2);
+/* As lv_obj_scroll_to_y: LV_EVENT_SCROLL, then the object is invalidated */
+void host_obj_scroll_to_y(lv_obj_t *obj, int32_t y);
+
+/* Fills the pixels of area, px_map has the width of area as stride */
+typedef void (*host_render_cb_t)(const lv_area_t *area, uint8_t *px_map, void *user_data);
+void host_display_set_render_cb(lv_display_t *disp, host_render_cb_t cb, void *user_data);
+/* One refresh as lv_display_refr_timer: LV_EVENT_REFR_START, the invalidated areas rendered
+ * and flushed (partial mode in bands of the buffer size, full mode as one screen), then
+ * LV_EVENT_REFR_READY. Returns the number of flushes. */
+int host_display_refresh(lv_display_t *disp);
+
+/* host_jpeg.c, the jpeg_decoder_private.h API on libjpeg-turbo only */
+/* Decodes started by jpeg_decoder_decode_src() or jpeg_decoder_decode_into() */
+uint32_t host_jpeg_decode_count(void);
+/* While held, decodes block after being counted */
+void host_jpeg_hold(bool hold);
+/* Gradient test image as a baseline 4:2:0 JPEG, with a restart marker every MCU row
+ * if restart is set. Free with free(). */
+uint8_t *host_jpeg_encode(uint32_t w, uint32_t h, int quality, bool restart, size_t *size);
+
+#endif
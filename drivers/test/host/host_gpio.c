@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stddef.h>
+
+#include "gpio_irq_api.h"
+#include "host.h"
+
+#define HOST_GPIO_IRQ_MAX   4
+
+static gpio_irq_t *g_irqs[HOST_GPIO_IRQ_MAX];
+
+int gpio_irq_init(gpio_irq_t *obj, PinName pin, gpio_irq_handler handler, uint32_t id)
+{
+    for (int i = 0; i < HOST_GPIO_IRQ_MAX; i++) {
+        if (!g_irqs[i]) {
+            obj->pin = pin;
+            obj->handler = handler;
+            obj->id = id;
+            obj->event = IRQ_NONE;
+            obj->enabled = false;
+            g_irqs[i] = obj;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+void gpio_irq_deinit(gpio_irq_t *obj)
+{
+    for (int i = 0; i < HOST_GPIO_IRQ_MAX; i++) {
+        if (g_irqs[i] == obj) {
+            g_irqs[i] = NULL;
+        }
+    }
+}
+
+void gpio_irq_set(gpio_irq_t *obj, gpio_irq_event event, uint32_t enable)
+{
+    obj->event = enable ? event : IRQ_NONE;
+}
+
+void gpio_irq_enable(gpio_irq_t *obj)
+{
+    obj->enabled = true;
+}
+
+void gpio_irq_disable(gpio_irq_t *obj)
+{
+    obj->enabled = false;
+}
+
+bool host_gpio_irq_fire(uint32_t pin)
+{
+    for (int i = 0; i < HOST_GPIO_IRQ_MAX; i++) {
+        if (g_irqs[i] && g_irqs[i]->pin == pin && g_irqs[i]->enabled) {
+            g_irqs[i]->handler(g_irqs[i]->id, g_irqs[i]->event);
+            return true;
+        }
+    }
+    return false;
+}
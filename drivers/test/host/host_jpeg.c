@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "jpeglib.h"
+
+#include "lvgl.h"
+#include "host.h"
+#include "jpeg_cache.h"
+#include "jpeg_header.h"
+#include "jpeg_sw_decoder.h"
+#include "jpeg_decoder_private.h"
+
+static pthread_mutex_t g_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_cond = PTHREAD_COND_INITIALIZER;
+static uint32_t g_decodes;
+static bool g_hold;
+
+uint32_t host_jpeg_decode_count(void)
+{
+    pthread_mutex_lock(&g_lock);
+    uint32_t n = g_decodes;
+    pthread_mutex_unlock(&g_lock);
+    return n;
+}
+
+void host_jpeg_hold(bool hold)
+{
+    pthread_mutex_lock(&g_lock);
+    g_hold = hold;
+    pthread_cond_broadcast(&g_cond);
+    pthread_mutex_unlock(&g_lock);
+}
+
+/* Count a decode and block it while held */
+static void decode_gate(void)
+{
+    pthread_mutex_lock(&g_lock);
+    g_decodes++;
+    while (g_hold) {
+        pthread_cond_wait(&g_cond, &g_lock);
+    }
+    pthread_mutex_unlock(&g_lock);
+}
+
+static uint8_t *read_file(const char *path, uint32_t *size)
+{
+    FILE *f = fopen(path, "rb");
+    uint8_t *data = NULL;
+    long len;
+
+    if (!f) {
+        return NULL;
+    }
+    if (fseek(f, 0, SEEK_END) == 0 && (len = ftell(f)) > 0 && fseek(f, 0, SEEK_SET) == 0) {
+        data = malloc(len);
+        if (data && fread(data, 1, len, f) != (size_t)len) {
+            free(data);
+            data = NULL;
+        }
+        *size = len;
+    }
+    fclose(f);
+    return data;
+}
+
+lv_result_t jpeg_decoder_get_header(const uint8_t *data, uint32_t size, lv_image_header_t *header)
+{
+    jpeg_header_t jpeg;
+
+    if (jpeg_header_parse_mem(data, size, &jpeg) != 0) {
+        return LV_RESULT_INVALID;
+    }
+    memset(header, 0, sizeof(*header));
+    header->magic = LV_IMAGE_HEADER_MAGIC;
+    header->w = jpeg.width;
+    header->h = jpeg.height;
+    header->cf = jpeg_decoder_render_format();
+    return LV_RESULT_OK;
+}
+
+lv_color_format_t jpeg_decoder_render_format(void)
+{
+    return LV_COLOR_FORMAT_RGB565;
+}
+
+lv_result_t jpeg_decoder_decode_into(const uint8_t *data, uint32_t size, lv_draw_buf_t *decoded)
+{
+    decode_gate();
+    return jpeg_sw_decode(data, size, 8, NULL, decoded);
+}
+
+lv_result_t jpeg_decoder_decode_src(lv_image_src_t src_type, const void *src, bool reclaim, lv_draw_buf_t **decoded)
+{
+    const uint8_t *data;
+    uint8_t *file = NULL;
+    uint32_t size = 0;
+    lv_image_header_t header;
+    lv_result_t res = LV_RESULT_INVALID;
+
+    *decoded = NULL;
+    decode_gate();
+
+    if (src_type == LV_IMAGE_SRC_FILE) {
+        file = read_file(src, &size);
+        data = file;
+    } else if (src_type == LV_IMAGE_SRC_VARIABLE) {
+        data = ((const lv_image_dsc_t *)src)->data;
+        size = ((const lv_image_dsc_t *)src)->data_size;
+    } else {
+        return LV_RESULT_INVALID;
+    }
+
+    if (data && jpeg_decoder_get_header(data, size, &header) == LV_RESULT_OK) {
+        if (reclaim) {
+            jpeg_cache_reclaim(lv_draw_buf_width_to_stride(header.w, header.cf) * header.h);
+        }
+        lv_draw_buf_t *buf = lv_draw_buf_create(header.w, header.h, header.cf, 0);
+        if (buf) {
+            res = jpeg_sw_decode(data, size, 8, NULL, buf);
+            if (res == LV_RESULT_OK) {
+                *decoded = buf;
+            } else {
+                lv_draw_buf_destroy(buf);
+            }
+        }
+    }
+
+    free(file);
+    return res;
+}
+
+uint8_t *host_jpeg_encode(uint32_t w, uint32_t h, int quality, bool restart, size_t *size)
+{
+    struct jpeg_compress_struct cinfo;
+    struct jpeg_error_mgr jerr;
+    unsigned char *out = NULL;
+    unsigned long out_size = 0;
+    uint8_t *row = malloc(w * 3);
+
+    if (!row) {
+        return NULL;
+    }
+
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_compress(&cinfo);
+    jpeg_mem_dest(&cinfo, &out, &out_size);
+    cinfo.image_width = w;
+    cinfo.image_height = h;
+    cinfo.input_components = 3;
+    cinfo.in_color_space = JCS_RGB;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo, quality, TRUE);
+    cinfo.restart_in_rows = restart ? 1 : 0;
+    jpeg_start_compress(&cinfo, TRUE);
+
+    while (cinfo.next_scanline < h) {
+        uint32_t y = cinfo.next_scanline;
+        for (uint32_t x = 0; x < w; x++) {
+            row[x * 3] = x * 255 / (w > 1 ? w - 1 : 1);
+            row[x * 3 + 1] = y * 255 / (h > 1 ? h - 1 : 1);
+            row[x * 3 + 2] = (x + y) & 0xFF;
+        }
+        JSAMPROW rows[1] = { row };
+        jpeg_write_scanlines(&cinfo, rows, 1);
+    }
+
+    jpeg_finish_compress(&cinfo);
+    jpeg_destroy_compress(&cinfo);
+    free(row);
+
+    *size = out_size;
+    return out;
+}
@@ -0,0 +1,823 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lvgl.h"
+#include "host.h"
+
+static pthread_mutex_t g_buf_lock = PTHREAD_MUTEX_INITIALIZER;
+static uint32_t g_buf_live;
+static uint32_t g_buf_bytes;
+
+void *lv_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+void *lv_malloc_zeroed(size_t size)
+{
+    return calloc(1, size);
+}
+
+void *lv_realloc(void *data, size_t size)
+{
+    return realloc(data, size);
+}
+
+void lv_free(void *data)
+{
+    free(data);
+}
+
+char *lv_strdup(const char *src)
+{
+    return strdup(src);
+}
+
+int lv_strcmp(const char *s1, const char *s2)
+{
+    return strcmp(s1, s2);
+}
+
+lv_result_t lv_mutex_init(lv_mutex_t *mutex)
+{
+    pthread_mutexattr_t attr;
+
+    // LVGL mutexes are recursive
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_mutex_lock(lv_mutex_t *mutex)
+{
+    pthread_mutex_lock(mutex);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_mutex_unlock(lv_mutex_t *mutex)
+{
+    pthread_mutex_unlock(mutex);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_mutex_delete(lv_mutex_t *mutex)
+{
+    pthread_mutex_destroy(mutex);
+    return LV_RESULT_OK;
+}
+
+bool lv_area_intersect(lv_area_t *res, const lv_area_t *a1, const lv_area_t *a2)
+{
+    lv_area_t r = {
+        LV_MAX(a1->x1, a2->x1), LV_MAX(a1->y1, a2->y1),
+        LV_MIN(a1->x2, a2->x2), LV_MIN(a1->y2, a2->y2),
+    };
+
+    *res = r;
+    return r.x1 <= r.x2 && r.y1 <= r.y2;
+}
+
+lv_image_src_t lv_image_src_get_type(const void *src)
+{
+    const uint8_t *u8_p = src;
+
+    if (!src) {
+        return LV_IMAGE_SRC_UNKNOWN;
+    }
+    if (u8_p[0] >= 0x20 && u8_p[0] <= 0x7F) {
+        return LV_IMAGE_SRC_FILE;
+    }
+    if (u8_p[0] >= 0x80) {
+        return LV_IMAGE_SRC_SYMBOL;
+    }
+    return LV_IMAGE_SRC_VARIABLE;
+}
+
+uint8_t lv_color_format_get_size(lv_color_format_t cf)
+{
+    switch (cf) {
+    case LV_COLOR_FORMAT_L8:
+        return 1;
+    case LV_COLOR_FORMAT_RGB565:
+        return 2;
+    case LV_COLOR_FORMAT_RGB888:
+        return 3;
+    case LV_COLOR_FORMAT_ARGB8888:
+    case LV_COLOR_FORMAT_XRGB8888:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+uint32_t lv_draw_buf_width_to_stride(uint32_t w, lv_color_format_t cf)
+{
+    return w * lv_color_format_get_size(cf);
+}
+
+lv_result_t lv_draw_buf_init(lv_draw_buf_t *buf, uint32_t w, uint32_t h, lv_color_format_t cf, uint32_t stride,
+                             void *data, uint32_t data_size)
+{
+    memset(buf, 0, sizeof(*buf));
+    buf->header.magic = LV_IMAGE_HEADER_MAGIC;
+    buf->header.cf = cf;
+    buf->header.w = w;
+    buf->header.h = h;
+    buf->header.stride = stride ? stride : lv_draw_buf_width_to_stride(w, cf);
+    buf->data = data;
+    buf->unaligned_data = data;
+    buf->data_size = data_size;
+    return LV_RESULT_OK;
+}
+
+lv_draw_buf_t *lv_draw_buf_create(uint32_t w, uint32_t h, lv_color_format_t cf, uint32_t stride)
+{
+    lv_draw_buf_t *buf = malloc(sizeof(*buf));
+    uint32_t size;
+
+    if (!buf) {
+        return NULL;
+    }
+    stride = stride ? stride : lv_draw_buf_width_to_stride(w, cf);
+    size = stride * h;
+    lv_draw_buf_init(buf, w, h, cf, stride, calloc(1, size ? size : 1), size);
+    if (!buf->data) {
+        free(buf);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&g_buf_lock);
+    g_buf_live++;
+    g_buf_bytes += size;
+    pthread_mutex_unlock(&g_buf_lock);
+    return buf;
+}
+
+void lv_draw_buf_destroy(lv_draw_buf_t *buf)
+{
+    if (!buf) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_buf_lock);
+    g_buf_live--;
+    g_buf_bytes -= buf->data_size;
+    pthread_mutex_unlock(&g_buf_lock);
+
+    free(buf->unaligned_data);
+    free(buf);
+}
+
+uint32_t host_draw_buf_live(void)
+{
+    pthread_mutex_lock(&g_buf_lock);
+    uint32_t live = g_buf_live;
+    pthread_mutex_unlock(&g_buf_lock);
+    return live;
+}
+
+uint32_t host_draw_buf_bytes(void)
+{
+    pthread_mutex_lock(&g_buf_lock);
+    uint32_t bytes = g_buf_bytes;
+    pthread_mutex_unlock(&g_buf_lock);
+    return bytes;
+}
+
+typedef struct {
+    void (*callback)(void *);
+    void *user_data;
+} host_thread_arg_t;
+
+/* All syncs share one lock, host_threads_idle() looks at every thread */
+static pthread_mutex_t g_sync_lock = PTHREAD_MUTEX_INITIALIZER;
+static uint32_t g_threads_live;
+static uint32_t g_threads_blocked;
+
+static void *host_thread_entry(void *param)
+{
+    host_thread_arg_t arg = *(host_thread_arg_t *)param;
+
+    free(param);
+    arg.callback(arg.user_data);
+
+    pthread_mutex_lock(&g_sync_lock);
+    g_threads_live--;
+    pthread_mutex_unlock(&g_sync_lock);
+    return NULL;
+}
+
+lv_result_t lv_thread_init(lv_thread_t *thread, const char *name, lv_thread_prio_t prio, void (*callback)(void *),
+                           size_t stack_size, void *user_data)
+{
+    host_thread_arg_t *arg = malloc(sizeof(*arg));
+
+    LV_UNUSED(name);
+    LV_UNUSED(prio);
+    LV_UNUSED(stack_size);
+    if (!arg) {
+        return LV_RESULT_INVALID;
+    }
+    arg->callback = callback;
+    arg->user_data = user_data;
+
+    pthread_mutex_lock(&g_sync_lock);
+    g_threads_live++;
+    pthread_mutex_unlock(&g_sync_lock);
+
+    // Drivers end their threads by returning, nothing joins them
+    if (pthread_create(thread, NULL, host_thread_entry, arg)) {
+        pthread_mutex_lock(&g_sync_lock);
+        g_threads_live--;
+        pthread_mutex_unlock(&g_sync_lock);
+        free(arg);
+        return LV_RESULT_INVALID;
+    }
+    pthread_detach(*thread);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_delete(lv_thread_t *thread)
+{
+    LV_UNUSED(thread);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_sync_init(lv_thread_sync_t *sync)
+{
+    pthread_cond_init(&sync->cond, NULL);
+    sync->v = false;
+    sync->blocked = 0;
+    sync->gen = 0;
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_sync_wait(lv_thread_sync_t *sync)
+{
+    pthread_mutex_lock(&g_sync_lock);
+    while (!sync->v) {
+        uint32_t gen = sync->gen;
+
+        sync->blocked++;
+        g_threads_blocked++;
+        pthread_cond_wait(&sync->cond, &g_sync_lock);
+        if (sync->gen == gen) {
+            // spurious wake up, a signal would have counted it as running already
+            sync->blocked--;
+            g_threads_blocked--;
+        }
+    }
+    sync->v = false;
+    pthread_mutex_unlock(&g_sync_lock);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_sync_signal(lv_thread_sync_t *sync)
+{
+    pthread_mutex_lock(&g_sync_lock);
+    sync->v = true;
+    sync->gen++;
+    g_threads_blocked -= sync->blocked;
+    sync->blocked = 0;
+    pthread_cond_broadcast(&sync->cond);
+    pthread_mutex_unlock(&g_sync_lock);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_sync_delete(lv_thread_sync_t *sync)
+{
+    pthread_cond_destroy(&sync->cond);
+    return LV_RESULT_OK;
+}
+
+bool host_threads_idle(void)
+{
+    pthread_mutex_lock(&g_sync_lock);
+    bool idle = g_threads_blocked == g_threads_live;
+    pthread_mutex_unlock(&g_sync_lock);
+    return idle;
+}
+
+#define HOST_TIMER_MAX      8
+
+struct host_timer {
+    lv_timer_cb_t cb;
+    void *user_data;
+    uint32_t period;
+    bool paused;
+    bool used;
+};
+
+static struct host_timer g_timers[HOST_TIMER_MAX];
+
+lv_timer_t *lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void *user_data)
+{
+    for (int i = 0; i < HOST_TIMER_MAX; i++) {
+        if (!g_timers[i].used) {
+            g_timers[i].cb = timer_xcb;
+            g_timers[i].user_data = user_data;
+            g_timers[i].period = period;
+            g_timers[i].paused = false;
+            g_timers[i].used = true;
+            return &g_timers[i];
+        }
+    }
+    return NULL;
+}
+
+void lv_timer_delete(lv_timer_t *timer)
+{
+    memset(timer, 0, sizeof(*timer));
+}
+
+void lv_timer_pause(lv_timer_t *timer)
+{
+    timer->paused = true;
+}
+
+void lv_timer_resume(lv_timer_t *timer)
+{
+    timer->paused = false;
+}
+
+void lv_timer_set_period(lv_timer_t *timer, uint32_t period)
+{
+    timer->period = period;
+}
+
+void *lv_timer_get_user_data(lv_timer_t *timer)
+{
+    return timer->user_data;
+}
+
+int host_timer_handler(void)
+{
+    int ran = 0;
+
+    for (int i = 0; i < HOST_TIMER_MAX; i++) {
+        if (g_timers[i].used && !g_timers[i].paused) {
+            g_timers[i].cb(&g_timers[i]);
+            ran++;
+        }
+    }
+    return ran;
+}
+
+lv_event_code_t lv_event_get_code(lv_event_t *e)
+{
+    return e->code;
+}
+
+void *lv_event_get_target(lv_event_t *e)
+{
+    return e->current_target;
+}
+
+void *lv_event_get_user_data(lv_event_t *e)
+{
+    return e->user_data;
+}
+
+void *lv_event_get_param(lv_event_t *e)
+{
+    return e->param;
+}
+
+uint32_t lv_event_register_id(void)
+{
+    static uint32_t last = _LV_EVENT_LAST;
+
+    return ++last;
+}
+
+#define HOST_EVENT_MAX      16
+
+typedef struct {
+    lv_event_cb_t cb;
+    lv_event_code_t filter;
+    void *user_data;
+} host_event_dsc_t;
+
+struct host_obj {
+    const void *src;
+    bool src_copied;
+    uint32_t invalidated;
+    host_event_dsc_t events[HOST_EVENT_MAX];
+    int event_cnt;
+    lv_display_t *disp;         // set for screens and their children
+    lv_area_t coords;
+    int32_t scroll_y;
+    lv_scrollbar_mode_t scrollbar_mode;
+};
+
+#define HOST_INV_MAX        32  // LV_INV_BUF_SIZE
+
+struct host_display {
+    int32_t hor_res;
+    int32_t ver_res;
+    lv_color_format_t cf;
+    lv_display_flush_cb_t flush_cb;
+    uint8_t *buf[2];
+    uint32_t buf_size;
+    lv_display_render_mode_t render_mode;
+    lv_draw_buf_t *buf3;
+    volatile bool flushing;
+    lv_obj_t *screen;
+    lv_area_t inv_areas[HOST_INV_MAX];
+    int inv_cnt;
+    host_render_cb_t render_cb;
+    void *render_data;
+    host_event_dsc_t events[HOST_EVENT_MAX];
+    int event_cnt;
+};
+
+/* Calls cb of every descriptor matching code, descriptors removed meanwhile are skipped */
+static void host_events_send(host_event_dsc_t *events, int *cnt, void *target, lv_event_code_t code, void *param)
+{
+    host_event_dsc_t copy[HOST_EVENT_MAX];
+    int n = *cnt;
+
+    memcpy(copy, events, sizeof(copy));
+    for (int i = 0; i < n; i++) {
+        bool present = false;
+        for (int j = 0; j < *cnt; j++) {
+            if (events[j].cb == copy[i].cb && events[j].user_data == copy[i].user_data &&
+                events[j].filter == copy[i].filter) {
+                present = true;
+                break;
+            }
+        }
+        if (present && (copy[i].filter == code || copy[i].filter == LV_EVENT_ALL)) {
+            lv_event_t e = { code, target, copy[i].user_data, param };
+            copy[i].cb(&e);
+        }
+    }
+}
+
+static void host_events_add(host_event_dsc_t *events, int *cnt, lv_event_cb_t cb, lv_event_code_t filter,
+                            void *user_data)
+{
+    if (*cnt < HOST_EVENT_MAX) {
+        events[*cnt].cb = cb;
+        events[*cnt].filter = filter;
+        events[*cnt].user_data = user_data;
+        (*cnt)++;
+    }
+}
+
+/* Removes the descriptors of cb, only those with user_data unless any_data is set */
+static uint32_t host_events_remove(host_event_dsc_t *events, int *cnt, lv_event_cb_t cb, void *user_data,
+                                   bool any_data)
+{
+    uint32_t removed = 0;
+
+    for (int i = 0; i < *cnt;) {
+        if (events[i].cb == cb && (any_data || events[i].user_data == user_data)) {
+            memmove(&events[i], &events[i + 1], (*cnt - i - 1) * sizeof(events[0]));
+            (*cnt)--;
+            removed++;
+        } else {
+            i++;
+        }
+    }
+    return removed;
+}
+
+static void host_obj_free_src(lv_obj_t *obj)
+{
+    if (obj->src_copied) {
+        free((void *)obj->src);
+    }
+    obj->src = NULL;
+    obj->src_copied = false;
+}
+
+lv_obj_t *lv_obj_create(lv_obj_t *parent)
+{
+    lv_obj_t *obj = calloc(1, sizeof(lv_obj_t));
+
+    if (obj && parent) {
+        obj->disp = parent->disp;
+    }
+    return obj;
+}
+
+lv_obj_t *lv_image_create(lv_obj_t *parent)
+{
+    return lv_obj_create(parent);
+}
+
+void lv_obj_delete(lv_obj_t *obj)
+{
+    // LVGL invalidates the area first, then sends LV_EVENT_DELETE
+    if (obj->disp) {
+        lv_inv_area(obj->disp, &obj->coords);
+    }
+    host_events_send(obj->events, &obj->event_cnt, obj, LV_EVENT_DELETE, NULL);
+    host_obj_free_src(obj);
+    free(obj);
+}
+
+void lv_obj_invalidate(const lv_obj_t *obj)
+{
+    ((lv_obj_t *)obj)->invalidated++;
+    if (obj->disp) {
+        lv_inv_area(obj->disp, &obj->coords);
+    }
+}
+
+void lv_obj_get_coords(const lv_obj_t *obj, lv_area_t *coords)
+{
+    *coords = obj->coords;
+}
+
+void lv_obj_update_layout(const lv_obj_t *obj)
+{
+    LV_UNUSED(obj);
+}
+
+int32_t lv_obj_get_scroll_y(const lv_obj_t *obj)
+{
+    return obj->scroll_y;
+}
+
+void lv_obj_set_scrollbar_mode(lv_obj_t *obj, lv_scrollbar_mode_t mode)
+{
+    obj->scrollbar_mode = mode;
+}
+
+void host_obj_set_coords(lv_obj_t *obj, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    lv_area_t coords = { x1, y1, x2, y2 };
+
+    obj->coords = coords;
+}
+
+void host_obj_scroll_to_y(lv_obj_t *obj, int32_t y)
+{
+    obj->scroll_y = y;
+    lv_obj_send_event(obj, LV_EVENT_SCROLL, NULL);
+    lv_obj_invalidate(obj);
+}
+
+lv_result_t lv_obj_send_event(lv_obj_t *obj, lv_event_code_t event_code, void *param)
+{
+    host_events_send(obj->events, &obj->event_cnt, obj, event_code, param);
+    return LV_RESULT_OK;
+}
+
+void lv_obj_add_event_cb(lv_obj_t *obj, lv_event_cb_t event_cb, lv_event_code_t filter, void *user_data)
+{
+    host_events_add(obj->events, &obj->event_cnt, event_cb, filter, user_data);
+}
+
+bool lv_obj_remove_event_cb(lv_obj_t *obj, lv_event_cb_t event_cb)
+{
+    return host_events_remove(obj->events, &obj->event_cnt, event_cb, NULL, true) > 0;
+}
+
+uint32_t lv_obj_remove_event_cb_with_user_data(lv_obj_t *obj, lv_event_cb_t event_cb, void *user_data)
+{
+    return host_events_remove(obj->events, &obj->event_cnt, event_cb, user_data, false);
+}
+
+void lv_image_set_src(lv_obj_t *obj, const void *src)
+{
+    lv_image_src_t src_type = lv_image_src_get_type(src);
+
+    // lv_image keeps its own copy of string sources
+    host_obj_free_src(obj);
+    if (src_type == LV_IMAGE_SRC_FILE || src_type == LV_IMAGE_SRC_SYMBOL) {
+        obj->src = strdup(src);
+        obj->src_copied = true;
+    } else {
+        obj->src = src;
+    }
+    obj->invalidated++;
+}
+
+const void *lv_image_get_src(lv_obj_t *obj)
+{
+    return obj->src;
+}
+
+uint32_t host_obj_invalidated(const lv_obj_t *obj)
+{
+    return obj->invalidated;
+}
+
+lv_display_t *lv_display_create(int32_t hor_res, int32_t ver_res)
+{
+    lv_display_t *disp = calloc(1, sizeof(lv_display_t));
+
+    if (!disp) {
+        return NULL;
+    }
+    disp->hor_res = hor_res;
+    disp->ver_res = ver_res;
+    disp->cf = LV_COLOR_DEPTH == 16 ? LV_COLOR_FORMAT_RGB565 :
+               (LV_COLOR_DEPTH == 24 ? LV_COLOR_FORMAT_RGB888 : LV_COLOR_FORMAT_ARGB8888);
+    disp->screen = lv_obj_create(NULL);
+    disp->screen->disp = disp;
+    host_obj_set_coords(disp->screen, 0, 0, hor_res - 1, ver_res - 1);
+    return disp;
+}
+
+void lv_display_set_color_format(lv_display_t *disp, lv_color_format_t color_format)
+{
+    disp->cf = color_format;
+}
+
+void lv_display_set_flush_cb(lv_display_t *disp, lv_display_flush_cb_t flush_cb)
+{
+    disp->flush_cb = flush_cb;
+}
+
+void lv_display_set_buffers(lv_display_t *disp, void *buf1, void *buf2, uint32_t buf_size,
+                            lv_display_render_mode_t render_mode)
+{
+    disp->buf[0] = buf1;
+    disp->buf[1] = buf2;
+    disp->buf_size = buf_size;
+    disp->render_mode = render_mode;
+}
+
+void lv_display_set_3rd_draw_buffer(lv_display_t *disp, lv_draw_buf_t *buf3)
+{
+    disp->buf3 = buf3;
+}
+
+void lv_display_flush_ready(lv_display_t *disp)
+{
+    disp->flushing = false;
+}
+
+lv_display_rotation_t lv_display_get_rotation(lv_display_t *disp)
+{
+    LV_UNUSED(disp);
+    return LV_DISPLAY_ROTATION_0;
+}
+
+lv_obj_t *lv_display_get_screen_active(lv_display_t *disp)
+{
+    return disp->screen;
+}
+
+void lv_display_add_event_cb(lv_display_t *disp, lv_event_cb_t event_cb, lv_event_code_t filter, void *user_data)
+{
+    host_events_add(disp->events, &disp->event_cnt, event_cb, filter, user_data);
+}
+
+uint32_t lv_display_remove_event_cb_with_user_data(lv_display_t *disp, lv_event_cb_t event_cb, void *user_data)
+{
+    return host_events_remove(disp->events, &disp->event_cnt, event_cb, user_data, false);
+}
+
+static bool host_area_is_in(const lv_area_t *in, const lv_area_t *holder)
+{
+    return in->x1 >= holder->x1 && in->y1 >= holder->y1 && in->x2 <= holder->x2 && in->y2 <= holder->y2;
+}
+
+void lv_inv_area(lv_display_t *disp, const lv_area_t *area_p)
+{
+    lv_area_t scr_area = { 0, 0, disp->hor_res - 1, disp->ver_res - 1 };
+    lv_area_t com_area;
+
+    if (!lv_area_intersect(&com_area, area_p, &scr_area)) {
+        return;
+    }
+    host_events_send(disp->events, &disp->event_cnt, disp, LV_EVENT_INVALIDATE_AREA, &com_area);
+
+    if (disp->render_mode == LV_DISPLAY_RENDER_MODE_FULL) {
+        disp->inv_areas[0] = scr_area;
+        disp->inv_cnt = 1;
+        return;
+    }
+    for (int i = 0; i < disp->inv_cnt; i++) {
+        if (host_area_is_in(&com_area, &disp->inv_areas[i])) {
+            return;
+        }
+    }
+    if (disp->inv_cnt < HOST_INV_MAX) {
+        disp->inv_areas[disp->inv_cnt++] = com_area;
+    } else {
+        disp->inv_areas[0] = scr_area;
+        disp->inv_cnt = 1;
+    }
+}
+
+void host_display_set_render_cb(lv_display_t *disp, host_render_cb_t cb, void *user_data)
+{
+    disp->render_cb = cb;
+    disp->render_data = user_data;
+}
+
+int host_display_refresh(lv_display_t *disp)
+{
+    uint32_t px_size = lv_color_format_get_size(disp->cf);
+    lv_area_t areas[HOST_INV_MAX];
+    int cnt;
+    int flushes = 0;
+    int buf_id = 0;
+
+    host_events_send(disp->events, &disp->event_cnt, disp, LV_EVENT_REFR_START, NULL);
+
+    // Areas invalidated from here on are for the next refresh
+    cnt = disp->inv_cnt;
+    memcpy(areas, disp->inv_areas, sizeof(areas));
+    disp->inv_cnt = 0;
+
+    for (int i = 0; i < cnt; i++) {
+        int32_t rows = lv_area_get_height(&areas[i]);
+
+        if (disp->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
+            rows = LV_MIN(rows, (int32_t)(disp->buf_size / (lv_area_get_width(&areas[i]) * px_size)));
+        }
+        for (int32_t y = areas[i].y1; y <= areas[i].y2; y += rows) {
+            lv_area_t band = { areas[i].x1, y, areas[i].x2, LV_MIN(y + rows - 1, areas[i].y2) };
+            uint8_t *px_map = disp->buf[buf_id];
+
+            if (disp->render_cb) {
+                disp->render_cb(&band, px_map, disp->render_data);
+            } else {
+                memset(px_map, 0, lv_area_get_size(&band) * px_size);
+            }
+
+            // LVGL waits for lv_display_flush_ready() before it renders into the buffer again
+            disp->flushing = true;
+            disp->flush_cb(disp, &band, px_map);
+            while (disp->flushing) {
+                sched_yield();
+            }
+            flushes++;
+            if (disp->buf[1]) {
+                buf_id ^= 1;
+            }
+        }
+    }
+
+    host_events_send(disp->events, &disp->event_cnt, disp, LV_EVENT_REFR_READY, NULL);
+    return flushes;
+}
+
+bool lv_image_cache_is_enabled(void)
+{
+    return false;
+}
+
+void lv_image_cache_drop(const void *src)
+{
+    LV_UNUSED(src);
+}
+
+lv_fs_res_t lv_fs_open(lv_fs_file_t *file_p, const char *path, lv_fs_mode_t mode)
+{
+    file_p->file_d = fopen(path, mode == LV_FS_MODE_WR ? "wb" : (mode == LV_FS_MODE_RD ? "rb" : "r+b"));
+    return file_p->file_d ? LV_FS_RES_OK : LV_FS_RES_NOT_EX;
+}
+
+lv_fs_res_t lv_fs_close(lv_fs_file_t *file_p)
+{
+    fclose(file_p->file_d);
+    file_p->file_d = NULL;
+    return LV_FS_RES_OK;
+}
+
+lv_fs_res_t lv_fs_read(lv_fs_file_t *file_p, void *buf, uint32_t btr, uint32_t *br)
+{
+    *br = fread(buf, 1, btr, file_p->file_d);
+    return ferror(file_p->file_d) ? LV_FS_RES_FS_ERR : LV_FS_RES_OK;
+}
+
+lv_fs_res_t lv_fs_seek(lv_fs_file_t *file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+    static const int whences[] = { SEEK_SET, SEEK_CUR, SEEK_END };
+
+    return fseek(file_p->file_d, pos, whences[whence]) ? LV_FS_RES_FS_ERR : LV_FS_RES_OK;
+}
+
+lv_fs_res_t lv_fs_tell(lv_fs_file_t *file_p, uint32_t *pos)
+{
+    long p = ftell(file_p->file_d);
+
+    *pos = p < 0 ? 0 : (uint32_t)p;
+    return p < 0 ? LV_FS_RES_FS_ERR : LV_FS_RES_OK;
+}
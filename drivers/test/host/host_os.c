@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "ameba_soc.h"
+#include "os_wrapper.h"
+#include "host.h"
+
+struct host_sema {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t count;
+    uint32_t max;
+};
+
+int rtos_sema_create(rtos_sema_t *sema, uint32_t init_count, uint32_t max_count)
+{
+    struct host_sema *s = calloc(1, sizeof(*s));
+
+    if (!s) {
+        return FAIL;
+    }
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->cond, NULL);
+    s->count = init_count;
+    s->max = max_count;
+    *sema = s;
+    return SUCCESS;
+}
+
+int rtos_sema_delete(rtos_sema_t sema)
+{
+    pthread_cond_destroy(&sema->cond);
+    pthread_mutex_destroy(&sema->lock);
+    free(sema);
+    return SUCCESS;
+}
+
+int rtos_sema_take(rtos_sema_t sema, uint32_t timeout_ms)
+{
+    struct timespec until;
+    int ret = SUCCESS;
+
+    clock_gettime(CLOCK_REALTIME, &until);
+    until.tv_sec += timeout_ms / 1000;
+    until.tv_nsec += (long)(timeout_ms % 1000) * 1000000;
+    if (until.tv_nsec >= 1000000000) {
+        until.tv_sec++;
+        until.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock(&sema->lock);
+    while (!sema->count) {
+        if (timeout_ms == 0) {
+            ret = FAIL;
+            break;
+        }
+        if (timeout_ms == RTOS_MAX_TIMEOUT) {
+            pthread_cond_wait(&sema->cond, &sema->lock);
+        } else if (pthread_cond_timedwait(&sema->cond, &sema->lock, &until) == ETIMEDOUT) {
+            ret = FAIL;
+            break;
+        }
+    }
+    if (ret == SUCCESS) {
+        sema->count--;
+    }
+    pthread_mutex_unlock(&sema->lock);
+    return ret;
+}
+
+int rtos_sema_give(rtos_sema_t sema)
+{
+    pthread_mutex_lock(&sema->lock);
+    if (sema->count < sema->max) {
+        sema->count++;
+    }
+    pthread_cond_signal(&sema->cond);
+    pthread_mutex_unlock(&sema->lock);
+    return SUCCESS;
+}
+
+static volatile bool g_time_manual;
+static volatile uint64_t g_time_ns;
+
+void host_time_manual(bool manual)
+{
+    g_time_ns = rtos_time_get_current_system_time_ns();
+    g_time_manual = manual;
+}
+
+void host_time_advance_ms(uint32_t ms)
+{
+    __atomic_add_fetch(&g_time_ns, (uint64_t)ms * 1000000, __ATOMIC_SEQ_CST);
+}
+
+uint64_t rtos_time_get_current_system_time_ns(void)
+{
+    struct timespec now;
+
+    if (g_time_manual) {
+        return __atomic_load_n(&g_time_ns, __ATOMIC_SEQ_CST);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+uint32_t rtos_time_get_current_system_time_ms(void)
+{
+    return (uint32_t)(rtos_time_get_current_system_time_ns() / 1000000);
+}
+
+void rtos_time_delay_ms(uint32_t ms)
+{
+    struct timespec delay = { ms / 1000, (long)(ms % 1000) * 1000000 };
+
+    nanosleep(&delay, NULL);
+}
+
+static uint32_t g_heap_total = 64 * 1024 * 1024;
+
+void host_heap_set_total(uint32_t total)
+{
+    g_heap_total = total;
+}
+
+uint32_t rtos_mem_get_free_heap_size(void)
+{
+    uint32_t used = host_draw_buf_bytes();
+
+    return g_heap_total > used ? g_heap_total - used : 0;
+}
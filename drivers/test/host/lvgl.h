@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Host stand-in for the parts of LVGL the drivers under test use. Same names and
+ * semantics, reduced to what these drivers touch, backed by libc and pthreads.
+ */
+
+#ifndef HOST_LVGL_H
+#define HOST_LVGL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+
+#define LV_USE_LIBJPEG_TURBO        1
+#ifndef LV_COLOR_DEPTH
+#define LV_COLOR_DEPTH              16
+#endif
+
+#define LV_UNUSED(x)                ((void)x)
+#define LV_MIN(a, b)                ((a) < (b) ? (a) : (b))
+#define LV_MAX(a, b)                ((a) > (b) ? (a) : (b))
+#define LV_ABS(x)                   ((x) > 0 ? (x) : (-(x)))
+#define LV_CLAMP(min, val, max)     (LV_MAX(min, (LV_MIN(val, max))))
+#define LV_SCALE_NONE               256
+#define LV_IMAGE_HEADER_MAGIC       0x19
+
+#define LV_LOG_WARN(...)            do { } while (0)
+
+typedef enum {
+    LV_RESULT_INVALID = 0,
+    LV_RESULT_OK,
+} lv_result_t;
+
+typedef enum {
+    LV_COLOR_FORMAT_UNKNOWN     = 0x00,
+    LV_COLOR_FORMAT_L8          = 0x06,
+    LV_COLOR_FORMAT_RGB888      = 0x0F,
+    LV_COLOR_FORMAT_ARGB8888    = 0x10,
+    LV_COLOR_FORMAT_XRGB8888    = 0x11,
+    LV_COLOR_FORMAT_RGB565      = 0x12,
+    LV_COLOR_FORMAT_NV12        = 0x2A,
+} lv_color_format_t;
+
+typedef struct {
+    int32_t x1;
+    int32_t y1;
+    int32_t x2;
+    int32_t y2;
+} lv_area_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t cf;
+    uint32_t flags;
+    uint32_t w;
+    uint32_t h;
+    uint32_t stride;
+} lv_image_header_t;
+
+typedef struct {
+    lv_image_header_t header;
+    uint32_t data_size;
+    const uint8_t *data;
+    const void *reserved;
+} lv_image_dsc_t;
+
+typedef struct {
+    lv_image_header_t header;
+    uint32_t data_size;
+    uint8_t *data;
+    void *unaligned_data;
+} lv_draw_buf_t;
+
+typedef struct host_obj lv_obj_t;
+typedef struct host_display lv_display_t;
+
+/* Events */
+typedef enum {
+    LV_EVENT_ALL = 0,
+    LV_EVENT_SCROLL,
+    LV_EVENT_DRAW_MAIN_END,
+    LV_EVENT_READY,
+    LV_EVENT_DELETE,
+    LV_EVENT_INVALIDATE_AREA,
+    LV_EVENT_REFR_START,
+    LV_EVENT_REFR_READY,
+    _LV_EVENT_LAST,
+} lv_event_code_t;
+
+typedef struct {
+    lv_event_code_t code;
+    void *current_target;
+    void *user_data;
+    void *param;
+} lv_event_t;
+
+typedef void (*lv_event_cb_t)(lv_event_t *e);
+
+lv_event_code_t lv_event_get_code(lv_event_t *e);
+void *lv_event_get_target(lv_event_t *e);
+void *lv_event_get_user_data(lv_event_t *e);
+void *lv_event_get_param(lv_event_t *e);
+uint32_t lv_event_register_id(void);
+
+/* Objects, plain rectangles with an event list. Children of a screen invalidate areas
+ * of its display. */
+typedef enum {
+    LV_SCROLLBAR_MODE_OFF,
+    LV_SCROLLBAR_MODE_ON,
+    LV_SCROLLBAR_MODE_ACTIVE,
+    LV_SCROLLBAR_MODE_AUTO,
+} lv_scrollbar_mode_t;
+
+lv_obj_t *lv_obj_create(lv_obj_t *parent);
+lv_obj_t *lv_image_create(lv_obj_t *parent);
+void lv_obj_get_coords(const lv_obj_t *obj, lv_area_t *coords);
+void lv_obj_update_layout(const lv_obj_t *obj);
+int32_t lv_obj_get_scroll_y(const lv_obj_t *obj);
+void lv_obj_set_scrollbar_mode(lv_obj_t *obj, lv_scrollbar_mode_t mode);
+void lv_obj_delete(lv_obj_t *obj);
+void lv_obj_invalidate(const lv_obj_t *obj);
+lv_result_t lv_obj_send_event(lv_obj_t *obj, lv_event_code_t event_code, void *param);
+void lv_obj_add_event_cb(lv_obj_t *obj, lv_event_cb_t event_cb, lv_event_code_t filter, void *user_data);
+bool lv_obj_remove_event_cb(lv_obj_t *obj, lv_event_cb_t event_cb);
+uint32_t lv_obj_remove_event_cb_with_user_data(lv_obj_t *obj, lv_event_cb_t event_cb, void *user_data);
+void lv_image_set_src(lv_obj_t *obj, const void *src);
+const void *lv_image_get_src(lv_obj_t *obj);
+
+typedef enum {
+    LV_IMAGE_SRC_VARIABLE,
+    LV_IMAGE_SRC_FILE,
+    LV_IMAGE_SRC_SYMBOL,
+    LV_IMAGE_SRC_UNKNOWN,
+} lv_image_src_t;
+
+/* Memory and strings */
+void *lv_malloc(size_t size);
+void *lv_malloc_zeroed(size_t size);
+void *lv_realloc(void *data, size_t size);
+void lv_free(void *data);
+char *lv_strdup(const char *src);
+int lv_strcmp(const char *s1, const char *s2);
+#define lv_memzero(dst, len)        memset(dst, 0, len)
+#define lv_memcpy(dst, src, len)    memcpy(dst, src, len)
+
+/* OS abstraction */
+typedef pthread_mutex_t lv_mutex_t;
+typedef pthread_t lv_thread_t;
+
+typedef struct {
+    pthread_cond_t cond;
+    bool v;
+    uint32_t blocked;           // waiters not signalled yet
+    uint32_t gen;               // signals delivered to waiters
+} lv_thread_sync_t;
+
+typedef enum {
+    LV_THREAD_PRIO_LOWEST,
+    LV_THREAD_PRIO_LOW,
+    LV_THREAD_PRIO_MID,
+    LV_THREAD_PRIO_HIGH,
+    LV_THREAD_PRIO_HIGHEST,
+} lv_thread_prio_t;
+
+lv_result_t lv_mutex_init(lv_mutex_t *mutex);
+lv_result_t lv_mutex_lock(lv_mutex_t *mutex);
+lv_result_t lv_mutex_unlock(lv_mutex_t *mutex);
+lv_result_t lv_mutex_delete(lv_mutex_t *mutex);
+lv_result_t lv_thread_init(lv_thread_t *thread, const char *name, lv_thread_prio_t prio, void (*callback)(void *),
+                           size_t stack_size, void *user_data);
+lv_result_t lv_thread_delete(lv_thread_t *thread);
+lv_result_t lv_thread_sync_init(lv_thread_sync_t *sync);
+lv_result_t lv_thread_sync_wait(lv_thread_sync_t *sync);
+lv_result_t lv_thread_sync_signal(lv_thread_sync_t *sync);
+lv_result_t lv_thread_sync_delete(lv_thread_sync_t *sync);
+
+/* Displays, refreshed by host_display_refresh() */
+typedef enum {
+    LV_DISPLAY_RENDER_MODE_PARTIAL,
+    LV_DISPLAY_RENDER_MODE_DIRECT,
+    LV_DISPLAY_RENDER_MODE_FULL,
+} lv_display_render_mode_t;
+
+typedef enum {
+    LV_DISPLAY_ROTATION_0 = 0,
+    LV_DISPLAY_ROTATION_90,
+    LV_DISPLAY_ROTATION_180,
+    LV_DISPLAY_ROTATION_270,
+} lv_display_rotation_t;
+
+typedef void (*lv_display_flush_cb_t)(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map);
+
+lv_display_t *lv_display_create(int32_t hor_res, int32_t ver_res);
+void lv_display_set_color_format(lv_display_t *disp, lv_color_format_t color_format);
+void lv_display_set_flush_cb(lv_display_t *disp, lv_display_flush_cb_t flush_cb);
+void lv_display_set_buffers(lv_display_t *disp, void *buf1, void *buf2, uint32_t buf_size,
+                            lv_display_render_mode_t render_mode);
+void lv_display_set_3rd_draw_buffer(lv_display_t *disp, lv_draw_buf_t *buf3);
+void lv_display_flush_ready(lv_display_t *disp);
+lv_display_rotation_t lv_display_get_rotation(lv_display_t *disp);
+lv_obj_t *lv_display_get_screen_active(lv_display_t *disp);
+void lv_display_add_event_cb(lv_display_t *disp, lv_event_cb_t event_cb, lv_event_code_t filter, void *user_data);
+uint32_t lv_display_remove_event_cb_with_user_data(lv_display_t *disp, lv_event_cb_t event_cb, void *user_data);
+void lv_inv_area(lv_display_t *disp, const lv_area_t *area_p);
+
+/* Timers, run by host_timer_handler() */
+typedef struct host_timer lv_timer_t;
+typedef void (*lv_timer_cb_t)(lv_timer_t *timer);
+
+lv_timer_t *lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void *user_data);
+void lv_timer_delete(lv_timer_t *timer);
+void lv_timer_pause(lv_timer_t *timer);
+void lv_timer_resume(lv_timer_t *timer);
+void lv_timer_set_period(lv_timer_t *timer, uint32_t period);
+void *lv_timer_get_user_data(lv_timer_t *timer);
+
+/* Areas */
+static inline int32_t lv_area_get_width(const lv_area_t *area)
+{
+    return area->x2 - area->x1 + 1;
+}
+
+static inline int32_t lv_area_get_height(const lv_area_t *area)
+{
+    return area->y2 - area->y1 + 1;
+}
+
+static inline uint32_t lv_area_get_size(const lv_area_t *area)
+{
+    return (uint32_t)lv_area_get_width(area) * lv_area_get_height(area);
+}
+
+bool lv_area_intersect(lv_area_t *res, const lv_area_t *a1, const lv_area_t *a2);
+
+/* Images and draw buffers */
+lv_image_src_t lv_image_src_get_type(const void *src);
+uint8_t lv_color_format_get_size(lv_color_format_t cf);
+uint32_t lv_draw_buf_width_to_stride(uint32_t w, lv_color_format_t cf);
+lv_draw_buf_t *lv_draw_buf_create(uint32_t w, uint32_t h, lv_color_format_t cf, uint32_t stride);
+void lv_draw_buf_destroy(lv_draw_buf_t *buf);
+lv_result_t lv_draw_buf_init(lv_draw_buf_t *buf, uint32_t w, uint32_t h, lv_color_format_t cf, uint32_t stride,
+                             void *data, uint32_t data_size);
+#define lv_draw_buf_flush_cache(buf, area)  do { LV_UNUSED(buf); LV_UNUSED(area); } while (0)
+
+/* File system, plain stdio paths without drive letters */
+typedef enum {
+    LV_FS_RES_OK = 0,
+    LV_FS_RES_HW_ERR,
+    LV_FS_RES_FS_ERR,
+    LV_FS_RES_NOT_EX,
+    LV_FS_RES_UNKNOWN,
+} lv_fs_res_t;
+
+typedef enum {
+    LV_FS_MODE_WR = 0x01,
+    LV_FS_MODE_RD = 0x02,
+} lv_fs_mode_t;
+
+typedef enum {
+    LV_FS_SEEK_SET = 0x00,
+    LV_FS_SEEK_CUR = 0x01,
+    LV_FS_SEEK_END = 0x02,
+} lv_fs_whence_t;
+
+typedef struct {
+    void *file_d;
+} lv_fs_file_t;
+
+lv_fs_res_t lv_fs_open(lv_fs_file_t *file_p, const char *path, lv_fs_mode_t mode);
+lv_fs_res_t lv_fs_close(lv_fs_file_t *file_p);
+lv_fs_res_t lv_fs_read(lv_fs_file_t *file_p, void *buf, uint32_t btr, uint32_t *br);
+lv_fs_res_t lv_fs_seek(lv_fs_file_t *file_p, uint32_t pos, lv_fs_whence_t whence);
+lv_fs_res_t lv_fs_tell(lv_fs_file_t *file_p, uint32_t *pos);
+
+/* LVGL image cache, off as in the amebagreen2 lv_conf.h */
+bool lv_image_cache_is_enabled(void);
+void lv_image_cache_drop(const void *src);
+
+#endif
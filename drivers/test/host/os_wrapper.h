@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Host stand-in for the RTOS wrapper: semaphores, time, delays and heap size */
+
+#ifndef HOST_OS_WRAPPER_H
+#define HOST_OS_WRAPPER_H
+
+#include <stdint.h>
+
+#define RTOS_MAX_TIMEOUT        0xFFFFFFFFUL
+#define RTOS_SEMA_MAX_COUNT     0xFFFFFFFFUL
+
+typedef struct host_sema *rtos_sema_t;
+
+int rtos_sema_create(rtos_sema_t *sema, uint32_t init_count, uint32_t max_count);
+int rtos_sema_delete(rtos_sema_t sema);
+int rtos_sema_take(rtos_sema_t sema, uint32_t timeout_ms);
+int rtos_sema_give(rtos_sema_t sema);
+
+uint32_t rtos_time_get_current_system_time_ms(void);
+uint64_t rtos_time_get_current_system_time_ns(void);
+void rtos_time_delay_ms(uint32_t ms);
+
+uint32_t rtos_mem_get_free_heap_size(void);
+
+#endif
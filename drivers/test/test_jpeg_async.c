@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Async JPEG loading with the real worker thread and libjpeg-turbo: placeholders, hand
+ * over through the cache, release of the cache reference, cancellation, deletion and
+ * deinit with work outstanding */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "os_wrapper.h"
+#include "jpeg_cache.h"
+#include "jpeg_decoder.h"
+#include "jpeg_decoder_private.h"
+#include "host.h"
+
+#define HOLD_TICKS      10      // JPEG_ASYNC_HOLD_TICKS
+#define WAIT_TICKS      2000    // timer runs before a test gives up, 1 ms apart
+
+static int g_failed;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            g_failed++; \
+        } \
+    } while (0)
+
+static const char g_placeholder[] = "\xEF\x80\x80";    // a symbol
+static lv_image_dsc_t g_dsc[3];
+
+/* lv_image keeps a copy of symbol sources */
+static bool shows_placeholder(lv_obj_t *img)
+{
+    const char *src = lv_image_get_src(img);
+
+    return src && lv_image_src_get_type(src) == LV_IMAGE_SRC_SYMBOL && strcmp(src, g_placeholder) == 0;
+}
+
+/* Run the timers until the async timer pauses, returns the number of runs */
+static int run_until_idle(void)
+{
+    int runs = 0;
+
+    while (runs < WAIT_TICKS && host_timer_handler() > 0) {
+        runs++;
+        rtos_time_delay_ms(1);
+    }
+    return runs;
+}
+
+/* Run the timers until img shows src */
+static bool run_until_src(lv_obj_t *img, const void *src)
+{
+    for (int i = 0; i < WAIT_TICKS; i++) {
+        if (lv_image_get_src(img) == src) {
+            return true;
+        }
+        host_timer_handler();
+        rtos_time_delay_ms(1);
+    }
+    return lv_image_get_src(img) == src;
+}
+
+static void wait_decodes(uint32_t count)
+{
+    for (int i = 0; i < WAIT_TICKS && host_jpeg_decode_count() < count; i++) {
+        rtos_time_delay_ms(1);
+    }
+}
+
+/* Draw buffers still referenced by someone once the cache forgot every entry */
+static uint32_t pinned(void)
+{
+    jpeg_cache_drop(NULL);
+    return host_draw_buf_live();
+}
+
+static void test_apply_on_draw(void)
+{
+    lv_obj_t *img = lv_image_create(NULL);
+    uint32_t decodes = host_jpeg_decode_count();
+
+    lv_ameba_jpeg_image_set_src_async(img, &g_dsc[0]);
+    CHECK(shows_placeholder(img));
+    CHECK(run_until_src(img, &g_dsc[0]));
+    CHECK(host_jpeg_decode_count() == decodes + 1);
+    CHECK(host_obj_invalidated(img) == 2);
+
+    // cached, a second image is set right away
+    lv_obj_t *img2 = lv_image_create(NULL);
+    lv_ameba_jpeg_image_set_src_async(img2, &g_dsc[0]);
+    CHECK(lv_image_get_src(img2) == &g_dsc[0]);
+    CHECK(host_jpeg_decode_count() == decodes + 1);
+
+    // held for the first draw, given up by the next timer run after it
+    CHECK(pinned() == 1);
+    lv_obj_send_event(img, LV_EVENT_DRAW_MAIN_END, NULL);
+    CHECK(host_timer_handler() == 1);
+    CHECK(host_draw_buf_live() == 0);
+    CHECK(host_timer_handler() == 0);
+
+    lv_obj_delete(img);
+    lv_obj_delete(img2);
+}
+
+static void test_hidden_released(void)
+{
+    lv_obj_t *img = lv_image_create(NULL);
+
+    lv_ameba_jpeg_image_set_src_async(img, &g_dsc[1]);
+    CHECK(run_until_src(img, &g_dsc[1]));
+
+    // never drawn, the reference goes after a bounded number of runs and the timer stops
+    CHECK(run_until_idle() <= HOLD_TICKS);
+    CHECK(pinned() == 0);
+
+    lv_obj_delete(img);
+}
+
+static void test_cancel(void)
+{
+    lv_obj_t *img1 = lv_image_create(NULL);
+    lv_obj_t *img2 = lv_image_create(NULL);
+    uint32_t decodes = host_jpeg_decode_count();
+
+    host_jpeg_hold(true);
+    lv_ameba_jpeg_image_set_src_async(img1, &g_dsc[0]);
+    lv_ameba_jpeg_image_set_src_async(img2, &g_dsc[1]);
+    wait_decodes(decodes + 1);
+
+    // img1 running, img2 pending
+    lv_ameba_jpeg_async_cancel(img1);
+    lv_ameba_jpeg_async_cancel(img2);
+    host_jpeg_hold(false);
+    run_until_idle();
+
+    CHECK(host_jpeg_decode_count() == decodes + 1);
+    CHECK(shows_placeholder(img1));
+    CHECK(shows_placeholder(img2));
+    CHECK(pinned() == 0);
+
+    lv_obj_delete(img1);
+    lv_obj_delete(img2);
+}
+
+static void test_delete(void)
+{
+    lv_obj_t *img1 = lv_image_create(NULL);
+    lv_obj_t *img2 = lv_image_create(NULL);
+    uint32_t decodes = host_jpeg_decode_count();
+
+    host_jpeg_hold(true);
+    lv_ameba_jpeg_image_set_src_async(img1, &g_dsc[0]);
+    lv_ameba_jpeg_image_set_src_async(img2, &g_dsc[1]);
+    wait_decodes(decodes + 1);
+    lv_obj_delete(img1);
+    lv_obj_delete(img2);
+    host_jpeg_hold(false);
+    run_until_idle();
+
+    CHECK(host_jpeg_decode_count() == decodes + 1);
+    CHECK(pinned() == 0);
+
+    // deleted while applied and not drawn yet
+    lv_obj_t *img = lv_image_create(NULL);
+    lv_ameba_jpeg_image_set_src_async(img, &g_dsc[2]);
+    CHECK(run_until_src(img, &g_dsc[2]));
+    lv_obj_delete(img);
+    CHECK(pinned() == 0);
+    CHECK(host_timer_handler() == 1);
+    CHECK(host_timer_handler() == 0);
+}
+
+static void test_app_src_wins(void)
+{
+    lv_obj_t *img = lv_image_create(NULL);
+
+    host_jpeg_hold(true);
+    lv_ameba_jpeg_image_set_src_async(img, &g_dsc[0]);
+    lv_image_set_src(img, "A:other.png");
+    host_jpeg_hold(false);
+    run_until_idle();
+
+    CHECK(strcmp(lv_image_get_src(img), "A:other.png") == 0);
+    CHECK(pinned() == 0);
+
+    lv_obj_delete(img);
+}
+
+static void test_reschedule(void)
+{
+    lv_obj_t *img = lv_image_create(NULL);
+    uint32_t decodes = host_jpeg_decode_count();
+
+    host_jpeg_hold(true);
+    lv_ameba_jpeg_image_set_src_async(img, &g_dsc[0]);
+    wait_decodes(decodes + 1);
+    lv_ameba_jpeg_image_set_src_async(img, &g_dsc[1]);
+    host_jpeg_hold(false);
+
+    CHECK(run_until_src(img, &g_dsc[1]));
+    run_until_idle();
+    CHECK(lv_image_get_src(img) == &g_dsc[1]);
+    CHECK(host_jpeg_decode_count() == decodes + 2);
+    CHECK(pinned() == 0);
+
+    lv_obj_delete(img);
+}
+
+static void test_file(void)
+{
+    char path[] = "/tmp/test_jpeg_async_XXXXXX";
+    int fd = mkstemp(path);
+    FILE *f = fd >= 0 ? fdopen(fd, "wb") : NULL;
+
+    CHECK(f != NULL);
+    if (!f) {
+        return;
+    }
+    fwrite(g_dsc[0].data, 1, g_dsc[0].data_size, f);
+    fclose(f);
+
+    lv_obj_t *img = lv_image_create(NULL);
+    char *src = strdup(path);
+    lv_ameba_jpeg_image_set_src_async(img, src);
+    // the job keeps its own copy of the path
+    src[1] = 'x';
+    free(src);
+
+    for (int i = 0; i < WAIT_TICKS && shows_placeholder(img); i++) {
+        host_timer_handler();
+        rtos_time_delay_ms(1);
+    }
+    CHECK(strcmp(lv_image_get_src(img), path) == 0);
+    run_until_idle();
+    CHECK(pinned() == 0);
+
+    lv_obj_delete(img);
+    remove(path);
+}
+
+static void test_deinit_outstanding(void)
+{
+    lv_obj_t *img[3];
+
+    for (int i = 0; i < 3; i++) {
+        img[i] = lv_image_create(NULL);
+        lv_ameba_jpeg_image_set_src_async(img[i], &g_dsc[i]);
+    }
+    jpeg_async_deinit();
+    CHECK(pinned() == 0);
+
+    // event callbacks are gone, deleting must not reach the stopped worker
+    for (int i = 0; i < 3; i++) {
+        lv_obj_delete(img[i]);
+    }
+    CHECK(host_timer_handler() == 0);
+}
+
+int main(void)
+{
+    static const uint32_t sizes[3][2] = { { 64, 48 }, { 33, 21 }, { 128, 96 } };
+
+    for (int i = 0; i < 3; i++) {
+        size_t size;
+        g_dsc[i].header.magic = LV_IMAGE_HEADER_MAGIC;
+        g_dsc[i].data = host_jpeg_encode(sizes[i][0], sizes[i][1], 80, false, &size);
+        g_dsc[i].data_size = size;
+    }
+
+    jpeg_cache_init(JPEG_CACHE_DEF_SIZE);
+    jpeg_async_init();
+    lv_ameba_jpeg_async_set_placeholder(g_placeholder);
+
+    test_apply_on_draw();
+    test_hidden_released();
+    test_cancel();
+    test_delete();
+    test_app_src_wins();
+    test_reschedule();
+    test_file();
+    test_deinit_outstanding();
+
+    jpeg_cache_deinit();
+    CHECK(host_draw_buf_live() == 0);
+    for (int i = 0; i < 3; i++) {
+        free((void *)g_dsc[i].data);
+    }
+
+    if (g_failed) {
+        printf("%d checks failed\n", g_failed);
+        return 1;
+    }
+    printf("jpeg_async: all passed\n");
+    return 0;
+}
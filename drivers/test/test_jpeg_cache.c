@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Decoded JPEG cache against a stub decoder: LRU order, byte budget, entries in use,
+ * drops with live references and the heap reserve */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "os_wrapper.h"
+#include "jpeg_cache.h"
+#include "host.h"
+
+#define UNIT        1000        // bytes of one stub decode
+#define BUDGET      (3 * UNIT)
+
+static int g_failed;
+static uint32_t g_decodes;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            g_failed++; \
+        } \
+    } while (0)
+
+static const uint8_t g_data[4][8];
+static const lv_image_dsc_t g_dsc[4] = {
+    { .header = { .magic = LV_IMAGE_HEADER_MAGIC }, .data_size = 8, .data = g_data[0] },
+    { .header = { .magic = LV_IMAGE_HEADER_MAGIC }, .data_size = 8, .data = g_data[1] },
+    { .header = { .magic = LV_IMAGE_HEADER_MAGIC }, .data_size = 8, .data = g_data[2] },
+    { .header = { .magic = LV_IMAGE_HEADER_MAGIC }, .data_size = 8, .data = g_data[3] },
+};
+
+/* What decoder_open_cb does: a hit or a fresh decode handed to the cache */
+static lv_draw_buf_t *open_src(const void *src, uint32_t size)
+{
+    lv_image_src_t src_type = lv_image_src_get_type(src);
+    lv_draw_buf_t *buf = jpeg_cache_acquire(src_type, src);
+
+    if (buf) {
+        return buf;
+    }
+
+    g_decodes++;
+    jpeg_cache_reclaim(size);
+    buf = lv_draw_buf_create(size / 2, 1, LV_COLOR_FORMAT_RGB565, 0);
+    jpeg_cache_insert(src_type, src, buf);
+    return buf;
+}
+
+static void show(const void *src)
+{
+    jpeg_cache_release(open_src(src, UNIT));
+}
+
+/* 1 if src is cached, without touching the LRU order or the counters much */
+static int cached(const void *src)
+{
+    lv_draw_buf_t *buf = jpeg_cache_acquire(lv_image_src_get_type(src), src);
+
+    if (!buf) {
+        return 0;
+    }
+    jpeg_cache_release(buf);
+    return 1;
+}
+
+static void cache_reset(uint32_t budget)
+{
+    jpeg_cache_deinit();
+    CHECK(host_draw_buf_live() == 0);
+    jpeg_cache_init(budget);
+    host_heap_set_total(64 * 1024 * 1024);
+    g_decodes = 0;
+}
+
+static void test_lru_order(void)
+{
+    lv_ameba_jpeg_cache_stats_t stats;
+
+    cache_reset(BUDGET);
+    show("A:/a.jpg");
+    show("A:/b.jpg");
+    show(&g_dsc[0]);
+    show("A:/a.jpg");          // a is the most recent now, b the least
+    show(&g_dsc[1]);
+
+    jpeg_cache_get_stats(&stats);
+    CHECK(g_decodes == 4);
+    CHECK(stats.entries == 3);
+    CHECK(stats.used_size == BUDGET);
+    CHECK(stats.evictions == 1);
+    CHECK(stats.hits == 1);
+    CHECK(stats.misses == 4);
+
+    CHECK(!cached("A:/b.jpg"));
+    CHECK(cached("A:/a.jpg"));
+    CHECK(cached(&g_dsc[0]));
+    CHECK(cached(&g_dsc[1]));
+    // same data pointer but another size is another image
+    lv_image_dsc_t other = g_dsc[0];
+    other.data_size = 4;
+    CHECK(!cached(&other));
+
+    // a smaller budget evicts from the LRU end
+    show("A:/a.jpg");
+    jpeg_cache_set_size(UNIT);
+    CHECK(cached("A:/a.jpg"));
+    CHECK(!cached(&g_dsc[0]));
+    CHECK(!cached(&g_dsc[1]));
+    CHECK(host_draw_buf_live() == 1);
+}
+
+static void test_too_large(void)
+{
+    cache_reset(BUDGET);
+
+    lv_draw_buf_t *buf = lv_draw_buf_create(BUDGET, 1, LV_COLOR_FORMAT_RGB565, 0);
+    CHECK(!jpeg_cache_insert(LV_IMAGE_SRC_FILE, "A:/big.jpg", buf));
+    // not tracked, the release frees it
+    jpeg_cache_release(buf);
+    CHECK(host_draw_buf_live() == 0);
+}
+
+static void test_in_use_not_evicted(void)
+{
+    lv_ameba_jpeg_cache_stats_t stats;
+
+    cache_reset(BUDGET);
+    lv_draw_buf_t *a = open_src("A:/a.jpg", UNIT);
+    show("A:/b.jpg");
+    show("A:/c.jpg");
+    show("A:/d.jpg");
+    show("A:/e.jpg");
+
+    // a is the least recent but drawn, everything else made room
+    CHECK(cached("A:/a.jpg"));
+    CHECK(!cached("A:/b.jpg"));
+    CHECK(!cached("A:/c.jpg"));
+    CHECK(cached("A:/d.jpg"));
+    CHECK(cached("A:/e.jpg"));
+
+    // over the budget with everything in use, trimmed once released
+    lv_draw_buf_t *d = open_src("A:/d.jpg", UNIT);
+    lv_draw_buf_t *e = open_src("A:/e.jpg", UNIT);
+    lv_draw_buf_t *f = open_src("A:/f.jpg", UNIT);
+    jpeg_cache_get_stats(&stats);
+    CHECK(stats.used_size == 4 * UNIT);
+
+    jpeg_cache_release(a);
+    jpeg_cache_get_stats(&stats);
+    CHECK(stats.used_size == BUDGET);
+    CHECK(!cached("A:/a.jpg"));
+
+    jpeg_cache_release(d);
+    jpeg_cache_release(e);
+    jpeg_cache_release(f);
+    CHECK(host_draw_buf_live() == 3);
+}
+
+static void test_drop_in_use(void)
+{
+    lv_ameba_jpeg_cache_stats_t stats;
+
+    cache_reset(BUDGET);
+    lv_draw_buf_t *a = open_src("A:/a.jpg", UNIT);
+    show("A:/b.jpg");
+
+    jpeg_cache_drop("A:/a.jpg");
+    jpeg_cache_drop("A:/b.jpg");
+    CHECK(host_draw_buf_live() == 1);
+
+    // the next open decodes again, with the new hint, while the old one is still drawn
+    lv_draw_buf_t *a2 = open_src("A:/a.jpg", UNIT);
+    CHECK(a2 != a);
+    CHECK(g_decodes == 3);
+    jpeg_cache_get_stats(&stats);
+    CHECK(stats.entries == 2);
+
+    jpeg_cache_release(a);
+    CHECK(host_draw_buf_live() == 1);
+    jpeg_cache_get_stats(&stats);
+    CHECK(stats.entries == 1);
+    CHECK(stats.used_size == UNIT);
+
+    // NULL drops all, in use or not
+    jpeg_cache_drop(NULL);
+    CHECK(!cached("A:/a.jpg"));
+    CHECK(host_draw_buf_live() == 1);
+    jpeg_cache_release(a2);
+    CHECK(host_draw_buf_live() == 0);
+}
+
+static void test_heap_reserve(void)
+{
+    lv_ameba_jpeg_cache_stats_t stats;
+
+    cache_reset(16 * UNIT);
+    for (int i = 0; i < 8; i++) {
+        char path[16];
+        snprintf(path, sizeof(path), "A:/%d.jpg", i);
+        show(path);
+    }
+
+    // heap left for 1 more decode above the reserve, the next needs 3
+    host_heap_set_total(JPEG_CACHE_HEAP_RESERVE + 9 * UNIT);
+    lv_draw_buf_t *buf = open_src("A:/big.jpg", 3 * UNIT);
+    CHECK(rtos_mem_get_free_heap_size() >= JPEG_CACHE_HEAP_RESERVE);
+    jpeg_cache_get_stats(&stats);
+    CHECK(stats.evictions == 2);
+    CHECK(!cached("A:/0.jpg"));
+    CHECK(!cached("A:/1.jpg"));
+    CHECK(cached("A:/2.jpg"));
+    jpeg_cache_release(buf);
+}
+
+int main(void)
+{
+    test_lru_order();
+    test_too_large();
+    test_in_use_not_evicted();
+    test_drop_in_use();
+    test_heap_reserve();
+    jpeg_cache_deinit();
+    CHECK(host_draw_buf_live() == 0);
+
+    if (g_failed) {
+        printf("%d checks failed\n", g_failed);
+        return 1;
+    }
+    printf("jpeg_cache: all passed\n");
+    return 0;
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* SOF scanner against the JPEG corpus in jpeg/ and hand made marker sequences */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "jpeg_header.h"
+
+static int g_failed;
+static const char *g_dir = "jpeg";
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            g_failed++; \
+        } \
+    } while (0)
+
+typedef struct {
+    const char *name;
+    uint16_t width;
+    uint16_t height;
+    uint8_t sampling;
+    bool progressive;
+} corpus_entry_t;
+
+static const corpus_entry_t g_corpus[] = {
+    {"gray_17x9.jpg", 17, 9, JPEG_SAMPLING_400, false},
+    {"420_64x48.jpg", 64, 48, JPEG_SAMPLING_420, false},
+    {"422_restart_50x30.jpg", 50, 30, JPEG_SAMPLING_422, false},
+    {"440_24x40.jpg", 24, 40, JPEG_SAMPLING_440, false},
+    {"411_64x16.jpg", 64, 16, JPEG_SAMPLING_411, false},
+    {"444_progressive_40x30.jpg", 40, 30, JPEG_SAMPLING_444, true},
+    {"420_exif_33x21.jpg", 33, 21, JPEG_SAMPLING_420, false},
+    {"420_progressive_exif_480x320.jpg", 480, 320, JPEG_SAMPLING_420, true},
+};
+
+typedef struct {
+    FILE *f;
+    uint32_t bytes;
+} file_stream_t;
+
+/* Like the lv_fs path of the decoder, counting what is actually read */
+static bool file_read(void *user_data, uint32_t offset, uint8_t *buf, uint32_t len)
+{
+    file_stream_t *stream = user_data;
+
+    stream->bytes += len;
+    return fseek(stream->f, offset, SEEK_SET) == 0 && fread(buf, 1, len, stream->f) == len;
+}
+
+static uint8_t *load(const char *name, uint32_t *size)
+{
+    char path[512];
+    FILE *f;
+    uint8_t *data = NULL;
+
+    snprintf(path, sizeof(path), "%s/%s", g_dir, name);
+    f = fopen(path, "rb");
+    if (!f) {
+        printf("can't open %s\n", path);
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    *size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    data = malloc(*size);
+    if (data && fread(data, 1, *size, f) != *size) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    return data;
+}
+
+static void test_corpus(void)
+{
+    for (size_t i = 0; i < sizeof(g_corpus) / sizeof(g_corpus[0]); i++) {
+        const corpus_entry_t *entry = &g_corpus[i];
+        jpeg_header_t header;
+        uint32_t size;
+        uint8_t *data = load(entry->name, &size);
+
+        CHECK(data != NULL);
+        if (!data) {
+            continue;
+        }
+
+        memset(&header, 0, sizeof(header));
+        CHECK(jpeg_header_parse_mem(data, size, &header) == 0);
+        CHECK(header.width == entry->width && header.height == entry->height);
+        CHECK(header.sampling == entry->sampling);
+        CHECK(header.progressive == entry->progressive);
+
+        // Every cut before the end of the SOF fails, every later one still parses
+        uint32_t need = 0;
+        while (need <= size && jpeg_header_parse_mem(data, need, &header) != 0) {
+            need++;
+        }
+        CHECK(need > 20 && need < size);
+        for (uint32_t len = need; len <= size; len += 97) {
+            CHECK(jpeg_header_parse_mem(data, len, &header) == 0);
+        }
+
+        // Only marker headers and the SOF are read, EXIF payloads are skipped
+        char path[512];
+        file_stream_t stream = {0};
+        snprintf(path, sizeof(path), "%s/%s", g_dir, entry->name);
+        stream.f = fopen(path, "rb");
+        CHECK(stream.f && jpeg_header_parse(file_read, &stream, &header) == 0);
+        CHECK(stream.bytes < 64);
+        if (stream.f) {
+            fclose(stream.f);
+        }
+
+        free(data);
+    }
+}
+
+/* SOI, then segments, then a SOF0 of 16x8 4:2:0 */
+#define SOF0_420    0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x08, 0x00, 0x10, 0x03, \
+                    0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01
+
+static int parse(const uint8_t *data, uint32_t size, jpeg_header_t *header)
+{
+    return jpeg_header_parse_mem(data, size, header);
+}
+
+static void test_markers(void)
+{
+    jpeg_header_t header;
+
+    // DRI, a stray RST, fill bytes and an APP1 holding EOI and SOF bytes
+    static const uint8_t ok[] = {
+        0xFF, 0xD8,
+        0xFF, 0xDD, 0x00, 0x04, 0x00, 0x01,
+        0xFF, 0xD3,
+        0xFF, 0xFF, 0xFF,
+        0xE1, 0x00, 0x0A, 'E', 'x', 'i', 'f', 0xFF, 0xD9, 0xFF, 0xC0,
+        SOF0_420,
+    };
+    CHECK(parse(ok, sizeof(ok), &header) == 0);
+    CHECK(header.width == 16 && header.height == 8 && header.sampling == JPEG_SAMPLING_420);
+
+    static const uint8_t not_jpeg[] = {0x89, 'P', 'N', 'G', SOF0_420};
+    CHECK(parse(not_jpeg, sizeof(not_jpeg), &header) != 0);
+
+    static const uint8_t sos_first[] = {0xFF, 0xD8, 0xFF, 0xDA, 0x00, 0x08, 1, 1, 0, 0, 63, 0, SOF0_420};
+    CHECK(parse(sos_first, sizeof(sos_first), &header) != 0);
+
+    static const uint8_t eoi_first[] = {0xFF, 0xD8, 0xFF, 0xD9, SOF0_420};
+    CHECK(parse(eoi_first, sizeof(eoi_first), &header) != 0);
+
+    static const uint8_t arithmetic[] = {0xFF, 0xD8, 0xFF, 0xC9, 0x00, 0x0B, 0x08, 0, 8, 0, 16, 1, 1, 0x11, 0};
+    CHECK(parse(arithmetic, sizeof(arithmetic), &header) != 0);
+
+    static const uint8_t lossless[] = {0xFF, 0xD8, 0xFF, 0xC3, 0x00, 0x0B, 0x08, 0, 8, 0, 16, 1, 1, 0x11, 0};
+    CHECK(parse(lossless, sizeof(lossless), &header) != 0);
+
+    static const uint8_t twelve_bit[] = {0xFF, 0xD8, 0xFF, 0xC1, 0x00, 0x0B, 0x0C, 0, 8, 0, 16, 1, 1, 0x11, 0};
+    CHECK(parse(twelve_bit, sizeof(twelve_bit), &header) != 0);
+
+    static const uint8_t gray[] = {0xFF, 0xD8, 0xFF, 0xC1, 0x00, 0x0B, 0x08, 0, 8, 0, 16, 1, 1, 0x11, 0};
+    CHECK(parse(gray, sizeof(gray), &header) == 0);
+    CHECK(header.sampling == JPEG_SAMPLING_400 && !header.progressive);
+
+    static const uint8_t zero_size[] = {0xFF, 0xD8, 0xFF, 0xC0, 0x00, 0x0B, 0x08, 0, 0, 0, 16, 1, 1, 0x11, 0};
+    CHECK(parse(zero_size, sizeof(zero_size), &header) != 0);
+
+    static const uint8_t cmyk[] = {0xFF, 0xD8, 0xFF, 0xC0, 0x00, 0x14, 0x08, 0, 8, 0, 16, 4,
+                                   1, 0x11, 0, 2, 0x11, 0, 3, 0x11, 0, 4, 0x11, 0};
+    CHECK(parse(cmyk, sizeof(cmyk), &header) != 0);
+
+    static const uint8_t short_segment[] = {0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x01, SOF0_420};
+    CHECK(parse(short_segment, sizeof(short_segment), &header) != 0);
+
+    // A segment length running past the end
+    static const uint8_t overrun[] = {0xFF, 0xD8, 0xFF, 0xE1, 0xFF, 0xF0, SOF0_420};
+    CHECK(parse(overrun, sizeof(overrun), &header) != 0);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1) {
+        g_dir = argv[1];
+    }
+
+    test_corpus();
+    test_markers();
+
+    if (g_failed) {
+        printf("%d checks failed\n", g_failed);
+        return 1;
+    }
+    printf("jpeg_header: all passed\n");
+    return 0;
+}
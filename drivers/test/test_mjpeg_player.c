@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* MJPEG player with its worker thread on a manual clock: frame splitting (EXIF thumbnails,
+ * restart markers, truncated frames, junk between frames), pacing, drop and late tick
+ * accounting, looping and file sources read in chunks */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "os_wrapper.h"
+#include "mjpeg_player.h"
+#include "host.h"
+
+#define PERIOD_MS       40      // 25 fps, the default
+#define WAIT_MS         2000
+
+static int g_failed;
+static uint32_t g_ready;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            g_failed++; \
+        } \
+    } while (0)
+
+typedef struct {
+    uint8_t *data;
+    size_t size;
+} stream_t;
+
+static void stream_add(stream_t *s, const uint8_t *data, size_t size)
+{
+    s->data = realloc(s->data, s->size + size);
+    memcpy(s->data + s->size, data, size);
+    s->size += size;
+}
+
+static void stream_add_frame(stream_t *s, uint32_t w, uint32_t h, bool restart)
+{
+    size_t size;
+    uint8_t *frame = host_jpeg_encode(w, h, 75, restart, &size);
+
+    stream_add(s, frame, size);
+    free(frame);
+}
+
+/* A frame with an APP1 EXIF segment after SOI, its thumbnail has SOI and EOI of its own */
+static void stream_add_exif_frame(stream_t *s, uint32_t w, uint32_t h)
+{
+    static const uint8_t app1[] = {
+        0xFF, 0xE1, 0x00, 0x14, 'E', 'x', 'i', 'f', 0x00, 0x00,
+        0xFF, 0xD8, 0xFF, 0xD9, 0xFF, 0xD9, 0x12, 0x34, 0xFF, 0xD9, 0x00, 0x00,
+    };
+    size_t size;
+    uint8_t *frame = host_jpeg_encode(w, h, 75, false, &size);
+
+    stream_add(s, frame, 2);
+    stream_add(s, app1, sizeof(app1));
+    stream_add(s, frame + 2, size - 2);
+    free(frame);
+}
+
+/* The headers and half of the scan of a frame, cut off by the next one */
+static void stream_add_truncated_frame(stream_t *s, uint32_t w, uint32_t h)
+{
+    size_t size;
+    uint8_t *frame = host_jpeg_encode(w, h, 75, false, &size);
+    size_t sos = 2;
+
+    while (sos + 1 < size && !(frame[sos] == 0xFF && frame[sos + 1] == 0xDA)) {
+        sos++;
+    }
+    stream_add(s, frame, sos + (size - sos) / 2);
+    free(frame);
+}
+
+static void ready_cb(lv_event_t *e)
+{
+    LV_UNUSED(e);
+    g_ready++;
+}
+
+static void wait_idle(void)
+{
+    for (int i = 0; i < WAIT_MS && !host_threads_idle(); i++) {
+        rtos_time_delay_ms(1);
+    }
+}
+
+/* Let ms pass on the clock, then run the player timer with the worker caught up */
+static void tick(uint32_t ms)
+{
+    host_time_advance_ms(ms);
+    host_timer_handler();
+    wait_idle();
+}
+
+static lv_ameba_mjpeg_player_t *player_new(void)
+{
+    lv_ameba_mjpeg_player_t *player = lv_ameba_mjpeg_player_create(NULL);
+
+    lv_obj_add_event_cb(lv_ameba_mjpeg_player_get_obj(player), ready_cb, LV_EVENT_READY, NULL);
+    g_ready = 0;
+    return player;
+}
+
+/* Play to the end, every tick ticks_ms apart. Returns the ticks until LV_EVENT_READY. */
+static uint32_t play_to_end(lv_ameba_mjpeg_player_t *player, uint32_t tick_ms, uint32_t max_ticks)
+{
+    uint32_t ticks = 0;
+
+    lv_ameba_mjpeg_player_play(player);
+    wait_idle();
+    while (!g_ready && ticks < max_ticks) {
+        tick(tick_ms);
+        ticks++;
+    }
+    return ticks;
+}
+
+static void test_split(void)
+{
+    stream_t s = {0};
+    static const uint8_t junk[] = { 0x00, 0xFF, 0x12, 0xFF, 0xFF, 0xD9, 0x55 };
+
+    stream_add(&s, junk, sizeof(junk));
+    stream_add_exif_frame(&s, 48, 32);
+    stream_add_frame(&s, 48, 32, true);
+    stream_add(&s, junk, sizeof(junk));
+    stream_add_truncated_frame(&s, 48, 32);
+    stream_add_frame(&s, 48, 32, false);
+    stream_add_truncated_frame(&s, 48, 32);
+
+    lv_ameba_mjpeg_player_t *player = player_new();
+    lv_ameba_mjpeg_player_stats_t stats;
+
+    CHECK(lv_ameba_mjpeg_player_set_src_data(player, s.data, s.size) == LV_RESULT_OK);
+    CHECK(play_to_end(player, PERIOD_MS, 20) == 4);
+    lv_ameba_mjpeg_player_get_stats(player, &stats);
+    CHECK(stats.frames_decoded == 3);
+    CHECK(stats.frames_shown == 3);
+    CHECK(stats.decode_errors == 0);
+    CHECK(stats.frames_dropped == 0);
+    CHECK(stats.late_ticks == 0);
+    CHECK(g_ready == 1);
+
+    lv_ameba_mjpeg_player_delete(player);
+    free(s.data);
+}
+
+/* A display keeping up shows every frame, one that runs every third period skips two */
+static void test_pacing(void)
+{
+    stream_t s = {0};
+    lv_ameba_mjpeg_player_stats_t stats;
+
+    for (int i = 0; i < 12; i++) {
+        stream_add_frame(&s, 32, 16, false);
+    }
+
+    lv_ameba_mjpeg_player_t *player = player_new();
+    lv_ameba_mjpeg_player_set_src_data(player, s.data, s.size);
+    CHECK(play_to_end(player, PERIOD_MS, 40) == 13);
+    lv_ameba_mjpeg_player_get_stats(player, &stats);
+    CHECK(stats.frames_shown == 12);
+    CHECK(stats.frames_dropped == 0);
+    CHECK(stats.late_ticks == 0);
+
+    // shows 0, 3, 6 and 9, the worker skips the others without decoding them
+    lv_ameba_mjpeg_player_set_src_data(player, s.data, s.size);
+    g_ready = 0;
+    uint32_t decodes = host_jpeg_decode_count();
+    CHECK(play_to_end(player, 3 * PERIOD_MS, 40) == 5);
+    lv_ameba_mjpeg_player_get_stats(player, &stats);
+    CHECK(stats.frames_shown == 4);
+    CHECK(stats.frames_dropped == 8);
+    CHECK(stats.frames_decoded == 4);
+    CHECK(host_jpeg_decode_count() == decodes + 4);
+    CHECK(stats.late_ticks == 0);
+
+    // 50 fps, at 25 fps ticks every other frame goes
+    lv_ameba_mjpeg_player_set_src_data(player, s.data, s.size);
+    lv_ameba_mjpeg_player_set_fps(player, 50);
+    g_ready = 0;
+    CHECK(play_to_end(player, 2 * 20, 40) == 7);
+    lv_ameba_mjpeg_player_get_stats(player, &stats);
+    CHECK(stats.frames_shown == 6);
+    CHECK(stats.frames_dropped == 6);
+
+    lv_ameba_mjpeg_player_delete(player);
+    free(s.data);
+}
+
+/* A decode that takes longer than a period shows up as late ticks, the frames the
+ * display passed meanwhile are dropped */
+static void test_late(void)
+{
+    stream_t s = {0};
+    lv_ameba_mjpeg_player_stats_t stats;
+
+    for (int i = 0; i < 6; i++) {
+        stream_add_frame(&s, 32, 16, false);
+    }
+
+    lv_ameba_mjpeg_player_t *player = player_new();
+    lv_ameba_mjpeg_player_set_src_data(player, s.data, s.size);
+    lv_ameba_mjpeg_player_play(player);
+    wait_idle();
+
+    // frame 0 shown, the worker is stuck in frame 1 for three periods
+    host_jpeg_hold(true);
+    for (int i = 0; i < 3; i++) {
+        host_time_advance_ms(PERIOD_MS);
+        host_timer_handler();
+    }
+    host_jpeg_hold(false);
+    wait_idle();
+    lv_ameba_mjpeg_player_get_stats(player, &stats);
+    CHECK(stats.frames_shown == 1);
+    CHECK(stats.late_ticks == 2);
+    CHECK(stats.frames_dropped == 0);
+
+    // frame 1 is shown at the time of 3, 2 and 3 go
+    tick(PERIOD_MS);
+    lv_ameba_mjpeg_player_get_stats(player, &stats);
+    CHECK(stats.frames_shown == 2);
+    CHECK(stats.frames_dropped == 2);
+    CHECK(stats.frames_decoded == 3);
+
+    lv_ameba_mjpeg_player_delete(player);
+    free(s.data);
+}
+
+static void test_loop(void)
+{
+    stream_t s = {0};
+    lv_ameba_mjpeg_player_stats_t stats;
+
+    for (int i = 0; i < 3; i++) {
+        stream_add_frame(&s, 32, 16, false);
+    }
+
+    lv_ameba_mjpeg_player_t *player = player_new();
+    lv_ameba_mjpeg_player_set_src_data(player, s.data, s.size);
+    lv_ameba_mjpeg_player_set_loop(player, true);
+    CHECK(play_to_end(player, PERIOD_MS, 10) == 10);
+    CHECK(g_ready == 0);
+    lv_ameba_mjpeg_player_get_stats(player, &stats);
+    CHECK(stats.frames_shown == 10);
+    CHECK(stats.frames_dropped == 0);
+
+    // stop rewinds, playing again starts over and ends after the third frame
+    lv_ameba_mjpeg_player_stop(player);
+    lv_ameba_mjpeg_player_set_loop(player, false);
+    CHECK(play_to_end(player, PERIOD_MS, 10) <= 4);
+    CHECK(g_ready == 1);
+
+    lv_ameba_mjpeg_player_delete(player);
+    free(s.data);
+}
+
+/* Frames larger than a read chunk, the frame buffer grows while splitting */
+static void test_file(void)
+{
+    stream_t s = {0};
+    char path[] = "/tmp/test_mjpeg_XXXXXX";
+    int fd = mkstemp(path);
+    FILE *f = fd >= 0 ? fdopen(fd, "wb") : NULL;
+    lv_ameba_mjpeg_player_stats_t stats;
+
+    CHECK(f != NULL);
+    if (!f) {
+        return;
+    }
+    stream_add_exif_frame(&s, 800, 600);
+    stream_add_frame(&s, 800, 600, true);
+    stream_add_truncated_frame(&s, 800, 600);
+    stream_add_frame(&s, 800, 600, false);
+    CHECK(s.size > 3 * 16 * 1024);
+    fwrite(s.data, 1, s.size, f);
+    fclose(f);
+
+    lv_ameba_mjpeg_player_t *player = player_new();
+    CHECK(lv_ameba_mjpeg_player_set_src_file(player, path) == LV_RESULT_OK);
+    CHECK(play_to_end(player, PERIOD_MS, 20) == 4);
+    lv_ameba_mjpeg_player_get_stats(player, &stats);
+    CHECK(stats.frames_shown == 3);
+    CHECK(stats.decode_errors == 0);
+
+    CHECK(lv_ameba_mjpeg_player_set_src_file(player, "/nonexistent/x.mjpeg") == LV_RESULT_INVALID);
+
+    lv_ameba_mjpeg_player_delete(player);
+    remove(path);
+    free(s.data);
+}
+
+int main(void)
+{
+    host_time_manual(true);
+
+    test_split();
+    test_pacing();
+    test_late();
+    test_loop();
+    test_file();
+    CHECK(host_draw_buf_live() == 0);
+
+    if (g_failed) {
+        printf("%d checks failed\n", g_failed);
+        return 1;
+    }
+    printf("mjpeg_player: all passed\n");
+    return 0;
+}
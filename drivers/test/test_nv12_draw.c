@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* NV12 draw helpers: row conversion against a float BT.601 reference for every output
+ * format and start column, and the source rectangle of transformed draws against a
+ * brute force forward mapping */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nv12_draw.h"
+
+#define IMG_W       37          // odd, rows end in half a chroma pair
+#define IMG_H       23
+
+static int g_failed;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            g_failed++; \
+        } \
+    } while (0)
+
+static uint8_t g_y[IMG_H][IMG_W + 1];
+static uint8_t g_uv[(IMG_H + 1) / 2][IMG_W + 1];
+
+static uint8_t ref_clamp(float v)
+{
+    v = roundf(v);
+    return v < 0 ? 0 : (v > 255 ? 255 : (uint8_t)v);
+}
+
+static void ref_pixel(uint32_t x, uint32_t y, uint8_t rgb[3])
+{
+    float luma = g_y[y][x];
+    float cb = g_uv[y / 2][x & ~1U] - 128.0f;
+    float cr = g_uv[y / 2][(x & ~1U) + 1] - 128.0f;
+
+    rgb[0] = ref_clamp(luma + 1.402f * cr);
+    rgb[1] = ref_clamp(luma - 0.344136f * cb - 0.714136f * cr);
+    rgb[2] = ref_clamp(luma + 1.772f * cb);
+}
+
+static int diff(int a, int b)
+{
+    return a > b ? a - b : b - a;
+}
+
+/* Every row, start columns 0..3 and widths up to the row end, all three formats */
+static void test_convert(void)
+{
+    uint8_t out[IMG_W * 4];
+    int worst = 0;
+
+    for (uint32_t y = 0; y < IMG_H; y++) {
+        for (uint32_t x0 = 0; x0 < 4; x0++) {
+            uint32_t w = IMG_W - x0;
+
+            for (int f = NV12_OUT_RGB565; f <= NV12_OUT_XRGB8888; f++) {
+                memset(out, 0xA5, sizeof(out));
+                nv12_to_rgb_line(&g_y[y][x0], g_uv[y / 2], x0, w, out, f);
+
+                for (uint32_t i = 0; i < w; i++) {
+                    uint8_t rgb[3];
+                    ref_pixel(x0 + i, y, rgb);
+
+                    if (f == NV12_OUT_RGB565) {
+                        uint16_t px = ((uint16_t *)out)[i];
+                        int d = diff(px >> 11, rgb[0] >> 3);
+                        d = d > diff((px >> 5) & 0x3F, rgb[1] >> 2) ? d : diff((px >> 5) & 0x3F, rgb[1] >> 2);
+                        d = d > diff(px & 0x1F, rgb[2] >> 3) ? d : diff(px & 0x1F, rgb[2] >> 3);
+                        CHECK(d <= 1);
+                        continue;
+                    }
+
+                    uint32_t px_size = f == NV12_OUT_RGB888 ? 3 : 4;
+                    const uint8_t *p = out + i * px_size;
+                    for (int c = 0; c < 3; c++) {
+                        int d = diff(p[2 - c], rgb[c]);
+                        worst = d > worst ? d : worst;
+                        CHECK(d <= 1);
+                    }
+                    if (f == NV12_OUT_XRGB8888) {
+                        CHECK(p[3] == 0xFF);
+                    }
+                }
+
+                // nothing written past the row
+                uint32_t px_size = f == NV12_OUT_RGB565 ? 2 : (f == NV12_OUT_RGB888 ? 3 : 4);
+                if (w * px_size < sizeof(out)) {
+                    CHECK(out[w * px_size] == 0xA5);
+                }
+            }
+        }
+    }
+    printf("convert: max error %d\n", worst);
+}
+
+/* Pixel (x, y) of the image drawn transformed, as lv_point_transform() maps it */
+static void forward(float x, float y, int32_t pivot_x, int32_t pivot_y, int32_t rotation, int32_t scale_x,
+                    int32_t scale_y, float *out_x, float *out_y)
+{
+    float rad = rotation * 3.14159265f / 1800.0f;
+    float dx = (x - pivot_x) * scale_x / 256.0f;
+    float dy = (y - pivot_y) * scale_y / 256.0f;
+
+    *out_x = cosf(rad) * dx - sinf(rad) * dy + pivot_x;
+    *out_y = sinf(rad) * dx + cosf(rad) * dy + pivot_y;
+}
+
+static bool in_rect(const nv12_rect_t *r, float x, float y)
+{
+    return x >= r->x1 && x < r->x2 + 1 && y >= r->y1 && y < r->y2 + 1;
+}
+
+/* Every source pixel that lands in clip lies in the returned rectangle */
+static void check_transform(uint32_t w, uint32_t h, const nv12_rect_t *clip, int32_t pivot_x, int32_t pivot_y,
+                            int32_t rotation, int32_t scale_x, int32_t scale_y)
+{
+    nv12_rect_t src;
+    bool visible = nv12_source_rect(w, h, clip, pivot_x, pivot_y, rotation, scale_x, scale_y, &src);
+    uint32_t hits = 0;
+
+    for (uint32_t y = 0; y < h; y++) {
+        for (uint32_t x = 0; x < w; x++) {
+            float cx, cy;
+            forward(x + 0.5f, y + 0.5f, pivot_x, pivot_y, rotation, scale_x, scale_y, &cx, &cy);
+            if (!in_rect(clip, cx, cy)) {
+                continue;
+            }
+            hits++;
+            CHECK(visible && (int32_t)x >= src.x1 && (int32_t)x <= src.x2 && (int32_t)y >= src.y1 &&
+                  (int32_t)y <= src.y2);
+        }
+    }
+    if (visible) {
+        CHECK(src.x1 >= 0 && src.y1 >= 0 && src.x2 < (int32_t)w && src.y2 < (int32_t)h);
+        CHECK(src.x1 <= src.x2 && src.y1 <= src.y2);
+    } else {
+        CHECK(hits == 0);
+    }
+}
+
+static void test_source_rect(void)
+{
+    nv12_rect_t src;
+
+    // untransformed: the clip area itself, cut to the image
+    nv12_rect_t clip = { 10, 5, 49, 14 };
+    CHECK(nv12_source_rect(100, 80, &clip, 50, 40, 0, 256, 256, &src));
+    CHECK(src.x1 == 10 && src.y1 == 5 && src.x2 == 49 && src.y2 == 14);
+
+    clip = (nv12_rect_t) { -20, -8, 30, 200 };
+    CHECK(nv12_source_rect(100, 80, &clip, 50, 40, 0, 256, 256, &src));
+    CHECK(src.x1 == 0 && src.y1 == 0 && src.x2 == 30 && src.y2 == 79);
+
+    clip = (nv12_rect_t) { 120, 0, 140, 10 };
+    CHECK(!nv12_source_rect(100, 80, &clip, 50, 40, 0, 256, 256, &src));
+
+    // a band of a 2x zoom around the center needs about half of it, plus the margin
+    clip = (nv12_rect_t) { 0, 0, 99, 9 };
+    CHECK(nv12_source_rect(100, 80, &clip, 50, 40, 0, 512, 512, &src));
+    CHECK(src.x1 <= 25 && src.x2 >= 74 && src.x2 - src.x1 <= 54);
+    CHECK(src.y1 <= 20 && src.y2 >= 24 && src.y2 - src.y1 <= 9);
+
+    // a band at the top of a 2x zoom rotated by 90 degrees is a column on the left
+    CHECK(nv12_source_rect(100, 80, &clip, 50, 40, 900, 512, 512, &src));
+    CHECK(src.x2 - src.x1 <= 9 && src.y2 - src.y1 <= 54);
+
+    // random transforms and clip areas
+    srand(1);
+    for (int i = 0; i < 2000; i++) {
+        uint32_t w = 8 + rand() % 120;
+        uint32_t h = 8 + rand() % 120;
+        int32_t x1 = rand() % 300 - 100;
+        int32_t y1 = rand() % 300 - 100;
+        clip = (nv12_rect_t) { x1, y1, x1 + rand() % 80, y1 + rand() % 80 };
+        int32_t rotation = (i % 4 == 0) ? 0 : rand() % 3600;
+        int32_t scale_x = (i % 8 == 0) ? 256 : 64 + rand() % 768;
+        int32_t scale_y = (i % 3 == 0) ? scale_x : 64 + rand() % 768;
+
+        check_transform(w, h, &clip, rand() % w, rand() % h, rotation, scale_x, scale_y);
+    }
+}
+
+int main(void)
+{
+    srand(7);
+    for (uint32_t y = 0; y < IMG_H; y++) {
+        for (uint32_t x = 0; x <= IMG_W; x++) {
+            g_y[y][x] = rand();
+            g_uv[y / 2][x] = rand();
+        }
+    }
+    // saturated corners of the YCbCr cube
+    g_y[0][0] = 255;
+    g_uv[0][0] = 255;
+    g_uv[0][1] = 255;
+    g_y[1][2] = 0;
+    g_uv[0][2] = 0;
+    g_uv[0][3] = 0;
+
+    test_convert();
+    test_source_rect();
+
+    if (g_failed) {
+        printf("%d checks failed\n", g_failed);
+        return 1;
+    }
+    printf("nv12_draw: all passed\n");
+    return 0;
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Runs command tables and window updates against a bus that records its transactions */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "panel_cmd.h"
+
+#define LOG_SIZE    2048
+
+static char g_log[LOG_SIZE];
+static int g_log_len;
+static int g_failed;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            g_failed++; \
+        } \
+    } while (0)
+
+/* One line per transaction: "cmd:len:payload" or "delay:ms" */
+static void record_write(void *ctx, uint8_t cmd, const uint8_t *data, uint32_t len)
+{
+    (void)ctx;
+    g_log_len += snprintf(g_log + g_log_len, LOG_SIZE - g_log_len, "%02X:%u:", cmd, (unsigned)len);
+    for (uint32_t i = 0; i < len; i++) {
+        g_log_len += snprintf(g_log + g_log_len, LOG_SIZE - g_log_len, "%02X", data[i]);
+    }
+    g_log_len += snprintf(g_log + g_log_len, LOG_SIZE - g_log_len, "\n");
+}
+
+static void record_delay(uint32_t ms)
+{
+    g_log_len += snprintf(g_log + g_log_len, LOG_SIZE - g_log_len, "delay:%u\n", (unsigned)ms);
+}
+
+static const panel_bus_t g_bus = {
+    .ctx = NULL,
+    .write = record_write,
+    .delay_ms = record_delay,
+};
+
+static void log_reset(void)
+{
+    g_log[0] = '\0';
+    g_log_len = 0;
+}
+
+static void test_exec(void)
+{
+    static const panel_cmd_t table[] = {
+        {0x01, 0, 150, {0}},
+        {0x3A, 1, 0, {0x55}},
+        {0xE0, 4, 0, {0xD0, 0x04, 0x0D, 0x11}},
+        {0x11, 0, 120, {0}},
+        {0x29, 0, 0, {0}},
+    };
+
+    log_reset();
+    panel_cmd_exec(&g_bus, table, PANEL_CMD_COUNT(table));
+    CHECK(strcmp(g_log,
+                 "01:0:\n"
+                 "delay:150\n"
+                 "3A:1:55\n"
+                 "E0:4:D0040D11\n"
+                 "11:0:\n"
+                 "delay:120\n"
+                 "29:0:\n") == 0);
+}
+
+static void test_exec_clamps_len(void)
+{
+    static const panel_cmd_t table[] = {
+        {0xB0, PANEL_CMD_MAX_DATA + 4, 0, {0x01}},
+    };
+    char expect[64];
+
+    log_reset();
+    panel_cmd_exec(&g_bus, table, PANEL_CMD_COUNT(table));
+    snprintf(expect, sizeof(expect), "B0:%d:01", PANEL_CMD_MAX_DATA);
+    CHECK(strncmp(g_log, expect, strlen(expect)) == 0);
+}
+
+static void test_window(void)
+{
+    panel_cmd_window_t win;
+
+    panel_cmd_window_reset(&win);
+
+    log_reset();
+    panel_cmd_set_window(&g_bus, &win, 0, 0, 239, 39);
+    CHECK(strcmp(g_log, "2A:4:000000EF\n2B:4:00000027\n") == 0);
+
+    // next band of the same frame only moves the rows
+    log_reset();
+    panel_cmd_set_window(&g_bus, &win, 0, 40, 239, 79);
+    CHECK(strcmp(g_log, "2B:4:0028004F\n") == 0);
+
+    log_reset();
+    panel_cmd_set_window(&g_bus, &win, 0, 40, 239, 79);
+    CHECK(g_log_len == 0);
+
+    log_reset();
+    panel_cmd_set_window(&g_bus, &win, 16, 40, 300, 79);
+    CHECK(strcmp(g_log, "2A:4:0010012C\n") == 0);
+
+    // after a reset everything is sent again
+    panel_cmd_window_reset(&win);
+    log_reset();
+    panel_cmd_set_window(&g_bus, &win, 16, 40, 300, 79);
+    CHECK(strcmp(g_log, "2A:4:0010012C\n2B:4:0028004F\n") == 0);
+}
+
+int main(void)
+{
+    test_exec();
+    test_exec_clamps_len();
+    test_window();
+
+    if (g_failed) {
+        printf("%d checks failed\n", g_failed);
+        return 1;
+    }
+    printf("panel_cmd: all passed\n");
+    return 0;
+}
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Flush engine on the null panel with frame memory: partial updates, and scroll offload
+ * checked pixel by pixel on what the panel shows through its hardware scroll, with the
+ * traffic of the scroll steps against redrawing the scroll area */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "panel_display.h"
+#include "host.h"
+
+#define WIDTH       240
+#define HEIGHT      320
+#define LIST_Y1     40
+#define LIST_Y2     279
+#define LIST_H      (LIST_Y2 - LIST_Y1 + 1)
+#define ROW_BYTES   (WIDTH * 2)
+
+static int g_failed;
+static lv_display_t *g_disp;
+static lv_obj_t *g_list;        // what the render callback draws, not deleted yet
+static int32_t g_scroll_y;
+static uint16_t g_version;      // changes all list content
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            g_failed++; \
+        } \
+    } while (0)
+
+/* Screen pixel LVGL would render: list content rows by the scroll position, fixed rows
+ * around it */
+static uint16_t expected_px(int32_t x, int32_t y)
+{
+    if (g_list && y >= LIST_Y1 && y <= LIST_Y2) {
+        int32_t row = y - LIST_Y1 + g_scroll_y;
+        return (uint16_t)((row * 251 + x + g_version * 17) & 0x7FFF);
+    }
+    return (uint16_t)(0x8000 | (y << 4) | (x & 0xF));
+}
+
+static void render(const lv_area_t *area, uint8_t *px_map, void *user_data)
+{
+    uint16_t *px = (uint16_t *)px_map;
+
+    (void)user_data;
+    for (int32_t y = area->y1; y <= area->y2; y++) {
+        for (int32_t x = area->x1; x <= area->x2; x++) {
+            *px++ = expected_px(x, y);
+        }
+    }
+}
+
+static void check_rows(int y1, int y2, int line)
+{
+    int bad_rows = 0;
+    int first_bad = -1;
+
+    for (int y = y1; y <= y2; y++) {
+        const uint16_t *row = (const uint16_t *)null_panel_get_row(y);
+        for (int x = 0; x < WIDTH; x++) {
+            if (row[x] != expected_px(x, y)) {
+                if (first_bad < 0) {
+                    first_bad = y;
+                }
+                bad_rows++;
+                break;
+            }
+        }
+    }
+    if (bad_rows) {
+        printf("line %d: %d rows wrong on screen, first %d\n", line, bad_rows, first_bad);
+        g_failed++;
+    }
+}
+
+static void check_screen(int line)
+{
+    check_rows(0, HEIGHT - 1, line);
+}
+
+static uint64_t panel_bytes(void)
+{
+    null_panel_stats_t stats;
+
+    null_panel_get_stats(&stats);
+    return stats.bytes;
+}
+
+/* Scroll the list to y and refresh, returns the bytes the refresh sent */
+static uint64_t scroll_to(int32_t y)
+{
+    uint64_t start = panel_bytes();
+
+    g_scroll_y = y;
+    host_obj_scroll_to_y(g_list, y);
+    host_display_refresh(g_disp);
+    return panel_bytes() - start;
+}
+
+static void test_partial(void)
+{
+    null_panel_stats_t stats;
+    panel_caps_t caps;
+
+    panel_display_get_caps(&caps);
+    CHECK(caps.width == WIDTH && caps.height == HEIGHT);
+
+    // Whole screen in bands of the partial buffer
+    lv_obj_invalidate(lv_display_get_screen_active(g_disp));
+    CHECK(host_display_refresh(g_disp) == HEIGHT / 32);
+    check_screen(__LINE__);
+    null_panel_get_stats(&stats);
+    CHECK(stats.area_flushes == HEIGHT / 32);
+    CHECK(stats.bytes == (uint64_t)WIDTH * HEIGHT * 2);
+
+    // Widened to the 8 px grid, close areas merge into one
+    lv_area_t a = {13, 50, 20, 52};
+    lv_area_t b = {17, 53, 22, 54};
+    uint64_t start = panel_bytes();
+    lv_inv_area(g_disp, &a);
+    lv_inv_area(g_disp, &b);
+    CHECK(host_display_refresh(g_disp) == 1);
+    CHECK(panel_bytes() - start == 16 * 8 * 2);
+    check_screen(__LINE__);
+}
+
+static void test_scroll(void)
+{
+    static const int32_t steps[] = {13, 63, 56, 59, 304, 44, 45, 0, 240, 481};
+    null_panel_stats_t stats;
+    panel_display_stats_t display_stats;
+    lv_obj_t *narrow = lv_obj_create(lv_display_get_screen_active(g_disp));
+    uint64_t step_bytes = 0;
+
+    host_obj_set_coords(narrow, 10, LIST_Y1, WIDTH - 1, LIST_Y2);
+    CHECK(panel_display_set_scroll_offload(narrow) == LV_RESULT_INVALID);
+    lv_obj_delete(narrow);
+    host_display_refresh(g_disp);
+
+    g_list = lv_obj_create(lv_display_get_screen_active(g_disp));
+    host_obj_set_coords(g_list, 0, LIST_Y1, WIDTH - 1, LIST_Y2);
+    CHECK(panel_display_set_scroll_offload(g_list) == LV_RESULT_OK);
+    lv_obj_invalidate(g_list);
+    host_display_refresh(g_disp);
+    check_screen(__LINE__);
+
+    for (size_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+        int32_t dy = LV_ABS(steps[i] - g_scroll_y);
+        uint64_t sent = scroll_to(steps[i]);
+        step_bytes += sent;
+
+        check_screen(__LINE__);
+        // The exposed rows, widened to the 8 line grid at both ends
+        CHECK(sent <= (uint64_t)LV_MIN(dy + 14, LIST_H) * ROW_BYTES);
+        CHECK(sent >= (uint64_t)LV_MIN(dy, LIST_H) * ROW_BYTES);
+    }
+
+    // Two steps before one refresh
+    uint64_t start = panel_bytes();
+    g_scroll_y += 4;
+    host_obj_scroll_to_y(g_list, g_scroll_y);
+    g_scroll_y += 10;
+    host_obj_scroll_to_y(g_list, g_scroll_y);
+    host_display_refresh(g_disp);
+    step_bytes += panel_bytes() - start;
+    CHECK(panel_bytes() - start <= (14 + 14) * ROW_BYTES);
+    check_screen(__LINE__);
+
+    // Content changes sent as they are, through the offset: a few rows, the whole list
+    // across the wrap in frame memory and the screen across the fixed rows
+    g_version++;
+    lv_area_t rows = {0, 140, WIDTH - 1, 150};
+    lv_inv_area(g_disp, &rows);
+    host_display_refresh(g_disp);
+    check_rows(136, 151, __LINE__);
+    lv_obj_invalidate(g_list);
+    host_display_refresh(g_disp);
+    check_screen(__LINE__);
+    g_version++;
+    lv_obj_invalidate(lv_display_get_screen_active(g_disp));
+    host_display_refresh(g_disp);
+    check_screen(__LINE__);
+
+    panel_display_get_stats(&display_stats);
+    CHECK(display_stats.scroll_frames == sizeof(steps) / sizeof(steps[0]) + 1);
+    CHECK(display_stats.scroll_bytes == step_bytes);
+    CHECK(display_stats.scroll_full_bytes == (uint64_t)display_stats.scroll_frames * LIST_H * ROW_BYTES);
+    printf("scroll offload: %lu steps, %llu of %llu bytes (%llu%%)\n",
+           (unsigned long)display_stats.scroll_frames, (unsigned long long)display_stats.scroll_bytes,
+           (unsigned long long)display_stats.scroll_full_bytes,
+           (unsigned long long)(display_stats.scroll_bytes * 100 / display_stats.scroll_full_bytes));
+
+    // Off again, the scroll area goes back to unshifted frame memory
+    CHECK(panel_display_set_scroll_offload(NULL) == LV_RESULT_OK);
+    host_display_refresh(g_disp);
+    check_screen(__LINE__);
+    scroll_to(75);
+    check_screen(__LINE__);
+    null_panel_get_stats(&stats);
+    uint32_t scroll_starts = stats.scroll_starts;
+    panel_display_get_stats(&display_stats);
+    CHECK(display_stats.scroll_frames == sizeof(steps) / sizeof(steps[0]) + 1);
+
+    // Deleting the object ends the offload too
+    CHECK(panel_display_set_scroll_offload(g_list) == LV_RESULT_OK);
+    scroll_to(90);
+    check_screen(__LINE__);
+    lv_obj_t *list = g_list;
+    g_list = NULL;
+    lv_obj_delete(list);
+    host_display_refresh(g_disp);
+    check_screen(__LINE__);
+    null_panel_get_stats(&stats);
+    CHECK(stats.scroll_starts == scroll_starts + 3);
+}
+
+int main(void)
+{
+    static uint8_t gram[WIDTH * HEIGHT * 2];
+
+    null_panel_set_size(WIDTH, HEIGHT);
+    null_panel_set_frame_memory(gram);
+    g_disp = panel_display_create(&null_panel_ops, 2);
+    CHECK(g_disp != NULL);
+    if (!g_disp) {
+        return 1;
+    }
+    host_display_set_render_cb(g_disp, render, NULL);
+
+    test_partial();
+    test_scroll();
+
+    if (g_failed) {
+        printf("%d checks failed\n", g_failed);
+        return 1;
+    }
+    printf("panel_display: all passed\n");
+    return 0;
+}
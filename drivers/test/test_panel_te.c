@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* TE sync on a manual clock: period estimate through missed pulses, a short first period
+ * and a slower panel, and the racing decision from the estimated scan line, also with
+ * the panel hardware scroll moving lines on screen */
+
+#include <stdio.h>
+
+#include "panel_te.h"
+#include "host.h"
+
+#define TE_PIN      0x21
+#define HEIGHT      320
+#define PERIOD_MS   17
+
+static int g_failed;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            g_failed++; \
+        } \
+    } while (0)
+
+static uint32_t period_us(void)
+{
+    panel_te_info_t info;
+
+    panel_te_get_info(&info);
+    return info.period_us;
+}
+
+/* count TE pulses, period_ms apart */
+static void pulses(int count, uint32_t period_ms)
+{
+    for (int i = 0; i < count; i++) {
+        host_time_advance_ms(period_ms);
+        CHECK(host_gpio_irq_fire(TE_PIN));
+    }
+}
+
+static void test_period(void)
+{
+    CHECK(panel_te_init(TE_PIN, HEIGHT) == 0);
+    CHECK(host_gpio_irq_fire(TE_PIN));
+    CHECK(period_us() == 0);
+    pulses(10, PERIOD_MS);
+    CHECK(period_us() == PERIOD_MS * 1000);
+
+    // A missed pulse is left out, a few of them too
+    pulses(1, 2 * PERIOD_MS);
+    pulses(1, PERIOD_MS);
+    pulses(3, 2 * PERIOD_MS);
+    CHECK(period_us() == PERIOD_MS * 1000);
+    pulses(4, PERIOD_MS);
+    CHECK(period_us() == PERIOD_MS * 1000);
+    panel_te_deinit();
+
+    // Started from a glitch, the real period takes over after a few pulses
+    CHECK(panel_te_init(TE_PIN, HEIGHT) == 0);
+    pulses(1, PERIOD_MS);
+    pulses(1, 2);
+    CHECK(period_us() == 2000);
+    pulses(8, PERIOD_MS);
+    CHECK(period_us() == PERIOD_MS * 1000);
+
+    // Panel at a lower frame rate
+    pulses(8, 30);
+    CHECK(period_us() == 30000);
+    pulses(8, PERIOD_MS);
+    CHECK(period_us() < 30000);
+    panel_te_deinit();
+    CHECK(!host_gpio_irq_fire(TE_PIN));
+}
+
+static void test_race(void)
+{
+    panel_te_info_t info;
+    uint32_t rows_bytes = 240 * 20 * 2;
+
+    CHECK(panel_te_init(TE_PIN, HEIGHT) == 0);
+    pulses(10, PERIOD_MS);
+
+    // Nothing known about the bus yet: waits, no TE comes on the host and it times out
+    panel_te_sync(0, 19, rows_bytes);
+    host_time_advance_ms(1);
+    panel_te_transfer_done();
+    panel_te_get_info(&info);
+    CHECK(info.waits == 1 && info.missed == 1 && info.raced == 0);
+    CHECK(info.bytes_per_ms == rows_bytes);
+
+    // 1 ms after TE the scan is near line 18: rows further down are written before it
+    // gets there, the rows it is on have to wait
+    pulses(1, PERIOD_MS);
+    host_time_advance_ms(1);
+    panel_te_sync(200, 219, rows_bytes);
+    panel_te_transfer_done();
+    panel_te_get_info(&info);
+    CHECK(info.raced == 1 && info.waits == 1);
+    panel_te_sync(10, 29, rows_bytes);
+    panel_te_get_info(&info);
+    CHECK(info.raced == 1 && info.waits == 2);
+
+    // 10 ms after TE the scan passed the top rows, they are done before it comes back
+    pulses(1, PERIOD_MS);
+    host_time_advance_ms(10);
+    panel_te_sync(0, 19, rows_bytes);
+    panel_te_get_info(&info);
+    CHECK(info.raced == 2 && info.waits == 2);
+    panel_te_deinit();
+}
+
+/* Scroll area on lines 40..279 showing line 140 first: line L of it is on screen row
+ * 40 + (L - 140) mod 240 */
+static void test_scroll(void)
+{
+    panel_te_info_t info;
+    uint32_t rows_bytes = 240 * 20 * 2;
+
+    panel_te_set_scroll_area(40, 240);
+    panel_te_set_scroll_start(140);
+    CHECK(panel_te_init(TE_PIN, HEIGHT) == 0);
+    pulses(10, PERIOD_MS);
+    panel_te_sync(0, 19, rows_bytes);
+    host_time_advance_ms(1);
+    panel_te_transfer_done();
+
+    // 10 ms after TE the scan is near row 188. Lines 40..59 are on rows 180..199 and
+    // have to wait, lines 140..159 are on rows 40..59 behind the scan.
+    pulses(1, PERIOD_MS);
+    host_time_advance_ms(10);
+    panel_te_get_info(&info);
+    uint32_t raced = info.raced;
+    uint32_t waits = info.waits;
+    panel_te_sync(40, 59, rows_bytes);
+    panel_te_get_info(&info);
+    CHECK(info.raced == raced && info.waits == waits + 1);
+
+    pulses(1, PERIOD_MS);
+    host_time_advance_ms(10);
+    panel_te_sync(140, 159, rows_bytes);
+    panel_te_get_info(&info);
+    CHECK(info.raced == raced + 1 && info.waits == waits + 1);
+
+    // Lines around the first one shown are split on screen, they wait. Fixed rows are
+    // where they are.
+    pulses(1, PERIOD_MS);
+    host_time_advance_ms(10);
+    panel_te_sync(130, 149, rows_bytes);
+    panel_te_get_info(&info);
+    CHECK(info.raced == raced + 1 && info.waits == waits + 2);
+    pulses(1, PERIOD_MS);
+    host_time_advance_ms(10);
+    panel_te_sync(0, 19, rows_bytes);
+    panel_te_get_info(&info);
+    CHECK(info.raced == raced + 2 && info.waits == waits + 2);
+
+    // Back to the normal display
+    panel_te_set_scroll_area(0, HEIGHT);
+    panel_te_set_scroll_start(0);
+    pulses(1, PERIOD_MS);
+    host_time_advance_ms(10);
+    panel_te_sync(40, 59, rows_bytes);
+    panel_te_get_info(&info);
+    CHECK(info.raced == raced + 3 && info.waits == waits + 2);
+    panel_te_deinit();
+}
+
+int main(void)
+{
+    host_time_manual(true);
+
+    test_period();
+    test_race();
+    test_scroll();
+
+    if (g_failed) {
+        printf("%d checks failed\n", g_failed);
+        return 1;
+    }
+    printf("panel_te: all passed\n");
+    return 0;
+}
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Replays recorded touch traces through the ring and the gesture engine */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "touch_ring.h"
+#include "touch_gesture.h"
+
+#define LOG_SIZE    1024
+
+static char g_log[LOG_SIZE];
+static int g_log_len;
+static int g_failed;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            g_failed++; \
+        } \
+    } while (0)
+
+/* One frame per line: "time_ms count id x y ..." */
+static int trace_parse(const char **trace, touch_frame_t *frame)
+{
+    const char *p = *trace;
+    char *end;
+
+    while (*p == '\n' || *p == ' ') {
+        p++;
+    }
+    if (!*p) {
+        return 0;
+    }
+
+    memset(frame, 0, sizeof(*frame));
+    frame->time_ms = strtoul(p, &end, 10);
+    frame->count = (uint8_t)strtoul(end, &end, 10);
+    for (int i = 0; i < frame->count && i < TOUCH_MAX_POINTS; i++) {
+        frame->points[i].id = (uint8_t)strtoul(end, &end, 10);
+        frame->points[i].x = (uint16_t)strtoul(end, &end, 10);
+        frame->points[i].y = (uint16_t)strtoul(end, &end, 10);
+    }
+    *trace = end;
+    return 1;
+}
+
+/* One line per gesture event */
+static void record_gesture(const touch_gesture_t *g)
+{
+    char *p = g_log + g_log_len;
+    int n = LOG_SIZE - g_log_len;
+
+    switch (g->type) {
+    case TOUCH_GESTURE_PINCH:
+        g_log_len += snprintf(p, n, "pinch %u\n", (unsigned)g->scale_x1000);
+        break;
+    case TOUCH_GESTURE_SCROLL:
+        g_log_len += snprintf(p, n, "scroll %d %d\n", g->dx, g->dy);
+        break;
+    case TOUCH_GESTURE_END:
+        g_log_len += snprintf(p, n, "end %u\n", (unsigned)g->fingers);
+        break;
+    case TOUCH_GESTURE_SWIPE:
+        g_log_len += snprintf(p, n, "swipe %d %d\n", (int)g->vx, (int)g->vy);
+        break;
+    default:
+        break;
+    }
+}
+
+/* Pushes the whole trace first when burst is set, like a consumer that fell behind.
+ * Returns the fingers the engine believes are down at the end. */
+static int replay(const char *trace, int burst)
+{
+    touch_ring_t ring;
+    touch_gesture_state_t state;
+    touch_frame_t frame;
+    touch_gesture_t gesture;
+
+    touch_ring_init(&ring);
+    touch_gesture_reset(&state);
+    g_log[0] = '\0';
+    g_log_len = 0;
+
+    while (trace_parse(&trace, &frame)) {
+        touch_ring_push(&ring, &frame);
+        if (burst) {
+            continue;
+        }
+        while (touch_ring_pop(&ring, &frame)) {
+            if (touch_gesture_process(&state, &frame, &gesture)) {
+                record_gesture(&gesture);
+            }
+        }
+    }
+    while (touch_ring_pop(&ring, &frame)) {
+        if (touch_gesture_process(&state, &frame, &gesture)) {
+            record_gesture(&gesture);
+        }
+    }
+    return state.fingers;
+}
+
+static void test_pinch(void)
+{
+    replay("0 2 0 100 200 1 200 200\n"
+           "10 2 0 95 200 1 205 200\n"
+           "20 2 0 80 200 1 220 200\n"
+           "30 2 0 50 200 1 250 200\n"
+           "40 1 0 50 200\n"
+           "50 0\n", 0);
+    CHECK(strcmp(g_log,
+                 "pinch 1400\n"
+                 "pinch 2000\n"
+                 "end 1\n") == 0);
+}
+
+static void test_two_finger_scroll(void)
+{
+    replay("0 2 3 100 100 4 160 100\n"
+           "10 2 3 100 104 4 160 104\n"
+           "20 2 3 100 112 4 160 112\n"
+           "30 2 3 100 130 4 160 130\n"
+           "40 2 3 100 130 4 160 130\n"
+           "50 0\n", 0);
+    CHECK(strcmp(g_log,
+                 "scroll 0 12\n"
+                 "scroll 0 18\n"
+                 "end 0\n") == 0);
+}
+
+static void test_swipe(void)
+{
+    replay("0 1 0 200 100\n"
+           "10 1 0 180 100\n"
+           "20 1 0 150 100\n"
+           "30 1 0 110 100\n"
+           "40 1 0 60 100\n"
+           "45 0\n", 0);
+    CHECK(strcmp(g_log, "swipe -3500 0\n") == 0);
+}
+
+static void test_no_swipe_after_rest(void)
+{
+    replay("0 1 0 200 100\n"
+           "10 1 0 150 100\n"
+           "20 1 0 100 100\n"
+           "300 0\n", 0);
+    CHECK(g_log_len == 0);
+}
+
+static void test_no_swipe_after_multi(void)
+{
+    replay("0 1 0 200 100\n"
+           "10 2 0 190 100 1 240 100\n"
+           "20 1 0 150 100\n"
+           "30 1 0 100 100\n"
+           "35 0\n", 0);
+    CHECK(g_log_len == 0);
+}
+
+/* Twice the ring of moves then a release, nothing popped until the end */
+static void test_release_kept_when_full(void)
+{
+    char trace[TOUCH_RING_SIZE * 2 * 24 + 32];
+    int len = 0;
+    touch_ring_t ring;
+    touch_frame_t frame;
+    uint32_t popped = 0;
+    uint32_t last_time = 0;
+    const char *p = trace;
+
+    for (int i = 0; i < TOUCH_RING_SIZE * 2; i++) {
+        len += snprintf(trace + len, sizeof(trace) - len, "%d 1 0 %d 100\n", i * 10, 300 - i * 8);
+    }
+    snprintf(trace + len, sizeof(trace) - len, "%d 0\n", TOUCH_RING_SIZE * 20);
+
+    touch_ring_init(&ring);
+    while (trace_parse(&p, &frame)) {
+        touch_ring_push(&ring, &frame);
+    }
+    CHECK(ring.dropped == TOUCH_RING_SIZE + 1);
+    CHECK(touch_ring_count(&ring) == TOUCH_RING_SIZE + 1);
+
+    while (touch_ring_pop(&ring, &frame)) {
+        popped++;
+        last_time = frame.time_ms;
+    }
+    CHECK(popped == TOUCH_RING_SIZE + 1);
+    CHECK(frame.count == 0);
+    CHECK(last_time == TOUCH_RING_SIZE * 20);
+
+    // the engine still sees the finger go up
+    CHECK(replay(trace, 1) == 0);
+}
+
+/* A new touch pushed while the release is pending must not overtake it */
+static void test_release_not_overtaken(void)
+{
+    touch_ring_t ring;
+    touch_frame_t frame = {0};
+    touch_frame_t out;
+
+    touch_ring_init(&ring);
+    frame.count = 1;
+    for (int i = 0; i < TOUCH_RING_SIZE; i++) {
+        frame.time_ms = i;
+        touch_ring_push(&ring, &frame);
+    }
+    frame.count = 0;
+    frame.time_ms = 100;
+    CHECK(touch_ring_push(&ring, &frame) == -1);
+
+    // room for one frame only, the new press has to wait behind the release
+    CHECK(touch_ring_pop(&ring, &out) == 1);
+    frame.count = 1;
+    frame.time_ms = 110;
+    CHECK(touch_ring_push(&ring, &frame) == -1);
+
+    CHECK(touch_ring_pop(&ring, &out) == 1);
+    frame.time_ms = 120;
+    CHECK(touch_ring_push(&ring, &frame) == 0);
+
+    for (int i = 2; i < TOUCH_RING_SIZE; i++) {
+        CHECK(touch_ring_pop(&ring, &out) == 1);
+        CHECK(out.count == 1 && out.time_ms == (uint32_t)i);
+    }
+    CHECK(touch_ring_pop(&ring, &out) == 1);
+    CHECK(out.count == 0 && out.time_ms == 100);
+    CHECK(touch_ring_pop(&ring, &out) == 1);
+    CHECK(out.count == 1 && out.time_ms == 120);
+    CHECK(touch_ring_pop(&ring, &out) == 0);
+}
+
+int main(void)
+{
+    test_pinch();
+    test_two_finger_scroll();
+    test_swipe();
+    test_no_swipe_after_rest();
+    test_no_swipe_after_multi();
+    test_release_kept_when_full();
+    test_release_not_overtaken();
+
+    if (g_failed) {
+        printf("%d checks failed\n", g_failed);
+        return 1;
+    }
+    printf("touch: all passed\n");
+    return 0;
+}
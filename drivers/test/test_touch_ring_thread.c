@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* A producer thread standing in for the touch interrupt pushes frames while the main
+ * thread drains the ring the way touch_read does, once per poll */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "touch_ring.h"
+
+#define FRAMES      200000
+
+static touch_ring_t g_ring;
+static volatile int g_done;
+static int g_failed;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            g_failed++; \
+        } \
+    } while (0)
+
+/* Frame seq carries its number in the time and in every point, so a torn copy shows */
+static void frame_make(touch_frame_t *frame, uint32_t seq)
+{
+    memset(frame, 0, sizeof(*frame));
+    frame->time_ms = seq;
+    frame->count = 1 + seq % TOUCH_MAX_POINTS;
+    for (int i = 0; i < frame->count; i++) {
+        frame->points[i].id = (uint8_t)i;
+        frame->points[i].x = (uint16_t)(seq + i);
+        frame->points[i].y = (uint16_t)~(seq + i);
+    }
+}
+
+static int frame_intact(const touch_frame_t *frame)
+{
+    uint32_t seq = frame->time_ms;
+
+    if (frame->count != 1 + seq % TOUCH_MAX_POINTS) {
+        return 0;
+    }
+    for (int i = 0; i < frame->count; i++) {
+        if (frame->points[i].id != i || frame->points[i].x != (uint16_t)(seq + i) ||
+            frame->points[i].y != (uint16_t)~(seq + i)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void *producer(void *arg)
+{
+    touch_frame_t frame;
+
+    (void)arg;
+    for (uint32_t seq = 1; seq <= FRAMES; seq++) {
+        frame_make(&frame, seq);
+        touch_ring_push(&g_ring, &frame);
+        if (seq % 64 == 0) {
+            sched_yield();
+        }
+    }
+
+    // all fingers up, has to arrive however full the ring is
+    memset(&frame, 0, sizeof(frame));
+    frame.time_ms = FRAMES + 1;
+    touch_ring_push(&g_ring, &frame);
+
+    __atomic_store_n(&g_done, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+int main(void)
+{
+    pthread_t thread;
+    touch_frame_t frame;
+    uint32_t last = 0;
+    uint32_t popped = 0;
+    uint32_t bad = 0;
+    uint32_t polls = 0;
+    int released = 0;
+
+    touch_ring_init(&g_ring);
+    if (pthread_create(&thread, NULL, producer, NULL)) {
+        printf("pthread_create failed\n");
+        return 1;
+    }
+
+    for (;;) {
+        int done = __atomic_load_n(&g_done, __ATOMIC_ACQUIRE);
+
+        while (touch_ring_pop(&g_ring, &frame)) {
+            if (frame.count == 0) {
+                CHECK(!released);
+                CHECK(frame.time_ms == FRAMES + 1);
+                released = 1;
+                continue;
+            }
+            CHECK(!released);
+            if (frame.time_ms <= last || !frame_intact(&frame)) {
+                bad++;
+            }
+            last = frame.time_ms;
+            popped++;
+        }
+        if (done && !touch_ring_count(&g_ring)) {
+            break;
+        }
+        if (++polls % 4 == 0) {
+            sched_yield();
+        }
+    }
+    pthread_join(thread, NULL);
+
+    CHECK(bad == 0);
+    CHECK(released);
+    CHECK(popped + g_ring.dropped == FRAMES);
+    printf("touch_ring_thread: %u frames popped, %u dropped\n", (unsigned)popped, (unsigned)g_ring.dropped);
+
+    if (g_failed) {
+        printf("%d checks failed\n", g_failed);
+        return 1;
+    }
+    printf("touch_ring_thread: all passed\n");
+    return 0;
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "touch_gesture.h"
+
+static uint32_t isqrt(uint32_t v)
+{
+    uint32_t r = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (v >= r + bit) {
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return r;
+}
+
+static void gesture_fill(const touch_gesture_state_t *state, uint8_t type, touch_gesture_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    out->type = type;
+    out->fingers = state->fingers;
+    out->x = state->last_x;
+    out->y = state->last_y;
+}
+
+static int gesture_pair(touch_gesture_state_t *state, const touch_frame_t *frame, touch_gesture_t *out)
+{
+    const touch_point_t *a = NULL;
+    const touch_point_t *b = NULL;
+    int ret = 0;
+
+    if (state->paired) {
+        a = touch_frame_find(frame, state->ids[0]);
+        b = touch_frame_find(frame, state->ids[1]);
+    }
+
+    if (!a || !b) {
+        // one of the followed fingers lifted, go on with the first two down
+        if (state->mode) {
+            gesture_fill(state, TOUCH_GESTURE_END, out);
+            ret = 1;
+        }
+        a = &frame->points[0];
+        b = &frame->points[1];
+        state->paired = 0;
+    }
+
+    int dx = (int)b->x - a->x;
+    int dy = (int)b->y - a->y;
+    uint32_t dist = isqrt((uint32_t)(dx * dx + dy * dy));
+    int16_t cx = (a->x + b->x) / 2;
+    int16_t cy = (a->y + b->y) / 2;
+
+    if (!state->paired) {
+        state->paired = 1;
+        state->mode = TOUCH_GESTURE_NONE;
+        state->ids[0] = a->id;
+        state->ids[1] = b->id;
+        state->start_dist = dist ? dist : 1;
+        state->start_x = state->last_x = cx;
+        state->start_y = state->last_y = cy;
+        return ret;
+    }
+
+    if (state->mode == TOUCH_GESTURE_NONE) {
+        if (abs((int)dist - (int)state->start_dist) > TOUCH_PINCH_SLOP) {
+            state->mode = TOUCH_GESTURE_PINCH;
+        } else if (abs(cx - state->start_x) + abs(cy - state->start_y) > TOUCH_SCROLL_SLOP) {
+            state->mode = TOUCH_GESTURE_SCROLL;
+        } else {
+            return 0;
+        }
+    }
+
+    int16_t last_x = state->last_x;
+    int16_t last_y = state->last_y;
+    state->last_x = cx;
+    state->last_y = cy;
+
+    if (state->mode == TOUCH_GESTURE_PINCH) {
+        gesture_fill(state, TOUCH_GESTURE_PINCH, out);
+        out->scale_x1000 = dist * 1000 / state->start_dist;
+        return 1;
+    }
+
+    if (cx == last_x && cy == last_y) {
+        return 0;
+    }
+    gesture_fill(state, TOUCH_GESTURE_SCROLL, out);
+    out->dx = cx - last_x;
+    out->dy = cy - last_y;
+    return 1;
+}
+
+static void gesture_sample(touch_gesture_state_t *state, const touch_frame_t *frame)
+{
+    touch_gesture_sample_t *s = &state->hist[state->hist_next];
+
+    s->time_ms = frame->time_ms;
+    s->x = frame->points[0].x;
+    s->y = frame->points[0].y;
+    state->hist_next = (state->hist_next + 1) % TOUCH_GESTURE_HISTORY;
+    if (state->hist_count < TOUCH_GESTURE_HISTORY) {
+        state->hist_count++;
+    }
+}
+
+/* Velocity over the samples of the last TOUCH_SWIPE_WINDOW_MS, none if the finger
+ * rested before the release */
+static int gesture_swipe(touch_gesture_state_t *state, uint32_t release_ms, touch_gesture_t *out)
+{
+    if (!state->hist_count) {
+        return 0;
+    }
+
+    int newest = (state->hist_next + TOUCH_GESTURE_HISTORY - 1) % TOUCH_GESTURE_HISTORY;
+    const touch_gesture_sample_t *last = &state->hist[newest];
+    const touch_gesture_sample_t *first = last;
+
+    if (release_ms - last->time_ms > TOUCH_SWIPE_WINDOW_MS) {
+        return 0;
+    }
+
+    for (int i = 1; i < state->hist_count; i++) {
+        const touch_gesture_sample_t *s = &state->hist[(newest + TOUCH_GESTURE_HISTORY - i) % TOUCH_GESTURE_HISTORY];
+        if (last->time_ms - s->time_ms > TOUCH_SWIPE_WINDOW_MS) {
+            break;
+        }
+        first = s;
+    }
+
+    uint32_t dt = last->time_ms - first->time_ms;
+    int dx = last->x - first->x;
+    int dy = last->y - first->y;
+    if (!dt || abs(dx) + abs(dy) < TOUCH_SWIPE_MIN_DIST) {
+        return 0;
+    }
+
+    int32_t vx = dx * 1000 / (int32_t)dt;
+    int32_t vy = dy * 1000 / (int32_t)dt;
+    if (abs(vx) < TOUCH_SWIPE_MIN_SPEED && abs(vy) < TOUCH_SWIPE_MIN_SPEED) {
+        return 0;
+    }
+
+    gesture_fill(state, TOUCH_GESTURE_SWIPE, out);
+    out->fingers = 1;
+    out->x = last->x;
+    out->y = last->y;
+    out->vx = vx;
+    out->vy = vy;
+    return 1;
+}
+
+void touch_gesture_reset(touch_gesture_state_t *state)
+{
+    memset(state, 0, sizeof(*state));
+}
+
+int touch_gesture_process(touch_gesture_state_t *state, const touch_frame_t *frame, touch_gesture_t *out)
+{
+    uint8_t prev = state->fingers;
+    int ret = 0;
+
+    if (frame->count >= 2) {
+        state->multi = 1;
+        state->fingers = frame->count;
+        return gesture_pair(state, frame, out);
+    }
+
+    if (state->paired) {
+        if (state->mode) {
+            gesture_fill(state, TOUCH_GESTURE_END, out);
+            out->fingers = frame->count;
+            ret = 1;
+        }
+        state->paired = 0;
+        state->mode = TOUCH_GESTURE_NONE;
+    }
+    state->fingers = frame->count;
+
+    if (frame->count == 1) {
+        if (prev == 0) {
+            state->hist_count = 0;
+            state->hist_next = 0;
+        }
+        if (!state->multi) {
+            gesture_sample(state, frame);
+        }
+        return ret;
+    }
+
+    // all fingers up
+    if (prev == 1 && !state->multi && !ret) {
+        ret = gesture_swipe(state, frame->time_ms, out);
+    }
+    state->multi = 0;
+    state->hist_count = 0;
+    return ret;
+}
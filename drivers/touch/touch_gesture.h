@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _TOUCH_GESTURE_H
+#define _TOUCH_GESTURE_H
+
+#include <stdint.h>
+
+#include "touch_ring.h"
+
+/*
+ * Multi-finger gestures from touch frames: two finger pinch and scroll, and the release
+ * velocity of one finger swipes. Feed every frame in order, SDK free like touch_ring.
+ */
+
+#define TOUCH_PINCH_SLOP		16		/* px of finger distance change before a pinch */
+#define TOUCH_SCROLL_SLOP		10		/* px of centroid move before a two finger scroll */
+#define TOUCH_SWIPE_WINDOW_MS	100		/* samples before release the velocity uses */
+#define TOUCH_SWIPE_MIN_DIST	30		/* px */
+#define TOUCH_SWIPE_MIN_SPEED	300		/* px/s */
+#define TOUCH_GESTURE_HISTORY	8
+
+typedef enum {
+	TOUCH_GESTURE_NONE = 0,
+	TOUCH_GESTURE_PINCH,		/* two fingers, distance changed */
+	TOUCH_GESTURE_SCROLL,		/* two fingers moving together */
+	TOUCH_GESTURE_END,			/* the pinch or scroll is over */
+	TOUCH_GESTURE_SWIPE,		/* one finger released while moving */
+} touch_gesture_type_t;
+
+typedef struct {
+	uint8_t type;
+	uint8_t fingers;
+	int16_t x;				/* centroid, release point for a swipe */
+	int16_t y;
+	uint32_t scale_x1000;	/* PINCH: finger distance against the start, 1000 unchanged */
+	int16_t dx;				/* SCROLL: centroid move since the last event */
+	int16_t dy;
+	int32_t vx;				/* SWIPE: px/s */
+	int32_t vy;
+} touch_gesture_t;
+
+typedef struct {
+	uint32_t time_ms;
+	int16_t x;
+	int16_t y;
+} touch_gesture_sample_t;
+
+typedef struct {
+	uint8_t fingers;		/* down in the last frame */
+	uint8_t multi;			/* a second finger came down during this touch */
+	uint8_t paired;
+	uint8_t mode;			/* PINCH or SCROLL once decided */
+	uint8_t ids[2];			/* the two fingers followed */
+	uint32_t start_dist;
+	int16_t start_x;
+	int16_t start_y;
+	int16_t last_x;
+	int16_t last_y;
+	uint8_t hist_count;
+	uint8_t hist_next;
+	touch_gesture_sample_t hist[TOUCH_GESTURE_HISTORY];
+} touch_gesture_state_t;
+
+void touch_gesture_reset(touch_gesture_state_t *state);
+/* 1 if frame completed a gesture event in out, 0 otherwise */
+int touch_gesture_process(touch_gesture_state_t *state, const touch_frame_t *frame, touch_gesture_t *out);
+
+#endif
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "touch_ring.h"
+
+/* head and tail only grow, the index is taken modulo the size. Each side publishes its
+ * index with release after touching the frame and reads the other one with acquire. */
+#define TOUCH_RING_MASK     (TOUCH_RING_SIZE - 1)
+
+void touch_ring_init(touch_ring_t *ring)
+{
+    memset(ring, 0, sizeof(*ring));
+}
+
+static uint32_t touch_ring_space(const touch_ring_t *ring)
+{
+    return TOUCH_RING_SIZE - (ring->head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE));
+}
+
+static void touch_ring_put(touch_ring_t *ring, const touch_frame_t *frame)
+{
+    uint32_t head = ring->head;
+
+    ring->frames[head & TOUCH_RING_MASK] = *frame;
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+int touch_ring_push(touch_ring_t *ring, const touch_frame_t *frame)
+{
+    // A pending release goes in first, nothing may overtake it
+    if (__atomic_exchange_n(&ring->release_pending, 0, __ATOMIC_ACQ_REL)) {
+        if (touch_ring_space(ring) < 2) {
+            __atomic_store_n(&ring->release_pending, 1, __ATOMIC_RELEASE);
+            if (frame->count == 0) {
+                ring->release_ms = frame->time_ms;
+            }
+            ring->dropped++;
+            return -1;
+        }
+
+        touch_frame_t release = {0};
+        release.time_ms = ring->release_ms;
+        touch_ring_put(ring, &release);
+    }
+
+    if (!touch_ring_space(ring)) {
+        if (frame->count == 0) {
+            ring->release_ms = frame->time_ms;
+            __atomic_store_n(&ring->release_pending, 1, __ATOMIC_RELEASE);
+        }
+        ring->dropped++;
+        return -1;
+    }
+
+    touch_ring_put(ring, frame);
+    return 0;
+}
+
+int touch_ring_pop(touch_ring_t *ring, touch_frame_t *frame)
+{
+    uint32_t tail = ring->tail;
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+    if (head == tail) {
+        // Everything queued before the release is out, unless the producer took it back
+        if (__atomic_exchange_n(&ring->release_pending, 0, __ATOMIC_ACQ_REL)) {
+            memset(frame, 0, sizeof(*frame));
+            frame->time_ms = ring->release_ms;
+            return 1;
+        }
+        return 0;
+    }
+
+    *frame = ring->frames[tail & TOUCH_RING_MASK];
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+uint32_t touch_ring_count(const touch_ring_t *ring)
+{
+    return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) +
+           __atomic_load_n(&ring->release_pending, __ATOMIC_ACQUIRE);
+}
+
+const touch_point_t *touch_frame_find(const touch_frame_t *frame, uint8_t id)
+{
+    for (int i = 0; i < frame->count; i++) {
+        if (frame->points[i].id == id) {
+            return &frame->points[i];
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2025 Realtek Semiconductor Corp.
+ * All rights reserved.
+ *
+ * Licensed under the Realtek License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License from Realtek
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _TOUCH_RING_H
+#define _TOUCH_RING_H
+
+#include <stdint.h>
+
+/*
+ * Touch frames shared by the touch controller drivers. A frame holds every finger that
+ * is down at one report, with the controller track ID so fingers can be followed across
+ * frames; a frame with count 0 means all fingers are up.
+ * The ring is single producer (driver task or interrupt) single consumer (UI task) and
+ * lock free, SDK free like panel.h so it runs on a host. A full ring drops new frames
+ * but never a release: it is kept aside and delivered once the queued frames are out.
+ */
+
+#define TOUCH_MAX_POINTS	5
+#define TOUCH_RING_SIZE		16		/* frames, power of 2 */
+
+typedef struct {
+	uint8_t id;				/* track ID from the controller */
+	uint16_t x;				/* panel coordinates */
+	uint16_t y;
+} touch_point_t;
+
+typedef struct {
+	uint32_t time_ms;
+	uint8_t count;			/* fingers down */
+	touch_point_t points[TOUCH_MAX_POINTS];
+} touch_frame_t;
+
+typedef struct {
+	touch_frame_t frames[TOUCH_RING_SIZE];
+	uint32_t head;			/* written by the producer only */
+	uint32_t tail;			/* written by the consumer only */
+	uint32_t dropped;		/* frames lost to a full ring, producer side */
+	uint32_t release_pending;	/* a release didn't fit, claimed by whichever side swaps it */
+	uint32_t release_ms;
+} touch_ring_t;
+
+void touch_ring_init(touch_ring_t *ring);
+/* Producer side, 0 on success or -1 if the ring is full and the frame was dropped
+ * (a release is kept pending instead) */
+int touch_ring_push(touch_ring_t *ring, const touch_frame_t *frame);
+/* Consumer side, 1 if a frame was taken, 0 if the ring is empty */
+int touch_ring_pop(touch_ring_t *ring, touch_frame_t *frame);
+/* Frames the consumer can pop, a pending release included */
+uint32_t touch_ring_count(const touch_ring_t *ring);
+
+/* Point of frame with track ID id, NULL if that finger is not down */
+const touch_point_t *touch_frame_find(const touch_frame_t *frame, uint8_t id);
+
+#endif